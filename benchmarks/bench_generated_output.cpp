@@ -0,0 +1,154 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+// Бенчмарк времени выполнения сгенерированных программ в разных профилях вывода.
+// Собирает граф «обработки лога» (цикл с печатью строк), генерирует код в профилях
+// Default и Throughput, компилирует его системным компилятором и замеряет время запуска.
+// Запуск: cmake -DMULTICODE_BUILD_BENCHMARKS=ON ... && ./multicode_bench_generated_output [N]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "visprog/core/Graph.hpp"
+#include "visprog/core/NodeFactory.hpp"
+#include "visprog/generators/CppCodeGenerator.hpp"
+
+using namespace visprog::core;
+using namespace visprog::generators;
+
+namespace {
+
+#ifdef _WIN32
+constexpr std::string_view kNullDevice = "NUL";
+constexpr std::string_view kExecutableSuffix = ".exe";
+#else
+constexpr std::string_view kNullDevice = "/dev/null";
+constexpr std::string_view kExecutableSuffix = "";
+#endif
+
+constexpr int kRuns = 5;
+
+auto find_port_id(const Node& node, std::string_view port_name) -> PortId {
+    for (const auto& port : node.get_ports()) {
+        if (port.get_name() == port_name) {
+            return port.get_id();
+        }
+    }
+    return PortId{0};
+}
+
+auto connect(Graph& graph,
+             NodeId from,
+             std::string_view from_port,
+             NodeId to,
+             std::string_view to_port) -> bool {
+    const auto from_id = find_port_id(*graph.get_node(from), from_port);
+    const auto to_id = find_port_id(*graph.get_node(to), to_port);
+    return graph.connect(from, from_id, to, to_id).has_value();
+}
+
+auto build_log_graph(std::int64_t line_count) -> std::optional<Graph> {
+    Graph graph("LogProcessing");
+
+    const auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto first_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    const auto last_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    const auto loop_id = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+    const auto line_id = graph.add_node(NodeFactory::create(NodeTypes::StringLiteral));
+    const auto print_line_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto print_index_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto end_id = graph.add_node(NodeFactory::create(NodeTypes::End));
+
+    graph.get_node_mut(first_id)->set_property("value", std::int64_t{0});
+    graph.get_node_mut(last_id)->set_property("value", line_count);
+    graph.get_node_mut(line_id)->set_property("value",
+                                              std::string("[INFO] request handled in 12 ms"));
+
+    const bool connected = connect(graph, start_id, "exec-out", loop_id, "exec-in") &&
+                           connect(graph, loop_id, "loop-body", print_line_id, "exec-in") &&
+                           connect(graph, print_line_id, "exec-out", print_index_id, "exec-in") &&
+                           connect(graph, loop_id, "completed", end_id, "exec-in") &&
+                           connect(graph, first_id, "result", loop_id, "first") &&
+                           connect(graph, last_id, "result", loop_id, "last") &&
+                           connect(graph, line_id, "result", print_line_id, "string") &&
+                           connect(graph, loop_id, "index", print_index_id, "string");
+    if (!connected) {
+        return std::nullopt;
+    }
+    return graph;
+}
+
+auto compile(const std::filesystem::path& source, const std::filesystem::path& binary) -> bool {
+    const auto command = std::string(MULTICODE_BENCH_CXX_COMPILER) + " -std=c++20 -O2 \"" +
+                         source.string() + "\" -o \"" + binary.string() + "\"";
+    return std::system(command.c_str()) == 0;
+}
+
+auto run_median_ms(const std::filesystem::path& binary) -> double {
+    const auto command = "\"" + binary.string() + "\" > " + std::string(kNullDevice);
+    std::vector<double> samples;
+    samples.reserve(kRuns);
+    for (int run = 0; run < kRuns; ++run) {
+        const auto begin = std::chrono::steady_clock::now();
+        if (std::system(command.c_str()) != 0) {
+            return -1.0;
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+        samples.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+    }
+    std::ranges::sort(samples);
+    return samples[samples.size() / 2];
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::int64_t line_count = argc > 1 ? std::atoll(argv[1]) : 2'000'000;
+
+    auto graph = build_log_graph(line_count);
+    if (!graph) {
+        std::cerr << "Failed to build benchmark graph\n";
+        return 1;
+    }
+
+    const auto work_dir = std::filesystem::temp_directory_path() / "multicode_bench_output";
+    std::filesystem::create_directories(work_dir);
+
+    struct Variant {
+        std::string_view name;
+        OutputProfile profile;
+    };
+    const Variant variants[] = {{"default", OutputProfile::Default},
+                                {"throughput", OutputProfile::Throughput}};
+
+    std::cout << "lines: " << line_count << ", runs: " << kRuns << "\n";
+    for (const auto& variant : variants) {
+        CppCodeGenerator generator(CppGeneratorOptions{.output_profile = variant.profile});
+        auto code = generator.generate(*graph);
+        if (!code) {
+            std::cerr << variant.name << ": generation failed: " << code.error().message << "\n";
+            return 1;
+        }
+
+        const auto source = work_dir / (std::string(variant.name) + ".cpp");
+        const auto binary =
+            work_dir / (std::string(variant.name) + std::string(kExecutableSuffix));
+        std::ofstream(source) << code.value();
+
+        if (!compile(source, binary)) {
+            std::cerr << variant.name << ": compilation failed\n";
+            return 1;
+        }
+
+        const auto median_ms = run_median_ms(binary);
+        std::cout << variant.name << ": median " << median_ms << " ms\n";
+    }
+    return 0;
+}
@@ -0,0 +1,185 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+// Бенчмарк времени компиляции многофайлового вывода.
+// Генерирует синтетический корпус графов и компилирует его дважды: автономные единицы трансляции
+// (каждая со своими include) и проект с общей прелюдией, собранной как precompiled header.
+// Запуск: cmake -DMULTICODE_BUILD_BENCHMARKS=ON ... && ./multicode_bench_prelude_compile [N]
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "visprog/core/Graph.hpp"
+#include "visprog/core/NodeFactory.hpp"
+#include "visprog/generators/CppCodeGenerator.hpp"
+
+using namespace visprog::core;
+using namespace visprog::generators;
+
+namespace {
+
+auto find_port_id(const Node& node, std::string_view port_name) -> PortId {
+    for (const auto& port : node.get_ports()) {
+        if (port.get_name() == port_name) {
+            return port.get_id();
+        }
+    }
+    return PortId{0};
+}
+
+auto connect(Graph& graph,
+             NodeId from,
+             std::string_view from_port,
+             NodeId to,
+             std::string_view to_port) -> bool {
+    const auto from_id = find_port_id(*graph.get_node(from), from_port);
+    const auto to_id = find_port_id(*graph.get_node(to), to_port);
+    return graph.connect(from, from_id, to, to_id).has_value();
+}
+
+// Граф корпуса: печать строки, цикл с печатью индекса и сумма массива.
+auto build_corpus_graph(int index) -> std::optional<Graph> {
+    Graph graph("Corpus_" + std::to_string(index));
+
+    const auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto title_id = graph.add_node(NodeFactory::create(NodeTypes::StringLiteral));
+    const auto print_title_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto first_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    const auto last_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    const auto loop_id = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+    const auto print_index_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto values_id = graph.add_node(NodeFactory::create(NodeTypes::IntArrayLiteral));
+    const auto sum_id = graph.add_node(NodeFactory::create(NodeTypes::ArrayReduceSum));
+    const auto print_sum_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    graph.get_node_mut(title_id)->set_property("value", "graph " + std::to_string(index));
+    graph.get_node_mut(first_id)->set_property("value", std::int64_t{0});
+    graph.get_node_mut(last_id)->set_property("value", std::int64_t{index + 1});
+    graph.get_node_mut(values_id)->set_property("values", std::string("1, 2, 3, 4"));
+
+    const bool connected = connect(graph, start_id, "exec-out", print_title_id, "exec-in") &&
+                           connect(graph, print_title_id, "exec-out", loop_id, "exec-in") &&
+                           connect(graph, loop_id, "loop-body", print_index_id, "exec-in") &&
+                           connect(graph, loop_id, "completed", print_sum_id, "exec-in") &&
+                           connect(graph, title_id, "result", print_title_id, "string") &&
+                           connect(graph, first_id, "result", loop_id, "first") &&
+                           connect(graph, last_id, "result", loop_id, "last") &&
+                           connect(graph, loop_id, "index", print_index_id, "string") &&
+                           connect(graph, values_id, "result", sum_id, "array") &&
+                           connect(graph, sum_id, "result", print_sum_id, "string");
+    if (!connected) {
+        return std::nullopt;
+    }
+    return graph;
+}
+
+// Компилирует команду и возвращает затраченное время в миллисекундах (-1 при ошибке).
+auto timed_compile(const std::string& arguments) -> double {
+    const auto command =
+        std::string(MULTICODE_BENCH_CXX_COMPILER) + " -std=c++20 -O2 " + arguments;
+    const auto begin = std::chrono::steady_clock::now();
+    if (std::system(command.c_str()) != 0) {
+        return -1.0;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+    return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+auto quote_path(const std::filesystem::path& path) -> std::string {
+    return "\"" + path.string() + "\"";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int graph_count = argc > 1 ? std::atoi(argv[1]) : 40;
+
+    std::vector<Graph> corpus;
+    corpus.reserve(static_cast<std::size_t>(graph_count));
+    for (int index = 0; index < graph_count; ++index) {
+        auto graph = build_corpus_graph(index);
+        if (!graph) {
+            std::cerr << "Failed to build corpus graph " << index << "\n";
+            return 1;
+        }
+        corpus.push_back(std::move(*graph));
+    }
+
+    const auto work_dir = std::filesystem::temp_directory_path() / "multicode_bench_prelude";
+    const auto standalone_dir = work_dir / "standalone";
+    const auto project_dir = work_dir / "project";
+    std::filesystem::create_directories(standalone_dir);
+    std::filesystem::create_directories(project_dir);
+
+    CppCodeGenerator generator;
+
+    double standalone_ms = 0.0;
+    for (const auto& graph : corpus) {
+        auto code = generator.generate(graph);
+        if (!code) {
+            std::cerr << "Generation failed: " << code.error().message << "\n";
+            return 1;
+        }
+        const auto source = standalone_dir / (std::string(graph.get_name()) + ".cpp");
+        std::ofstream(source) << code.value();
+        const auto elapsed = timed_compile("-c " + quote_path(source) + " -o " +
+                                           quote_path(source.string() + ".o"));
+        if (elapsed < 0.0) {
+            std::cerr << "Standalone compilation failed\n";
+            return 1;
+        }
+        standalone_ms += elapsed;
+    }
+
+    std::vector<const Graph*> graph_pointers;
+    graph_pointers.reserve(corpus.size());
+    for (const auto& graph : corpus) {
+        graph_pointers.push_back(&graph);
+    }
+    auto project = generator.generate_project(graph_pointers);
+    if (!project) {
+        std::cerr << "Project generation failed: " << project.error().message << "\n";
+        return 1;
+    }
+    for (const auto& file : project.value()) {
+        std::ofstream(project_dir / file.path) << file.content;
+    }
+
+    // GCC ищет <header>.gch, Clang — <header>.pch рядом с заголовком из -include.
+    const auto prelude = project_dir / project.value().front().path;
+    const auto pch = prelude.string() + MULTICODE_BENCH_PCH_SUFFIX;
+    const auto pch_ms =
+        timed_compile("-x c++-header " + quote_path(prelude) + " -o " + quote_path(pch));
+    if (pch_ms < 0.0) {
+        std::cerr << "Prelude precompilation failed\n";
+        return 1;
+    }
+
+    double project_ms = pch_ms;
+    for (const auto& file : project.value()) {
+        if (!file.path.ends_with(".cpp")) {
+            continue;
+        }
+        const auto source = project_dir / file.path;
+        const auto elapsed =
+            timed_compile("-include " + quote_path(prelude) + " -c " + quote_path(source) +
+                          " -o " + quote_path(source.string() + ".o"));
+        if (elapsed < 0.0) {
+            std::cerr << "Project compilation failed\n";
+            return 1;
+        }
+        project_ms += elapsed;
+    }
+
+    std::cout << "graphs: " << graph_count << "\n";
+    std::cout << "standalone: " << standalone_ms << " ms\n";
+    std::cout << "prelude + pch: " << project_ms << " ms (pch " << pch_ms << " ms)\n";
+    std::cout << "reduction: " << (1.0 - project_ms / standalone_ms) * 100.0 << " %\n";
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "visprog/core/Graph.hpp"
+
+namespace visprog::core {
+
+/// @brief Входная колонка: значения переменной графа (узлы GetVariable) для каждой записи.
+/// bool передаётся как 0/1.
+struct ColumnInput {
+    std::string variable;
+    std::span<const std::int64_t> values;
+};
+
+/// @brief Результат пакетного вычисления: по колонке на каждый запрошенный выход.
+struct ColumnarResult {
+    std::vector<std::vector<std::int64_t>> columns;
+    std::size_t records{0};
+    std::chrono::nanoseconds elapsed{0};
+
+    /// @brief Пропускная способность вычисления (без учёта компиляции).
+    [[nodiscard]] auto records_per_second() const noexcept -> double;
+};
+
+/// @brief Пакетное вычисление чистого подграфа данных над колонками записей.
+/// @details Подграф (литералы, Add, GetVariable как входы) компилируется в линейную программу
+/// над колонками: каждый узел исполняется один раз на блок записей простым циклом, который
+/// компилятор векторизует, вместо обхода графа на каждую запись. Константные подвыражения
+/// сворачиваются при компиляции. Целые складываются с переполнением по модулю 2^64.
+/// Граф после compile() не нужен.
+class ColumnarEvaluator {
+public:
+    /// @brief Скомпилировать выходы outputs — узлы данных, значение каждого берётся с его
+    /// единственного выходного порта.
+    [[nodiscard]] static auto compile(const Graph& graph, std::span<const NodeId> outputs)
+        -> Result<ColumnarEvaluator>;
+
+    /// @brief Вычислить все выходы для пакета записей; колонки входов должны быть одной длины.
+    [[nodiscard]] auto evaluate(std::span<const ColumnInput> inputs) const
+        -> Result<ColumnarResult>;
+
+    /// @brief Имена переменных, которые нужно передать в evaluate().
+    [[nodiscard]] auto input_names() const noexcept -> std::span<const std::string> {
+        return input_names_;
+    }
+
+private:
+    enum class OpCode : std::uint8_t {
+        AddColumns,  ///< out = lhs + rhs
+        AddScalar,   ///< out = lhs + constant
+    };
+
+    /// @brief Операнд: колонка (вход или временная) либо константа, известная при компиляции.
+    struct Operand {
+        bool constant{false};
+        std::int64_t value{0};
+        std::uint32_t column{0};
+    };
+
+    struct Operation {
+        OpCode code{OpCode::AddColumns};
+        std::uint32_t target{0};
+        std::uint32_t lhs{0};
+        std::uint32_t rhs{0};
+        std::int64_t constant{0};
+    };
+
+    ColumnarEvaluator() = default;
+
+    std::vector<std::string> input_names_;
+    std::vector<std::uint32_t> input_columns_;  ///< Колонка каждого входа из input_names_
+    std::vector<Operation> program_;
+    std::vector<Operand> outputs_;
+    std::uint32_t column_count_{0};  ///< Входные и временные колонки программы
+};
+
+}  // namespace visprog::core
@@ -0,0 +1,67 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "visprog/core/Graph.hpp"
+
+namespace visprog::core {
+
+/// @brief Вид горячей точки, найденной статической оценкой.
+enum class HotSpotKind : std::uint8_t {
+    None,
+    LargeLoop,        ///< Цикл с большим числом итераций
+    NestedLoop,       ///< Вложенный цикл с большим суммарным числом итераций
+    ExpensiveInLoop,  ///< Дорогой узел (вывод, массивы, потоки) в теле цикла
+    StringInLoop,     ///< Копирование std::string на каждой итерации
+};
+
+/// @brief Оценка одного узла для подсветки в редакторе.
+struct NodeCostAnnotation {
+    NodeId node;
+    double execution_count{0.0};  ///< Ожидаемое число выполнений за запуск программы
+    double cost_weight{0.0};      ///< Условная стоимость одного выполнения
+    double total_cost{0.0};       ///< execution_count * cost_weight
+    int loop_depth{0};            ///< Вложенность циклов For, в которой выполняется узел
+    HotSpotKind hot_spot{HotSpotKind::None};
+    std::string note;  ///< Пояснение к горячей точке (пусто, если её нет)
+};
+
+/// @brief Результат статической оценки графа.
+struct CostEstimate {
+    std::vector<NodeCostAnnotation> annotations;  ///< По одной записи на узел, в порядке графа
+    double total_cost{0.0};
+
+    [[nodiscard]] auto find(NodeId id) const noexcept -> const NodeCostAnnotation*;
+    [[nodiscard]] auto hot_spots() const -> std::vector<const NodeCostAnnotation*>;
+};
+
+/// @brief Параметры статической модели стоимости.
+struct CostModelOptions {
+    double unknown_trip_count{16.0};       ///< Итерации цикла с неконстантными границами
+    double branch_probability{0.5};        ///< Вероятность каждого плеча Branch
+    double large_loop_trip_count{10'000.0};  ///< Порог LargeLoop/NestedLoop по итерациям
+    double expensive_cost_threshold{1e5};  ///< Порог total_cost для ExpensiveInLoop
+};
+
+/// @brief Статическая оценка стоимости графа до запуска программы.
+class CostModel {
+public:
+    CostModel() = delete;
+
+    /// @brief Оценить число выполнений и стоимость каждого узла графа.
+    [[nodiscard]] static auto estimate(const Graph& graph, const CostModelOptions& options = {})
+        -> CostEstimate;
+
+    /// @brief Аннотации в JSON-формате для редактора.
+    [[nodiscard]] static auto to_json(const CostEstimate& estimate) -> nlohmann::json;
+
+    [[nodiscard]] static auto hot_spot_name(HotSpotKind kind) noexcept -> std::string_view;
+};
+
+}  // namespace visprog::core
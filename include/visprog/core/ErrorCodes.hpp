@@ -37,4 +37,64 @@ constexpr int InvalidConnection = 605;
 constexpr int InvalidSchemaVersion = 606;
 }  // namespace serializer
 
+namespace codegen {
+constexpr int ParallelWriteConflict = 700;
+constexpr int ParallelReadWriteConflict = 701;
+constexpr int ColdCodeKept = 702;
+}  // namespace codegen
+
+namespace graph_history {
+constexpr int NothingToUndo = 800;
+constexpr int NothingToRedo = 801;
+constexpr int InconsistentHistory = 802;
+}  // namespace graph_history
+
+namespace clipboard {
+constexpr int InvalidSelection = 900;
+constexpr int MalformedBlob = 901;
+constexpr int UnsupportedVersion = 902;
+constexpr int UnknownNodeType = 903;
+constexpr int InvalidConnection = 904;
+constexpr int VariableTypeConflict = 905;
+}  // namespace clipboard
+
+namespace workspace {
+constexpr int DuplicateGraph = 1000;
+constexpr int GraphNotFound = 1001;
+constexpr int IoError = 1002;
+constexpr int ParseError = 1003;
+constexpr int TypeConflict = 1004;
+}  // namespace workspace
+
+namespace interpreter {
+constexpr int MissingStart = 1100;
+constexpr int CyclicGraph = 1101;
+constexpr int NotExecutable = 1102;
+constexpr int PatchTouchesActivePath = 1103;
+}  // namespace interpreter
+
+namespace transport {
+constexpr int SharedMemoryFailed = 1200;
+constexpr int InvalidSegment = 1201;
+constexpr int Unsupported = 1202;
+}  // namespace transport
+
+namespace text_diff {
+constexpr int InvalidEdit = 1300;
+}  // namespace text_diff
+
+namespace columnar {
+constexpr int UnsupportedNode = 1400;
+constexpr int MissingInput = 1401;
+constexpr int ColumnLengthMismatch = 1402;
+constexpr int InvalidOutput = 1403;
+constexpr int CyclicGraph = 1404;
+}  // namespace columnar
+
+namespace profiler {
+constexpr int AlreadyRunning = 1500;
+constexpr int Unsupported = 1501;
+constexpr int TimerFailed = 1502;
+}  // namespace profiler
+
 }  // namespace visprog::core::error_codes
@@ -8,9 +8,12 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "visprog/core/Connection.hpp"
+#include "visprog/core/GraphHistory.hpp"
+#include "visprog/core/GraphStatistics.hpp"
 #include "visprog/core/Node.hpp"
 #include "visprog/core/Types.hpp"
 
@@ -72,6 +75,10 @@ public:
     [[nodiscard]] auto get_connections() const noexcept -> std::span<const Connection>;
     [[nodiscard]] auto get_connections_from(NodeId node) const -> std::vector<ConnectionId>;
     [[nodiscard]] auto get_connections_to(NodeId node) const -> std::vector<ConnectionId>;
+    /// @brief Исходящие связи узла без копирования (для обходов в GraphAlgorithms.hpp).
+    [[nodiscard]] auto outgoing(NodeId node) const -> std::span<const ConnectionId>;
+    /// @brief Входящие связи узла без копирования.
+    [[nodiscard]] auto incoming(NodeId node) const -> std::span<const ConnectionId>;
     [[nodiscard]] auto has_connection(ConnectionId id) const noexcept -> bool;
     [[nodiscard]] auto connection_count() const noexcept -> std::size_t;
 
@@ -88,6 +95,60 @@ public:
     /// @brief Gets all variables defined in the graph
     [[nodiscard]] auto get_variables() const noexcept -> std::span<const Variable>;
 
+    // ========================================================================
+    // Undo / Redo
+    // ========================================================================
+
+    /// @brief Sets a node property and records the previous value for undo
+    auto set_node_property(NodeId node, const std::string& key, NodeProperty value)
+        -> Result<void>;
+
+    /// @brief Sets one property on many nodes as a single edit (multi-select in the editor)
+    /// @details All nodes must exist, otherwise nothing changes. The change is one undo step
+    /// and one property_revision() bump regardless of the number of nodes.
+    auto set_property_batch(std::span<const NodeId> nodes,
+                            const std::string& key,
+                            const NodeProperty& value) -> Result<void>;
+
+    /// @brief Reverts the last edit step (one mutation or one edit group)
+    auto undo() -> Result<void>;
+
+    /// @brief Re-applies the last undone edit step
+    auto redo() -> Result<void>;
+
+    /// @brief Groups subsequent mutations into a single undo step; groups may nest
+    void begin_edit_group();
+    void end_edit_group();
+
+    /// @brief Limits the number of undo steps; the oldest steps are dropped first
+    void set_history_limit(std::size_t limit);
+    void clear_history();
+    [[nodiscard]] auto history() const noexcept -> const GraphHistory&;
+
+    // ========================================================================
+    // Statistics
+    // ========================================================================
+
+    /// @brief Счётчик структурных изменений (узлы и связи); свойства и переменные не влияют
+    [[nodiscard]] auto revision() const noexcept -> std::uint64_t;
+    /// @brief Счётчик правок свойств узлов: одна правка или одна пачка — одно увеличение
+    [[nodiscard]] auto property_revision() const noexcept -> std::uint64_t;
+
+    /// @brief Представитель компоненты слабой связности узла (NodeId{0}, если узла нет)
+    /// @details Компоненты поддерживаются union-find: connect() объединяет их сразу,
+    /// disconnect() и remove_node() помечают разбиение устаревшим до следующего запроса.
+    [[nodiscard]] auto component_of(NodeId node) const -> NodeId;
+    [[nodiscard]] auto same_component(NodeId lhs, NodeId rhs) const -> bool;
+    [[nodiscard]] auto component_count() const -> std::size_t;
+
+    /// @brief Узлы, сгруппированные по компонентам, — независимые единицы работы для
+    /// параллельных проходов. Порядок узлов и компонент следует порядку узлов в графе.
+    [[nodiscard]] auto components() const -> std::vector<std::vector<NodeId>>;
+
+    /// @brief Сводка формы графа; пересчитывается только после изменения revision()
+    /// @details Кеш не синхронизирован: конкурентные вызовы требуют внешней блокировки.
+    [[nodiscard]] auto statistics() const -> const GraphStatistics&;
+
     // ... (existing graph algorithms, validation, query, metadata, etc.)
     [[nodiscard]] auto validate() const -> ValidationResult;
     [[nodiscard]] auto get_id() const noexcept -> GraphId;
@@ -98,6 +159,7 @@ public:
 
 private:
     friend class GraphSerializer;
+    friend class SelectionClipboard;
 
     // ... (existing private members)
     GraphId id_;
@@ -114,9 +176,35 @@ private:
     // Graph-level variables
     std::vector<Variable> variables_;
 
+    // Delta-based undo/redo log
+    GraphHistory history_;
+
+    // Structural revision and the statistics computed for it
+    std::uint64_t revision_{1};
+    std::uint64_t property_revision_{1};
+    mutable std::optional<GraphStatistics> statistics_;
+
+    // Connected components: union-find over node ids, rebuilt lazily after removals
+    struct ComponentLink {
+        NodeId parent;
+        std::uint32_t size{1};
+    };
+    mutable std::unordered_map<NodeId, ComponentLink> component_links_;
+    mutable std::size_t component_count_{0};
+    mutable bool components_dirty_{false};
+
     // Helper methods for node/connection management
     [[nodiscard]] auto generate_connection_id() -> ConnectionId;
     auto remove_node_connections(NodeId node) -> void;
+    auto record(GraphEdit edit) -> void;
+    auto revert_edit(GraphEdit& edit) -> Result<void>;
+    auto reapply_edit(GraphEdit& edit) -> Result<void>;
+    [[nodiscard]] auto detach_node(NodeId id) -> std::pair<std::unique_ptr<Node>, std::size_t>;
+    auto attach_node(std::unique_ptr<Node> node, std::size_t position) -> void;
+    auto insert_connection(const Connection& connection) -> void;
+    auto find_component(NodeId node) const -> NodeId;
+    auto unite_components(NodeId lhs, NodeId rhs) const -> void;
+    auto rebuild_components() const -> void;
     [[nodiscard]] auto validate_node_exists(NodeId id) const -> Result<void>;
     [[nodiscard]] auto validate_connection(NodeId from_node,
                                            PortId from_port,
@@ -0,0 +1,328 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "visprog/core/Connection.hpp"
+#include "visprog/core/Graph.hpp"
+#include "visprog/core/Node.hpp"
+
+/// @file GraphAlgorithms.hpp
+/// @brief Обобщённые обходы графа: BFS, DFS и топологический порядок.
+///
+/// Фильтр связей и посетитель — параметры шаблона, поэтому выбор связей и реакция на узел
+/// разрешаются на этапе компиляции. Всё рабочее состояние (плотные индексы, битовое множество
+/// посещённых, очередь/стек) живёт в TraversalScratch: после первого вызова на графе данного
+/// размера обходы не выделяют память.
+
+namespace visprog::core::algorithms {
+
+/// @brief Реакция посетителя на узел.
+enum class VisitAction : std::uint8_t {
+    Continue,      ///< Продолжить обход через соседей узла
+    SkipChildren,  ///< Не идти к соседям этого узла
+    Stop,          ///< Прервать обход
+};
+
+/// @brief Направление обхода: по связям (from → to) или против них (to → from).
+enum class Direction : std::uint8_t {
+    Forward,
+    Reverse,
+};
+
+/// @brief Фильтр: все связи.
+struct AllEdges {
+    [[nodiscard]] constexpr auto operator()(const Connection& /*connection*/) const noexcept
+        -> bool {
+        return true;
+    }
+};
+
+/// @brief Фильтр: только связи потока исполнения.
+struct ExecEdges {
+    [[nodiscard]] constexpr auto operator()(const Connection& connection) const noexcept -> bool {
+        return connection.type == ConnectionType::Execution;
+    }
+};
+
+/// @brief Фильтр: только связи потока данных.
+struct DataEdges {
+    [[nodiscard]] constexpr auto operator()(const Connection& connection) const noexcept -> bool {
+        return connection.type == ConnectionType::Data;
+    }
+};
+
+template <typename Filter>
+concept EdgeFilter = std::predicate<const Filter&, const Connection&>;
+
+/// @brief Посетитель вызывается как visitor(node, depth) и возвращает void или VisitAction.
+template <typename Visitor>
+concept NodeVisitor = std::invocable<Visitor&, const Node&, std::uint32_t>;
+
+/// @brief Переиспользуемое рабочее состояние обходов.
+/// @details Один экземпляр нельзя использовать во вложенных обходах одновременно.
+/// Плотный индекс узлов привязан к адресу графа и его revision(): экземпляр, переживший
+/// свой граф, нужно сбросить через invalidate() до обхода другого графа.
+class TraversalScratch {
+public:
+    /// @brief Подготовить обход: индекс узлов перестраивается, только если граф или его
+    /// revision() сменились; отметки предыдущего обхода снимаются; ёмкость буферов сохраняется.
+    void prepare(const Graph& graph);
+
+    /// @brief Забыть индекс: следующий prepare() перестроит его.
+    void invalidate() noexcept {
+        graph_ = nullptr;
+    }
+
+    [[nodiscard]] auto node_count() const noexcept -> std::uint32_t {
+        return static_cast<std::uint32_t>(nodes_.size());
+    }
+
+    /// @brief Плотный индекс узла (двоичный поиск по отсортированным NodeId).
+    [[nodiscard]] auto index_of(NodeId id) const noexcept -> std::optional<std::uint32_t>;
+
+    [[nodiscard]] auto node_at(std::uint32_t index) const noexcept -> const Node& {
+        return *nodes_[index];
+    }
+
+    /// @brief Отметить узел посещённым; false, если он уже был отмечен.
+    auto mark(std::uint32_t index) noexcept -> bool {
+        auto& word = visited_[index / 64];
+        const auto bit = std::uint64_t{1} << (index % 64);
+        const bool fresh = (word & bit) == 0;
+        if (word == 0) {
+            // Ёмкость touched_ зарезервирована на все слова — push_back не выделяет память
+            touched_.push_back(index / 64);
+        }
+        word |= bit;
+        return fresh;
+    }
+
+    [[nodiscard]] auto is_marked(std::uint32_t index) const noexcept -> bool {
+        return (visited_[index / 64] & (std::uint64_t{1} << (index % 64))) != 0;
+    }
+
+    /// @brief Суммарная ёмкость буферов в байтах (для проверки отсутствия аллокаций).
+    [[nodiscard]] auto footprint() const noexcept -> std::size_t;
+
+    // Рабочие буферы алгоритмов этого заголовка; prepare() очищает их, сохраняя ёмкость.
+    std::vector<std::uint32_t> frontier;  ///< Очередь BFS / стек DFS / очередь Кана
+    std::vector<std::uint32_t> depths;    ///< Глубины, параллельные frontier (или по индексам)
+    std::vector<std::uint32_t> counters;  ///< Входящие степени для топологического обхода
+
+private:
+    std::vector<const Node*> nodes_;      ///< Узлы, упорядоченные по NodeId
+    std::vector<std::uint64_t> visited_;  ///< Битовое множество по плотным индексам
+    std::vector<std::uint32_t> touched_;  ///< Ненулевые слова visited_ — их снимает prepare()
+    const Graph* graph_{nullptr};         ///< Граф, для которого построен nodes_
+    std::uint64_t revision_{0};
+    const Node* first_node_{nullptr};  ///< Первый узел графа на момент построения индекса
+};
+
+namespace detail {
+
+template <typename Visitor>
+auto invoke_visitor(Visitor& visitor, const Node& node, std::uint32_t depth) -> VisitAction {
+    if constexpr (std::is_void_v<std::invoke_result_t<Visitor&, const Node&, std::uint32_t>>) {
+        visitor(node, depth);
+        return VisitAction::Continue;
+    } else {
+        return visitor(node, depth);
+    }
+}
+
+/// @brief Вызывает on_neighbor(index) для соседей узла по отфильтрованным связям.
+template <Direction Dir, typename Filter, typename Callback>
+void for_each_neighbor(const Graph& graph,
+                       const TraversalScratch& scratch,
+                       const Node& node,
+                       const Filter& filter,
+                       Callback&& on_neighbor) {
+    const auto edges =
+        Dir == Direction::Forward ? graph.outgoing(node.get_id()) : graph.incoming(node.get_id());
+    for (const auto connection_id : edges) {
+        const auto* connection = graph.get_connection(connection_id);
+        if (connection == nullptr || !filter(*connection)) {
+            continue;
+        }
+        const auto next = Dir == Direction::Forward ? connection->to_node : connection->from_node;
+        if (const auto index = scratch.index_of(next)) {
+            on_neighbor(*index);
+        }
+    }
+}
+
+}  // namespace detail
+
+/// @brief Обход в ширину от корней; depth — расстояние от ближайшего корня.
+/// @return Число посещённых узлов.
+template <typename Filter = AllEdges, Direction Dir = Direction::Forward, typename Visitor>
+    requires EdgeFilter<Filter> && NodeVisitor<Visitor>
+auto breadth_first(const Graph& graph,
+                   std::span<const NodeId> roots,
+                   Visitor&& visitor,
+                   TraversalScratch& scratch,
+                   Filter filter = {}) -> std::size_t {
+    scratch.prepare(graph);
+    auto& queue = scratch.frontier;
+    auto& depths = scratch.depths;
+    for (const auto root : roots) {
+        if (const auto index = scratch.index_of(root); index && scratch.mark(*index)) {
+            queue.push_back(*index);
+            depths.push_back(0);
+        }
+    }
+
+    std::size_t visited = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const auto index = queue[head];
+        const auto depth = depths[head];
+        const auto& node = scratch.node_at(index);
+        ++visited;
+
+        const auto action = detail::invoke_visitor(visitor, node, depth);
+        if (action == VisitAction::Stop) {
+            break;
+        }
+        if (action == VisitAction::SkipChildren) {
+            continue;
+        }
+        detail::for_each_neighbor<Dir>(graph, scratch, node, filter, [&](std::uint32_t next) {
+            if (scratch.mark(next)) {
+                queue.push_back(next);
+                depths.push_back(depth + 1);
+            }
+        });
+    }
+    return visited;
+}
+
+/// @brief Обход в глубину (прямой порядок) от корней; depth — глубина в дереве обхода.
+/// @return Число посещённых узлов.
+template <typename Filter = AllEdges, Direction Dir = Direction::Forward, typename Visitor>
+    requires EdgeFilter<Filter> && NodeVisitor<Visitor>
+auto depth_first(const Graph& graph,
+                 std::span<const NodeId> roots,
+                 Visitor&& visitor,
+                 TraversalScratch& scratch,
+                 Filter filter = {}) -> std::size_t {
+    scratch.prepare(graph);
+    auto& stack = scratch.frontier;
+    auto& depths = scratch.depths;
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+        if (const auto index = scratch.index_of(*it)) {
+            stack.push_back(*index);
+            depths.push_back(0);
+        }
+    }
+
+    std::size_t visited = 0;
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        const auto depth = depths.back();
+        stack.pop_back();
+        depths.pop_back();
+        if (!scratch.mark(index)) {
+            continue;
+        }
+
+        const auto& node = scratch.node_at(index);
+        ++visited;
+        const auto action = detail::invoke_visitor(visitor, node, depth);
+        if (action == VisitAction::Stop) {
+            break;
+        }
+        if (action == VisitAction::SkipChildren) {
+            continue;
+        }
+
+        // Соседи кладутся в обратном порядке, чтобы первый сосед обрабатывался первым.
+        const auto first_child = stack.size();
+        detail::for_each_neighbor<Dir>(graph, scratch, node, filter, [&](std::uint32_t next) {
+            if (!scratch.is_marked(next)) {
+                stack.push_back(next);
+                depths.push_back(depth + 1);
+            }
+        });
+        std::reverse(stack.begin() + static_cast<std::ptrdiff_t>(first_child), stack.end());
+    }
+    return visited;
+}
+
+/// @brief Топологический обход всего графа по алгоритму Кана; depth — длина самого длинного
+/// пути до узла по отфильтрованным связям.
+/// @return false, если отфильтрованный подграф содержит цикл (узлы цикла не посещаются).
+template <typename Filter = AllEdges, Direction Dir = Direction::Forward, typename Visitor>
+    requires EdgeFilter<Filter> && NodeVisitor<Visitor>
+auto topological_visit(const Graph& graph,
+                       Visitor&& visitor,
+                       TraversalScratch& scratch,
+                       Filter filter = {}) -> bool {
+    scratch.prepare(graph);
+    const auto count = scratch.node_count();
+    auto& queue = scratch.frontier;
+    auto& levels = scratch.depths;
+    auto& in_degree = scratch.counters;
+    levels.assign(count, 0);
+    in_degree.assign(count, 0);
+
+    for (std::uint32_t index = 0; index < count; ++index) {
+        detail::for_each_neighbor<Dir>(graph, scratch, scratch.node_at(index), filter,
+                                       [&](std::uint32_t next) { ++in_degree[next]; });
+    }
+    for (std::uint32_t index = 0; index < count; ++index) {
+        if (in_degree[index] == 0) {
+            queue.push_back(index);
+        }
+    }
+
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const auto index = queue[head];
+        const auto& node = scratch.node_at(index);
+        if (detail::invoke_visitor(visitor, node, levels[index]) == VisitAction::Stop) {
+            return true;
+        }
+        detail::for_each_neighbor<Dir>(graph, scratch, node, filter, [&](std::uint32_t next) {
+            levels[next] = std::max(levels[next], levels[index] + 1);
+            if (--in_degree[next] == 0) {
+                queue.push_back(next);
+            }
+        });
+    }
+    return queue.size() == count;
+}
+
+/// @brief Обход от одного корня.
+template <typename Filter = AllEdges, Direction Dir = Direction::Forward, typename Visitor>
+    requires EdgeFilter<Filter> && NodeVisitor<Visitor>
+auto breadth_first(const Graph& graph,
+                   NodeId root,
+                   Visitor&& visitor,
+                   TraversalScratch& scratch,
+                   Filter filter = {}) -> std::size_t {
+    return breadth_first<Filter, Dir>(graph, std::span<const NodeId>(&root, 1),
+                                      std::forward<Visitor>(visitor), scratch, filter);
+}
+
+/// @brief Обход от одного корня.
+template <typename Filter = AllEdges, Direction Dir = Direction::Forward, typename Visitor>
+    requires EdgeFilter<Filter> && NodeVisitor<Visitor>
+auto depth_first(const Graph& graph,
+                 NodeId root,
+                 Visitor&& visitor,
+                 TraversalScratch& scratch,
+                 Filter filter = {}) -> std::size_t {
+    return depth_first<Filter, Dir>(graph, std::span<const NodeId>(&root, 1),
+                                    std::forward<Visitor>(visitor), scratch, filter);
+}
+
+}  // namespace visprog::core::algorithms
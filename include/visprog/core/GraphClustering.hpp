@@ -0,0 +1,135 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "visprog/core/Graph.hpp"
+
+namespace visprog::core {
+
+struct ClusteringOptions {
+    std::size_t target_clusters{300};  ///< Иерархия растёт, пока на верхнем уровне больше
+    std::size_t max_levels{16};
+    std::uint32_t exec_weight{2};  ///< Вес exec-связи: поток исполнения важнее для раскладки
+    std::uint32_t data_weight{1};
+    std::uint32_t max_passes{16};  ///< Проходы локальных перемещений на уровень
+    double rebuild_fraction{0.25};  ///< Доля затронутых узлов, с которой update() строит заново
+};
+
+/// @brief Кластер одного уровня иерархии.
+struct Cluster {
+    static constexpr std::uint32_t kNoParent = std::numeric_limits<std::uint32_t>::max();
+
+    /// @brief Уровень 0: ключ не меняется между update(), пока кластер существует;
+    /// выше — индекс кластера в уровне.
+    std::uint64_t key{0};
+    std::uint32_t parent{kNoParent};  ///< Индекс кластера на следующем уровне
+    std::uint32_t node_count{0};
+    NodeId representative;  ///< Узел с наибольшей степенью — подпись кластера в редакторе
+    std::vector<std::uint32_t> children;  ///< Индексы на предыдущем уровне (пусто на уровне 0)
+    std::vector<NodeId> nodes;            ///< Узлы кластера (только на уровне 0)
+};
+
+/// @brief Связи между двумя кластерами уровня, сведённые в одно ребро from → to.
+struct ClusterEdge {
+    std::uint32_t from{0};
+    std::uint32_t to{0};
+    std::uint32_t exec_links{0};
+    std::uint32_t data_links{0};
+};
+
+struct ClusterLevel {
+    std::vector<Cluster> clusters;
+    std::vector<ClusterEdge> edges;  ///< По возрастанию (from, to), без связей внутри кластера
+};
+
+/// @brief Итог update(): сколько узлов затронула правка и сколько сменило кластер.
+struct ClusteringUpdate {
+    bool rebuilt{false};
+    std::size_t changed_nodes{0};
+    std::size_t moved_nodes{0};
+};
+
+/// @brief Иерархическая кластеризация графа для отрисовки при сильном отдалении.
+/// @details Уровень 0 — сообщества узлов по модулярности (Louvain) над exec- и data-связями
+/// как неориентированным взвешенным графом; каждый следующий уровень объединяет кластеры
+/// предыдущего, пока их больше target_clusters. Когда модулярность перестаёт расти
+/// (например, много несвязанных компонент), кластеры сливаются попарно по самой тяжёлой
+/// связи. update() сравнивает граф со снимком и перемещает только затронутые узлы уровня 0,
+/// а верхние уровни, построенные над сотнями кластеров, пересчитывает целиком.
+class GraphClustering {
+public:
+    explicit GraphClustering(ClusteringOptions options = {});
+
+    /// @brief Построить иерархию заново.
+    auto rebuild(const Graph& graph) -> void;
+    /// @brief Привести иерархию к текущему состоянию графа.
+    /// @details Другой граф или слишком крупная правка (rebuild_fraction) — полная перестройка.
+    auto update(const Graph& graph) -> ClusteringUpdate;
+
+    /// @brief Уровни от мелких кластеров к крупным; пусто до первого rebuild()/update().
+    [[nodiscard]] auto levels() const noexcept -> std::span<const ClusterLevel> {
+        return levels_;
+    }
+    /// @brief Самый подробный уровень, в котором не больше max_clusters кластеров
+    /// (или самый крупный уровень, если такого нет).
+    [[nodiscard]] auto level_for(std::size_t max_clusters) const -> const ClusterLevel*;
+    /// @brief Индекс кластера узла на уровне level.
+    [[nodiscard]] auto cluster_of(NodeId node, std::size_t level) const
+        -> std::optional<std::uint32_t>;
+    /// @brief Все узлы кластера уровня level.
+    [[nodiscard]] auto nodes_of(std::size_t level, std::uint32_t cluster) const
+        -> std::vector<NodeId>;
+    /// @brief Модулярность разбиения уровня 0 (0 для графа без связей).
+    [[nodiscard]] auto modularity() const noexcept -> double {
+        return modularity_;
+    }
+
+private:
+    struct Slot {
+        std::uint64_t key{0};
+        std::uint64_t degree{0};  ///< Сумма взвешенных степеней узлов
+        std::vector<NodeId> nodes;
+    };
+    struct NodeState {
+        std::uint32_t slot{0};
+        std::uint32_t position{0};  ///< Позиция в Slot::nodes
+        std::uint64_t degree{0};
+    };
+    struct LinkRecord {
+        NodeId from;
+        NodeId to;
+    };
+
+    [[nodiscard]] auto link_weight(const Connection& connection) const noexcept -> std::uint64_t;
+    [[nodiscard]] auto node_degree(const Graph& graph, NodeId node) const -> std::uint64_t;
+    auto new_slot() -> std::uint32_t;
+    auto attach(NodeId node, std::uint32_t slot) -> void;
+    auto detach(NodeId node) -> void;
+    auto local_move(const Graph& graph, NodeId node) -> bool;
+    auto publish(const Graph& graph) -> void;
+
+    ClusteringOptions options_;
+    GraphId graph_id_;
+    std::uint64_t revision_{0};
+    std::vector<ClusterLevel> levels_;
+    double modularity_{0.0};
+
+    // Состояние уровня 0, которое update() правит на месте
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> free_slots_;
+    std::uint64_t next_key_{1};
+    std::uint64_t total_degree_{0};  ///< 2m: сумма степеней всех узлов
+    std::unordered_map<NodeId, NodeState> nodes_;
+    std::unordered_map<ConnectionId, LinkRecord> links_;
+    std::vector<std::uint32_t> slot_index_;  ///< Слот → индекс кластера уровня 0
+};
+
+}  // namespace visprog::core
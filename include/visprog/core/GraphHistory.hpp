@@ -0,0 +1,121 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "visprog/core/Connection.hpp"
+#include "visprog/core/Node.hpp"
+#include "visprog/core/Types.hpp"
+
+namespace visprog::core {
+
+// Записи журнала правок. Каждая хранит ровно то, что нужно для отмены и повтора одной мутации:
+// объём истории пропорционален сделанным правкам, а не размеру графа.
+
+/// @brief Узел добавлен; после отмены узел хранится в detached до повтора.
+struct NodeAddedEdit {
+    NodeId node;
+    std::size_t position{0};
+    std::unique_ptr<Node> detached;
+};
+
+/// @brief Узел удалён вместе со связями; узел хранится в detached до отмены.
+struct NodeRemovedEdit {
+    NodeId node;
+    std::size_t position{0};
+    std::unique_ptr<Node> detached;
+    std::vector<Connection> connections;
+};
+
+struct ConnectionAddedEdit {
+    Connection connection;
+};
+
+struct ConnectionRemovedEdit {
+    Connection connection;
+};
+
+/// @brief Свойство узла изменено; nullopt означает «свойства не было».
+struct PropertyChangedEdit {
+    NodeId node;
+    std::string key;
+    std::optional<NodeProperty> before;
+    std::optional<NodeProperty> after;
+};
+
+/// @brief Одно свойство выставлено группе узлов; ключ и новое значение хранятся один раз.
+struct PropertyBatchEdit {
+    std::string key;
+    NodeProperty after;
+    std::vector<NodeId> nodes;
+    std::vector<std::optional<NodeProperty>> before;  ///< Прежние значения, параллельно nodes
+};
+
+struct VariableAddedEdit {
+    std::string name;
+    DataType type{DataType::Unknown};
+};
+
+struct GraphRenamedEdit {
+    std::string before;
+    std::string after;
+};
+
+using GraphEdit = std::variant<NodeAddedEdit,
+                               NodeRemovedEdit,
+                               ConnectionAddedEdit,
+                               ConnectionRemovedEdit,
+                               PropertyChangedEdit,
+                               PropertyBatchEdit,
+                               VariableAddedEdit,
+                               GraphRenamedEdit>;
+
+/// @brief Один шаг отмены: одна мутация или группа, открытая begin_edit_group().
+struct EditStep {
+    std::vector<GraphEdit> edits;
+};
+
+/// @brief Журнал правок графа (стеки undo/redo). Изменяется только через Graph.
+class GraphHistory {
+public:
+    inline static constexpr std::size_t kDefaultLimit = 1000;
+
+    [[nodiscard]] auto can_undo() const noexcept -> bool {
+        return !undo_.empty();
+    }
+    [[nodiscard]] auto can_redo() const noexcept -> bool {
+        return !redo_.empty();
+    }
+    [[nodiscard]] auto undo_depth() const noexcept -> std::size_t {
+        return undo_.size();
+    }
+    [[nodiscard]] auto redo_depth() const noexcept -> std::size_t {
+        return redo_.size();
+    }
+    [[nodiscard]] auto limit() const noexcept -> std::size_t {
+        return limit_;
+    }
+    /// @brief Число записей в верхнем шаге отмены (0, если отменять нечего).
+    [[nodiscard]] auto top_step_size() const noexcept -> std::size_t {
+        return undo_.empty() ? 0 : undo_.back().edits.size();
+    }
+
+private:
+    friend class Graph;
+
+    std::deque<EditStep> undo_;
+    std::deque<EditStep> redo_;
+    std::optional<EditStep> open_group_;
+    int group_depth_{0};
+    int suspended_{0};
+    std::size_t limit_{kDefaultLimit};
+};
+
+}  // namespace visprog::core
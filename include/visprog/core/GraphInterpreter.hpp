@@ -0,0 +1,213 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+#include "visprog/core/Graph.hpp"
+
+namespace visprog::core {
+
+/// @brief Значение порта данных во время интерпретации; monostate — «ещё не вычислено».
+using InterpreterValue =
+    std::variant<std::monostate, bool, std::int64_t, std::string, std::vector<std::int64_t>>;
+
+class GraphInterpreter;
+class GraphProfiler;
+struct ExecutionStack;
+
+/// @brief Условие точки останова: останов происходит, только если предикат вернул true.
+using BreakCondition = std::function<bool(const GraphInterpreter&)>;
+
+/// @brief Причина, по которой run()/step() вернули управление.
+enum class StopReason : std::uint8_t {
+    Finished,        ///< Поток исполнения дошёл до конца
+    Breakpoint,      ///< Сработала точка останова на узле
+    EdgeBreakpoint,  ///< Сработала точка останова на exec-связи
+    Step,            ///< Выполнен один шаг step()
+};
+
+/// @brief Итог hot_patch(): число добавленных, удалённых и перелинкованных инструкций.
+struct PatchSummary {
+    std::size_t added{0};
+    std::size_t removed{0};
+    std::size_t relinked{0};
+};
+
+struct InterpreterOptions {
+    /// @brief Куда пишет PrintString; nullptr — std::cout.
+    std::ostream* output{nullptr};
+};
+
+/// @brief Прямое исполнение графа без генерации C++ (отладка, предпросмотр в редакторе).
+/// @details Exec-узлы компилируются в таблицу инструкций с указателями на обработчики.
+/// Точки останова и пошаговый режим подменяют записи этой таблицы на обработчик-ловушку,
+/// поэтому исполнение без точек останова не делает на узел ни одной лишней проверки.
+/// Граф должен пережить интерпретатор. Между вызовами run()/step() граф можно править,
+/// если до продолжения исполнения вызван hot_patch(); узлы текущего пути исполнения
+/// удалять нельзя.
+/// ParallelSequence исполняется последовательно: then-ветви по порядку, затем completed.
+class GraphInterpreter {
+public:
+    [[nodiscard]] static auto compile(const Graph& graph, InterpreterOptions options = {})
+        -> Result<GraphInterpreter>;
+
+    /// @brief Подхватить правки графа без перезапуска: перекомпилируются только затронутые
+    /// инструкции, переменные и позиция исполнения сохраняются. Удалять можно только узлы
+    /// вне текущего пути исполнения: текущий узел и узлы открытых кадров (ForLoop, Sequence).
+    /// @details Тело открытого цикла или ветви Sequence, кроме текущего узла, не считается
+    /// исполняемым: его можно править и удалять, и правки перелинковываются посреди итерации —
+    /// оставшаяся часть текущей итерации уже идёт по новым связям.
+    auto hot_patch() -> Result<PatchSummary>;
+
+    // ========================================================================
+    // Execution
+    // ========================================================================
+
+    /// @brief Исполнять до конца или до точки останова; после останова продолжает с него.
+    auto run() -> StopReason;
+    /// @brief Исполнить текущий exec-узел и остановиться перед следующим.
+    auto step() -> StopReason;
+    /// @brief Вернуться к началу: переменные и значения портов сбрасываются.
+    auto reset() -> void;
+
+    [[nodiscard]] auto is_finished() const noexcept -> bool {
+        return finished_;
+    }
+    /// @brief Узел, перед которым стоит исполнение (после останова); пустой id, если конец.
+    [[nodiscard]] auto current_node() const noexcept -> NodeId;
+    /// @brief Exec-связь, на которой сработала последняя EdgeBreakpoint.
+    [[nodiscard]] auto current_edge() const noexcept -> ConnectionId;
+
+    // ========================================================================
+    // Breakpoints
+    // ========================================================================
+
+    auto set_breakpoint(NodeId node, BreakCondition condition = {}) -> Result<void>;
+    auto clear_breakpoint(NodeId node) -> void;
+    auto set_edge_breakpoint(ConnectionId connection) -> Result<void>;
+    auto clear_edge_breakpoint(ConnectionId connection) -> void;
+    auto clear_breakpoints() -> void;
+
+    // ========================================================================
+    // Watches
+    // ========================================================================
+
+    /// @brief Последнее значение порта данных узла node.
+    /// @param port Имя порта; пустое — первый выходной порт данных. Для входного порта
+    /// возвращается значение подключённого к нему выхода.
+    [[nodiscard]] auto watch(NodeId node, std::string_view port = {}) const
+        -> std::optional<InterpreterValue>;
+    [[nodiscard]] auto variable(std::string_view name) const -> const InterpreterValue*;
+
+private:
+    friend class GraphProfiler;
+
+    using Handler = bool (*)(GraphInterpreter&, std::uint32_t);
+
+    static constexpr std::uint32_t NoTarget = ~std::uint32_t{0};
+
+    enum class FrameKind : std::uint8_t { Sequence, Parallel, Loop };
+
+    /// @brief Exec-узел или трамплин точки останова на связи (node == nullptr).
+    struct Instruction {
+        const Node* node{nullptr};
+        Handler handler{nullptr};
+        std::vector<std::uint32_t> targets;  ///< Переходы в порядке exec-выходов обработчика
+        std::vector<PortId> target_ports;    ///< Exec-выход, соответствующий слоту targets
+        ConnectionId edge;                   ///< Только у трамплина: связь с точкой останова
+    };
+
+    /// @brief Незавершённый узел с несколькими продолжениями (Sequence, ForLoop, ...).
+    struct Frame {
+        FrameKind kind{FrameKind::Sequence};
+        std::uint32_t instruction{0};
+        std::uint32_t next_slot{0};
+        std::int64_t index{0};
+        std::int64_t last{0};
+    };
+
+    /// @brief Выход, подключённый к входному порту данных.
+    struct DataSource {
+        const Node* node{nullptr};
+        PortId port;
+    };
+
+    using ExecLinks = std::unordered_map<PortId, NodeId>;
+
+    GraphInterpreter(const Graph& graph, InterpreterOptions options);
+
+    [[nodiscard]] static auto select_handler(const Node& node) -> Handler;
+    auto append_instruction(const Node& node) -> void;
+    [[nodiscard]] auto link_data() -> ExecLinks;
+    [[nodiscard]] auto link_exec(std::uint32_t index, const ExecLinks& exec_links) -> bool;
+    [[nodiscard]] auto find_entry() const -> std::uint32_t;
+
+    auto execute(bool step_over_current) -> StopReason;
+    auto continue_frame() -> void;
+    auto push_frame(Frame frame) -> void;
+    auto pop_frame() -> void;
+    auto rebuild_dispatch() -> void;
+    [[nodiscard]] auto handler_of(std::uint32_t index) const -> Handler;
+    auto unwind_to_branch() -> void;
+
+    /// @brief Публиковать путь исполнения в stack (nullptr — перестать); для GraphProfiler.
+    auto attach_profile(ExecutionStack* stack) -> void;
+
+    [[nodiscard]] auto input(const Node& node, std::string_view port) -> InterpreterValue;
+    [[nodiscard]] auto evaluate(const Node& node, PortId port) -> InterpreterValue;
+    [[nodiscard]] auto compute(const Node& node, PortId port) -> InterpreterValue;
+    auto store(const Node& node, std::string_view port, InterpreterValue value) -> void;
+
+    static auto trap(GraphInterpreter& self, std::uint32_t index) -> bool;
+    static auto profile(GraphInterpreter& self, std::uint32_t index) -> bool;
+    static auto run_jump(GraphInterpreter& self, std::uint32_t index) -> bool;
+    static auto run_end(GraphInterpreter& self, std::uint32_t index) -> bool;
+    static auto run_print(GraphInterpreter& self, std::uint32_t index) -> bool;
+    static auto run_set_variable(GraphInterpreter& self, std::uint32_t index) -> bool;
+    static auto run_branch(GraphInterpreter& self, std::uint32_t index) -> bool;
+    static auto run_sequence(GraphInterpreter& self, std::uint32_t index) -> bool;
+    static auto run_parallel(GraphInterpreter& self, std::uint32_t index) -> bool;
+    static auto run_for_loop(GraphInterpreter& self, std::uint32_t index) -> bool;
+
+    const Graph* graph_;
+    std::ostream* output_;
+
+    std::vector<Instruction> program_;
+    std::vector<Handler> dispatch_;
+    std::uint32_t entry_{NoTarget};
+    std::uint64_t compiled_revision_{0};
+    std::unordered_map<NodeId, std::uint32_t> instruction_of_;
+    std::unordered_map<PortId, DataSource> sources_;
+
+    std::unordered_map<NodeId, BreakCondition> breakpoints_;
+    std::unordered_set<ConnectionId> edge_breakpoints_;
+    bool stepping_{false};
+    bool bypass_trap_{false};
+    ExecutionStack* profile_{nullptr};
+
+    std::uint32_t pc_{NoTarget};
+    std::vector<Frame> frames_;
+    bool finished_{false};
+    bool paused_{false};
+    StopReason stop_reason_{StopReason::Finished};
+
+    std::map<std::string, InterpreterValue, std::less<>> variables_;
+    std::unordered_map<PortId, InterpreterValue> port_values_;
+    /// @brief Эпоха, в которой вычислен выход; совпадение с step_epoch_ — значение актуально
+    std::unordered_map<PortId, std::uint64_t> value_epochs_;
+    std::uint64_t step_epoch_{0};  ///< Увеличивается перед каждым обработчиком exec-узла
+};
+
+}  // namespace visprog::core
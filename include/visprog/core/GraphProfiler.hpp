@@ -0,0 +1,127 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "visprog/core/GraphInterpreter.hpp"
+
+namespace visprog::core {
+
+/// @brief Путь исполнения в терминах графа: открытые кадры (Sequence, ForLoop, ...), текущий
+/// exec-узел и вычисляемые сейчас узлы данных.
+/// @details Пишет только интерпретатор, читает обработчик сигнала профилировщика; атомики
+/// без блокировок, поэтому чтение допустимо внутри обработчика. Глубже kMaxDepth узлы
+/// не сохраняются, но глубина учитывается. running снят, пока интерпретатор не исполняет
+/// граф (до run(), после останова или завершения).
+struct ExecutionStack {
+    static constexpr std::uint32_t kMaxDepth = 32;
+
+    auto assign(std::uint32_t index, NodeId node) noexcept -> void {
+        if (index < kMaxDepth) {
+            nodes[index].store(node.value, std::memory_order_relaxed);
+        }
+        depth.store(index + 1, std::memory_order_release);
+    }
+    auto truncate(std::uint32_t new_depth) noexcept -> void {
+        depth.store(new_depth, std::memory_order_release);
+    }
+    [[nodiscard]] auto size() const noexcept -> std::uint32_t {
+        return depth.load(std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<std::uint64_t>, kMaxDepth> nodes{};
+    std::atomic<std::uint32_t> depth{0};
+    std::atomic<bool> running{false};
+};
+
+struct ProfilerOptions {
+    /// @brief Период выборки по процессорному времени; 0 — только ручные sample_now().
+    std::chrono::microseconds interval{1000};
+    std::size_t max_samples{20000};  ///< Буфер выборок; сверх него они отбрасываются
+};
+
+/// @brief Время узла: self — узел был вершиной пути, total — узел был где-либо на пути.
+struct NodeProfile {
+    NodeId node;
+    std::string name;
+    std::size_t self_samples{0};
+    std::size_t total_samples{0};
+    std::chrono::nanoseconds self_time{0};
+    std::chrono::nanoseconds total_time{0};
+};
+
+/// @brief Сэмплирующий профилировщик GraphInterpreter в терминах узлов графа.
+/// @details По таймеру процессорного времени потока интерпретатора (SIGPROF) обработчик
+/// сигнала копирует опубликованный интерпретатором путь исполнения в заранее выделенный
+/// буфер — без аллокаций и блокировок. stop() агрегирует выборки по путям. start() с таймером
+/// вызывается в потоке, который исполняет граф: считается только его время. Одновременно
+/// в процессе может работать только один профилировщик с таймером, а к интерпретатору —
+/// подключён только один профилировщик; интерпретатор должен пережить stop(). Обработчик
+/// SIGPROF, поставленный первым таймером, остаётся в процессе и после stop(). Вне Linux
+/// start() с ненулевым интервалом возвращает ошибку Unsupported.
+class GraphProfiler {
+public:
+    explicit GraphProfiler(ProfilerOptions options = {});
+    GraphProfiler(const GraphProfiler&) = delete;
+    GraphProfiler& operator=(const GraphProfiler&) = delete;
+    ~GraphProfiler();
+
+    /// @brief Подключиться к интерпретатору и запустить таймер вызывающего потока; прежние
+    /// выборки сбрасываются.
+    auto start(GraphInterpreter& interpreter) -> Result<void>;
+    /// @brief Остановить таймер, дождаться выборок в обработчике, отключиться от интерпретатора
+    /// и агрегировать выборки.
+    auto stop() -> void;
+    /// @brief Снять выборку немедленно (то же делает обработчик сигнала); вне start()/stop()
+    /// и пока интерпретатор не исполняет граф ничего не делает.
+    auto sample_now() noexcept -> void;
+
+    [[nodiscard]] auto is_running() const noexcept -> bool {
+        return interpreter_ != nullptr;
+    }
+    /// @brief Число сохранённых выборок (без отброшенных и снятых вне исполнения графа).
+    [[nodiscard]] auto sample_count() const noexcept -> std::size_t;
+    [[nodiscard]] auto dropped_samples() const noexcept -> std::size_t {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Профиль по узлам после stop(), по убыванию self-времени.
+    [[nodiscard]] auto node_profiles() const -> std::vector<NodeProfile>;
+    /// @brief Свёрнутые стеки для flamegraph.pl / speedscope: «граф;узел;узел число».
+    [[nodiscard]] auto collapsed_stacks() const -> std::string;
+
+private:
+    struct Sample {
+        std::uint32_t depth{0};
+        std::array<std::uint64_t, ExecutionStack::kMaxDepth> nodes{};
+    };
+
+    auto record_sample() noexcept -> void;
+    auto aggregate() -> void;
+
+    ProfilerOptions options_;
+    GraphInterpreter* interpreter_{nullptr};
+    bool timer_armed_{false};
+    ExecutionStack stack_;
+    std::vector<Sample> samples_;
+    std::atomic<std::size_t> capacity_{0};
+    std::atomic<std::size_t> next_sample_{0};
+    std::atomic<std::size_t> dropped_{0};
+    std::atomic<std::uint32_t> active_samples_{0};  ///< sample_now(), которые ещё не вышли
+    std::size_t recorded_{0};
+
+    std::string graph_name_;
+    std::unordered_map<std::uint64_t, std::string> names_;
+    std::map<std::vector<std::uint64_t>, std::size_t> stacks_;
+};
+
+}  // namespace visprog::core
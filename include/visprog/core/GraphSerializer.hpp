@@ -4,11 +4,39 @@
 
 #include <nlohmann/json.hpp>
 #include <string_view>
+#include <unordered_map>
 
 #include "visprog/core/Graph.hpp"
 
 namespace visprog::core {
 
+class NodeTypeRegistry;
+
+/// \brief Параметры сохранения графа.
+struct SaveOptions {
+    /// Перенумеровать узлы, порты и связи плотно (с 1) в порядке обхода графа.
+    bool compact_ids{false};
+};
+
+/// \brief Таблица соответствия «старый ID → ID в сохранённом документе».
+/// \details Пуста, если перенумерация не выполнялась; нужна внешним ссылкам на граф
+/// (source maps, привязки UI), чтобы перейти на идентификаторы из файла.
+struct IdRemap {
+    std::unordered_map<NodeId, NodeId> nodes;
+    std::unordered_map<PortId, PortId> ports;
+    std::unordered_map<ConnectionId, ConnectionId> connections;
+
+    [[nodiscard]] auto empty() const noexcept -> bool {
+        return nodes.empty() && ports.empty() && connections.empty();
+    }
+};
+
+/// \brief Результат сохранения: документ и таблица перенумерации, построенные из одного снимка.
+struct SavedDocument {
+    nlohmann::json document;
+    IdRemap remap;
+};
+
 /// \brief Сериализация и десериализация графа в JSON-формат.
 class GraphSerializer {
 public:
@@ -21,8 +49,20 @@ public:
     /// \brief Представить граф в JSON-структуре для UI и snapshot-тестов.
     [[nodiscard]] static auto to_json(const Graph& graph) -> nlohmann::json;
 
+    /// \brief Сохранить граф; с compact_ids документ и remap формируются вместе, а сам граф
+    /// не меняется — при ошибке на стороне вызывающего нечего откатывать.
+    [[nodiscard]] static auto save(const Graph& graph, const SaveOptions& options = {})
+        -> SavedDocument;
+
+    /// \brief Представить таблицу перенумерации в JSON: {"nodes": [[old, new], ...], ...}.
+    [[nodiscard]] static auto remap_to_json(const IdRemap& remap) -> nlohmann::json;
+
     /// \brief Собрать граф из JSON, выполняя строгую валидацию данных.
-    [[nodiscard]] static auto from_json(const nlohmann::json& document) -> Result<Graph>;
+    /// \param node_types Реестр проекта: типы, которых нет среди встроенных типов и их
+    /// UI-псевдонимов, ищутся в нём. Без реестра такие типы — ошибка.
+    [[nodiscard]] static auto from_json(const nlohmann::json& document,
+                                        const NodeTypeRegistry* node_types = nullptr)
+        -> Result<Graph>;
 };
 
 }  // namespace visprog::core
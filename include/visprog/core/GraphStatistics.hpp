@@ -0,0 +1,57 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "visprog/core/Types.hpp"
+
+namespace visprog::core {
+
+class Graph;
+
+/// @brief Распределение степеней узлов: histogram[d] — число узлов со степенью d.
+struct DegreeDistribution {
+    std::vector<std::size_t> histogram;
+    std::size_t max{0};
+    double mean{0.0};
+};
+
+/// @brief Сводка формы графа для выбора алгоритмов (последовательный/параллельный путь,
+/// хеш-таблицы/CSR). Считается одним линейным проходом и кешируется по Graph::revision().
+struct GraphStatistics {
+    std::uint64_t revision{0};  ///< Ревизия графа, для которой посчитана сводка
+
+    std::size_t node_count{0};
+    std::size_t exec_connection_count{0};
+    std::size_t data_connection_count{0};
+    std::map<std::string, std::size_t, std::less<>> nodes_by_type;
+
+    DegreeDistribution in_degree;
+    DegreeDistribution out_degree;
+    NodeId largest_fan_out_node{0};  ///< Узел с наибольшим числом исходящих связей
+
+    /// @brief Длина самого длинного пути (в связях) по exec/data-связям; узлы циклов не учтены.
+    std::size_t exec_depth{0};
+    std::size_t data_depth{0};
+    bool exec_has_cycle{false};
+    bool data_has_cycle{false};
+
+    /// @brief Компоненты слабой связности (направление связей не учитывается).
+    std::size_t connected_components{0};
+    std::size_t isolated_nodes{0};
+
+    [[nodiscard]] auto connection_count() const noexcept -> std::size_t {
+        return exec_connection_count + data_connection_count;
+    }
+
+    /// @brief Посчитать сводку за O(V+E); обычно вызывается через Graph::statistics().
+    [[nodiscard]] static auto compute(const Graph& graph) -> GraphStatistics;
+};
+
+}  // namespace visprog::core
@@ -116,6 +116,11 @@ public:
         return std::nullopt;
     }
 
+    /// @brief Remove a node-specific property; returns false if it was not set.
+    auto remove_property(std::string_view key) -> bool {
+        return properties_.erase(std::string(key)) > 0;
+    }
+
     /// @brief Get all properties.
     [[nodiscard]] auto get_all_properties() const noexcept
         -> const std::unordered_map<std::string, NodeProperty>& {
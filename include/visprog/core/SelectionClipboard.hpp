@@ -0,0 +1,52 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "visprog/core/Graph.hpp"
+
+/// @file SelectionClipboard.hpp
+/// @brief Компактный двоичный формат буфера обмена для выделенных узлов.
+///
+/// В блоб попадают только выделенные узлы, связи между ними и переменные, на которые ссылаются
+/// Get/SetVariable. Формат самоописывающий: типы узлов и ключи свойств хранятся по имени в
+/// таблице строк, порты — порядковым номером в раскладке типа, узлы — номером в блобе.
+///
+/// Раскладка (целые — LEB128, int64 — zigzag + LEB128, double — 8 байт little-endian):
+///   "MCSB" u8:version
+///   strings:   count, { len, bytes }
+///   variables: count, { name:str, type:u8 }
+///   nodes:     count, { type:str, instance_name:str, props:count, { key:str, tag:u8, value } }
+///   links:     count, { from_node, from_port, to_node, to_port }
+
+namespace visprog::core {
+
+/// @brief Результат вставки: новые идентификаторы в порядке записи в блобе.
+struct PasteResult {
+    std::vector<NodeId> nodes;
+    std::vector<ConnectionId> connections;
+};
+
+class SelectionClipboard {
+public:
+    inline static constexpr std::uint8_t kFormatVersion = 1;
+
+    SelectionClipboard() = delete;
+
+    /// @brief Сериализовать выделение; узлы пишутся в порядке графа, дубликаты в selection
+    /// игнорируются.
+    [[nodiscard]] static auto copy(const Graph& graph, std::span<const NodeId> selection)
+        -> Result<std::vector<std::byte>>;
+
+    /// @brief Вставить блоб в граф с новыми NodeId/PortId/ConnectionId.
+    /// @details Блоб полностью разбирается и проверяется до первой мутации графа; вставка
+    /// оформляется одной группой правок, поэтому отменяется одним undo().
+    [[nodiscard]] static auto paste(Graph& graph, std::span<const std::byte> blob)
+        -> Result<PasteResult>;
+};
+
+}  // namespace visprog::core
@@ -0,0 +1,137 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "visprog/core/Types.hpp"
+
+namespace visprog::core {
+
+/// @brief Тип сообщения в кольце транспорта.
+enum class TransportMessageKind : std::uint16_t {
+    EditCommand = 1,    ///< Хост → ядро: команда правки графа
+    GeneratedCode = 2,  ///< Ядро → хост: фрагмент сгенерированного кода
+    Diagnostics = 3,    ///< Ядро → хост: фрагмент диагностик
+};
+
+/// @brief Сообщение, прочитанное из кольца; payload указывает прямо в разделяемую память
+/// и действителен до release().
+struct TransportMessage {
+    TransportMessageKind kind{TransportMessageKind::EditCommand};
+    std::span<const std::byte> payload;
+};
+
+/// @brief Кольцо «один писатель — один читатель» в разделяемой памяти.
+/// @details Писатель получает через reserve() окно прямо в кольце и публикует его commit(),
+/// читатель видит payload без копирования через peek() и освобождает место release().
+/// Каждый процесс работает со своим экземпляром SharedRing над общим сегментом.
+class SharedRing {
+public:
+    /// @brief Окно для записи сообщения размера size; nullopt, если места сейчас нет.
+    [[nodiscard]] auto reserve(TransportMessageKind kind, std::size_t size)
+        -> std::optional<std::span<std::byte>>;
+    /// @brief Опубликовать сообщение, зарезервированное последним reserve().
+    auto commit() -> void;
+    /// @brief reserve() + копирование payload + commit(); false, если места нет.
+    [[nodiscard]] auto write(TransportMessageKind kind, std::span<const std::byte> payload)
+        -> bool;
+
+    /// @brief Первое непрочитанное сообщение без его извлечения; nullopt, если сообщений нет
+    /// или кольцо повреждено (см. corrupted()).
+    [[nodiscard]] auto peek() -> std::optional<TransportMessage>;
+    /// @brief Читатель встретил кадр с неверным размером или видом; кольцо дальше не читается.
+    [[nodiscard]] auto corrupted() const noexcept -> bool {
+        return corrupted_;
+    }
+    /// @brief Освободить сообщение, полученное последним peek().
+    auto release() -> void;
+
+    /// @brief Ждать, пока в кольце появится сообщение; false по таймауту.
+    [[nodiscard]] auto wait_readable(std::chrono::milliseconds timeout) const -> bool;
+    /// @brief Ждать, пока поместится сообщение размера size; false по таймауту.
+    [[nodiscard]] auto wait_writable(std::size_t size, std::chrono::milliseconds timeout) const
+        -> bool;
+
+    [[nodiscard]] auto capacity() const noexcept -> std::size_t {
+        return capacity_;
+    }
+    /// @brief Наибольший payload одного сообщения; длинный код отправляется фрагментами.
+    [[nodiscard]] auto max_message_size() const noexcept -> std::size_t;
+
+private:
+    friend class SharedMemoryTransport;
+    struct Header;
+
+    SharedRing() = default;
+    SharedRing(Header* header, std::byte* data, std::size_t capacity) noexcept
+        : header_(header), data_(data), capacity_(capacity) {}
+
+    [[nodiscard]] static auto header_size() noexcept -> std::size_t;
+    [[nodiscard]] auto free_space() const noexcept -> std::size_t;
+    auto notify() const -> void;
+    [[nodiscard]] auto wait_until(std::chrono::milliseconds timeout, auto&& ready) const -> bool;
+
+    Header* header_{nullptr};
+    std::byte* data_{nullptr};
+    std::size_t capacity_{0};
+    std::uint64_t pending_head_{0};
+    std::uint64_t pending_tail_{0};
+    bool corrupted_{false};
+};
+
+/// @brief Транспорт между хостом расширения и нативным процессом ядра: сегмент POSIX shm
+/// с двумя кольцами (команды правок к ядру, код и диагностики к хосту).
+/// @details Ожидание — futex на слове в сегменте (Linux), на прочих POSIX-системах — опрос
+/// с короткими паузами. Системный вызов пробуждения делается только при наличии ждущих.
+/// На платформах без POSIX shm create()/open() возвращают ошибку Unsupported.
+class SharedMemoryTransport {
+public:
+    /// @brief Создать сегмент (сторона хоста); он удаляется из пространства имён shm
+    /// при уничтожении владельца.
+    /// @param ring_capacity Ёмкость каждого кольца в байтах, округляется до степени двойки.
+    [[nodiscard]] static auto create(const std::string& name, std::size_t ring_capacity)
+        -> Result<SharedMemoryTransport>;
+    /// @brief Подключиться к существующему сегменту (сторона ядра).
+    [[nodiscard]] static auto open(const std::string& name) -> Result<SharedMemoryTransport>;
+
+    SharedMemoryTransport(const SharedMemoryTransport&) = delete;
+    SharedMemoryTransport& operator=(const SharedMemoryTransport&) = delete;
+    SharedMemoryTransport(SharedMemoryTransport&& other) noexcept;
+    SharedMemoryTransport& operator=(SharedMemoryTransport&& other) noexcept;
+    ~SharedMemoryTransport();
+
+    /// @brief Кольцо команд правок: пишет хост, читает ядро.
+    [[nodiscard]] auto to_core() noexcept -> SharedRing& {
+        return to_core_;
+    }
+    /// @brief Кольцо кода и диагностик: пишет ядро, читает хост.
+    [[nodiscard]] auto to_host() noexcept -> SharedRing& {
+        return to_host_;
+    }
+    [[nodiscard]] auto name() const noexcept -> const std::string& {
+        return name_;
+    }
+
+private:
+    SharedMemoryTransport() = default;
+
+    [[nodiscard]] static auto segment_size(std::size_t capacity) noexcept -> std::size_t;
+    auto map_rings() -> void;
+    auto close() noexcept -> void;
+
+    std::string name_;
+    void* mapping_{nullptr};
+    std::size_t mapping_size_{0};
+    int descriptor_{-1};
+    bool owner_{false};
+    SharedRing to_core_;
+    SharedRing to_host_;
+};
+
+}  // namespace visprog::core
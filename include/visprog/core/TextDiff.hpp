@@ -0,0 +1,43 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "visprog/core/Types.hpp"
+
+namespace visprog::core {
+
+/// @brief Замена диапазона строк: old_count строк старого текста начиная с old_start
+/// заменяются new_count строками text (с их переводами строк).
+/// @details Номера строк с нуля; old_start отсчитывается в старом тексте, new_start — в новом.
+struct LineEdit {
+    std::size_t old_start{0};
+    std::size_t old_count{0};
+    std::size_t new_start{0};
+    std::size_t new_count{0};
+    std::string text;
+
+    [[nodiscard]] auto operator==(const LineEdit&) const -> bool = default;
+};
+
+/// @brief Минимальный набор построчных правок, превращающий before в after.
+/// @details Алгоритм Майерса в линейной памяти (поиск «среднего змея» с разбиением пополам),
+/// перед ним отсекаются общие начало и конец — при правке одного узла графа
+/// сгенерированный код обычно отличается в нескольких соседних строках. Поиск середины
+/// ограничен max_cost шагами (0 — по размеру входа, не меньше 4096): участок, изменённый
+/// сильнее, становится одной заменой, поэтому правка всего файла не стоит O(N · D).
+[[nodiscard]] auto diff_lines(std::string_view before,
+                              std::string_view after,
+                              std::size_t max_cost = 0) -> std::vector<LineEdit>;
+
+/// @brief Применить правки diff_lines() к before; правки должны идти по возрастанию old_start
+/// и не пересекаться.
+[[nodiscard]] auto apply_line_edits(std::string_view before, std::span<const LineEdit> edits)
+    -> Result<std::string>;
+
+}  // namespace visprog::core
@@ -81,6 +81,8 @@ inline constexpr NodeType End{.name = "core.flow.end", .label = "End"};
 inline constexpr NodeType Branch{.name = "core.flow.branch", .label = "Branch"};
 inline constexpr NodeType Sequence{.name = "core.flow.sequence", .label = "Sequence"};
 inline constexpr NodeType ForLoop{.name = "core.flow.for_loop", .label = "For Loop"};
+inline constexpr NodeType ParallelSequence{.name = "core.flow.parallel_sequence",
+                                           .label = "Parallel Sequence"};
 
 // I/O
 inline constexpr NodeType PrintString{.name = "core.io.print_string", .label = "Print String"};
@@ -93,22 +95,42 @@ inline constexpr NodeType IntLiteral{.name = "core.literal.int", .label = "Int L
 // Math
 inline constexpr NodeType Add{.name = "core.math.add", .label = "Add"};
 
+// Array Math (элементы Int32, порты DataType::Vector с type_name "int32")
+inline constexpr NodeType IntArrayLiteral{.name = "core.literal.int_array",
+                                          .label = "Int Array Literal"};
+inline constexpr NodeType ArrayAdd{.name = "core.math.array_add", .label = "Array Add"};
+inline constexpr NodeType ArrayMul{.name = "core.math.array_mul", .label = "Array Multiply"};
+inline constexpr NodeType ArrayMin{.name = "core.math.array_min", .label = "Array Min"};
+inline constexpr NodeType ArrayMax{.name = "core.math.array_max", .label = "Array Max"};
+inline constexpr NodeType ArrayReduceSum{.name = "core.math.array_reduce_sum",
+                                         .label = "Array Sum"};
+inline constexpr NodeType ArrayMapScalar{.name = "core.math.array_map_scalar",
+                                         .label = "Array Map Scalar"};
+
 // Variables
 inline constexpr NodeType GetVariable{.name = "core.variable.get", .label = "Get Variable"};
 inline constexpr NodeType SetVariable{.name = "core.variable.set", .label = "Set Variable"};
 
 /// @brief Подмножество нод, которые исполняются напрямую через C++ ядро.
-inline constexpr std::array<const NodeType*, 12> CoreRuntimeNodeTypes = {
+inline constexpr std::array<const NodeType*, 20> CoreRuntimeNodeTypes = {
     &Start,
     &End,
     &Branch,
     &Sequence,
     &ForLoop,
+    &ParallelSequence,
     &PrintString,
     &StringLiteral,
     &BoolLiteral,
     &IntLiteral,
     &Add,
+    &IntArrayLiteral,
+    &ArrayAdd,
+    &ArrayMul,
+    &ArrayMin,
+    &ArrayMax,
+    &ArrayReduceSum,
+    &ArrayMapScalar,
     &GetVariable,
     &SetVariable,
 };
@@ -0,0 +1,148 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "visprog/core/Graph.hpp"
+#include "visprog/core/GraphSerializer.hpp"
+
+namespace visprog::core {
+
+/// @brief Хранилище уникальных строк; возвращаемые string_view живут столько же, сколько
+/// интернер, и не инвалидируются при добавлении новых строк.
+class StringInterner {
+public:
+    [[nodiscard]] auto intern(std::string_view text) -> std::string_view;
+    [[nodiscard]] auto find(std::string_view text) const -> std::string_view;
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return storage_.size();
+    }
+
+private:
+    std::deque<std::string> storage_;
+    std::unordered_set<std::string_view> index_;
+};
+
+/// @brief Реестр типов узлов: встроенные типы ядра и типы, зарегистрированные проектом.
+class NodeTypeRegistry {
+public:
+    explicit NodeTypeRegistry(StringInterner& strings);
+
+    /// @brief Зарегистрировать тип; повторная регистрация с тем же label возвращает прежний.
+    [[nodiscard]] auto register_type(std::string_view name, std::string_view label)
+        -> Result<const NodeType*>;
+    [[nodiscard]] auto find(std::string_view name) const -> const NodeType*;
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+        return by_name_.size();
+    }
+
+private:
+    StringInterner* strings_;
+    std::deque<NodeType> custom_types_;
+    std::unordered_map<std::string_view, const NodeType*> by_name_;
+};
+
+/// @brief Место использования символа (переменной или типа узла) в графе рабочей области.
+struct SymbolReference {
+    GraphId graph;
+    NodeId node;
+
+    [[nodiscard]] auto operator==(const SymbolReference&) const noexcept -> bool = default;
+};
+
+/// @brief Рабочая область проекта: владеет графами и общими для них реестрами.
+/// @details Перекрёстный индекс строится при добавлении графа; после правок графа его нужно
+/// обновить через reindex(). Пакетные load_files()/save_all() читают и пишут файлы
+/// параллельно; сама рабочая область не потокобезопасна.
+class Workspace {
+public:
+    Workspace();
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+    Workspace(Workspace&&) = delete;
+    Workspace& operator=(Workspace&&) = delete;
+    ~Workspace() = default;
+
+    [[nodiscard]] auto strings() noexcept -> StringInterner& {
+        return strings_;
+    }
+    [[nodiscard]] auto node_types() noexcept -> NodeTypeRegistry& {
+        return node_types_;
+    }
+    [[nodiscard]] auto node_types() const noexcept -> const NodeTypeRegistry& {
+        return node_types_;
+    }
+
+    // ========================================================================
+    // Graphs
+    // ========================================================================
+
+    /// @brief Принять граф во владение; GraphId должен быть уникален в рабочей области.
+    [[nodiscard]] auto add_graph(Graph graph) -> Result<GraphId>;
+    /// @brief Создать пустой граф со следующим свободным GraphId.
+    [[nodiscard]] auto create_graph(std::string name) -> GraphId;
+    auto remove_graph(GraphId id) -> Result<void>;
+    [[nodiscard]] auto find_graph(GraphId id) -> Graph*;
+    [[nodiscard]] auto find_graph(GraphId id) const -> const Graph*;
+    [[nodiscard]] auto graphs() const noexcept -> std::span<const std::unique_ptr<Graph>> {
+        return graphs_;
+    }
+    [[nodiscard]] auto graph_count() const noexcept -> std::size_t {
+        return graphs_.size();
+    }
+
+    // ========================================================================
+    // Cross-graph reference index
+    // ========================================================================
+
+    /// @brief Пересобрать записи индекса для одного графа после его правок.
+    auto reindex(GraphId id) -> Result<void>;
+    /// @brief Get/SetVariable-узлы всех графов, ссылающиеся на переменную name.
+    [[nodiscard]] auto variable_references(std::string_view name) const
+        -> std::span<const SymbolReference>;
+    /// @brief Узлы всех графов с типом type_name.
+    [[nodiscard]] auto type_usages(std::string_view type_name) const
+        -> std::span<const SymbolReference>;
+
+    // ========================================================================
+    // Bulk I/O
+    // ========================================================================
+
+    /// @brief Загрузить графы из JSON-файлов: чтение и разбор JSON идут параллельно,
+    /// сборка графов — последовательно. Либо добавляются все графы, либо ни одного.
+    /// @param threads Число потоков; 0 — по числу аппаратных потоков.
+    [[nodiscard]] auto load_files(std::span<const std::filesystem::path> files,
+                                  std::size_t threads = 0) -> Result<std::vector<GraphId>>;
+
+    /// @brief Сохранить все графы в directory как graph-<id>.json, параллельно по графам.
+    /// @return Пути файлов в порядке graphs().
+    [[nodiscard]] auto save_all(const std::filesystem::path& directory,
+                                const SaveOptions& options = {},
+                                std::size_t threads = 0) const
+        -> Result<std::vector<std::filesystem::path>>;
+
+private:
+    using ReferenceIndex = std::unordered_map<std::string_view, std::vector<SymbolReference>>;
+
+    auto index_graph(const Graph& graph) -> void;
+    auto unindex_graph(GraphId id) -> void;
+
+    StringInterner strings_;
+    NodeTypeRegistry node_types_;
+    std::vector<std::unique_ptr<Graph>> graphs_;
+    std::unordered_map<GraphId, Graph*> graph_lookup_;
+    ReferenceIndex variable_index_;
+    ReferenceIndex type_index_;
+};
+
+}  // namespace visprog::core
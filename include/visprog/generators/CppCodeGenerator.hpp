@@ -2,10 +2,77 @@
 
 #pragma once
 
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "visprog/core/ICodeGenerator.hpp"
 
 namespace visprog::generators {
 
+/// @brief Профиль вывода сгенерированной программы.
+enum class OutputProfile : std::uint8_t {
+    Default,     ///< std::endl после каждой строки, фиксированный набор include
+    Throughput,  ///< Буферизованный вывод, constexpr-литералы, include по использованию
+};
+
+/// @brief Специализация циклов For, границы которых известны на этапе генерации.
+struct LoopUnrollOptions {
+    bool specialize_constant_bounds{false};  ///< Включить специализацию константных циклов
+    std::int64_t full_unroll_limit{8};       ///< Полная развёртка при числе итераций <= лимита
+    std::int64_t partial_unroll_factor{4};   ///< Коэффициент частичной развёртки (<= 1 — выкл.)
+};
+
+/// @brief Режим измерительного стенда: тело графа выносится в функцию, main замеряет её вызовы.
+struct HarnessOptions {
+    bool enabled{false};
+    int warmup_iterations{3};      ///< Прогревочные запуски, не попадающие в статистику
+    int measured_iterations{100};  ///< Измеряемые запуски (argv[1] программы переопределяет)
+};
+
+/// @brief Счётчики узла, записанные при исполнении графа.
+struct NodeCounters {
+    std::uint64_t executions{0};  ///< Сколько раз исполнялся узел (для ForLoop — запусков цикла)
+    std::uint64_t taken{0};       ///< Branch: сколько раз выбрана ветвь true
+};
+
+/// @brief Профиль исполнения: узлы без записи считаются ни разу не исполненными.
+using ExecutionProfile = std::unordered_map<core::NodeId, NodeCounters>;
+
+/// @brief Пороги генерации по профилю (используются, только если профиль задан).
+struct ProfileGuidedOptions {
+    double branch_bias{0.9};                ///< Доля исполнений, с которой ветвь Branch горячая
+    std::uint64_t min_branch_samples{100};  ///< Branch с меньшим числом исполнений не размечается
+    std::uint64_t hot_loop_iterations{10000};  ///< Итераций за профиль, с которых цикл горячий
+    std::int64_t hot_full_unroll_limit{16};    ///< Лимит полной развёртки горячего цикла
+    std::int64_t hot_unroll_factor{8};         ///< Коэффициент частичной развёртки горячего цикла
+};
+
+/// @brief Настройки C++ кодогенератора.
+struct CppGeneratorOptions {
+    OutputProfile output_profile{OutputProfile::Default};
+    LoopUnrollOptions loops{};
+    bool fold_constants{false};  ///< Сворачивать константные подграфы (литералы, Add) в constexpr
+    HarnessOptions harness{};
+    ProfileGuidedOptions profile_guided{};
+};
+
+/// @brief Настройки многофайлового вывода (один исполняемый файл на граф).
+struct ProjectOptions {
+    std::string project_name{"multicode_generated"};      ///< Имя проекта в CMakeLists.txt
+    std::string prelude_header{"multicode_prelude.hpp"};  ///< Общий заголовок с include/хелперами
+    bool precompile_prelude{true};  ///< Значение по умолчанию для MULTICODE_USE_PCH
+};
+
+/// @brief Файл сгенерированного проекта; путь задаётся относительно корня проекта.
+struct GeneratedFile {
+    std::string path;
+    std::string content;
+};
+
 /**
  * @brief C++ Code Generator.
  *
@@ -13,7 +80,53 @@ namespace visprog::generators {
  */
 class CppCodeGenerator : public core::ICodeGenerator {
 public:
+    CppCodeGenerator() = default;
+    explicit CppCodeGenerator(CppGeneratorOptions options) noexcept;
+
     [[nodiscard]] auto generate(const core::Graph& graph) -> core::Result<std::string> override;
+
+    /**
+     * @brief Генерирует проект из нескольких графов с общим заголовком-прелюдией.
+     *
+     * Все include и вспомогательные функции собираются в один заголовок, который каждая единица
+     * трансляции подключает первым; CMakeLists.txt может собрать его как precompiled header.
+     * @return Прелюдия, по одному .cpp на граф и CMakeLists.txt.
+     */
+    [[nodiscard]] auto generate_project(std::span<const core::Graph* const> graphs,
+                                        const ProjectOptions& project = {})
+        -> core::Result<std::vector<GeneratedFile>>;
+
+    [[nodiscard]] auto options() const noexcept -> const CppGeneratorOptions& {
+        return options_;
+    }
+
+    /**
+     * @brief Задаёт профиль исполнения для последующих generate().
+     *
+     * По профилю ветви Branch получают [[likely]]/[[unlikely]] (горячая ветвь false
+     * генерируется первой под инвертированным условием), горячие циклы с константными
+     * границами развёртываются сильнее, холодные — не развёртываются, а сохранённый
+     * неисполнявшийся код отмечается предупреждениями. Семантика программы не меняется.
+     * Порядок ветвей Sequence профиль не трогает: then-N исполняются строго по порядку,
+     * и их перестановка изменила бы программу. Пустой профиль выключает генерацию по профилю.
+     */
+    auto set_profile(ExecutionProfile profile) -> void {
+        profile_ = std::move(profile);
+    }
+
+    [[nodiscard]] auto profile() const noexcept -> const ExecutionProfile& {
+        return profile_;
+    }
+
+    /// @brief Предупреждения последнего вызова generate() (например, гонки в Parallel Sequence).
+    [[nodiscard]] auto warnings() const noexcept -> std::span<const core::Error> {
+        return warnings_;
+    }
+
+private:
+    CppGeneratorOptions options_{};
+    ExecutionProfile profile_;
+    std::vector<core::Error> warnings_;
 };
 
 }  // namespace visprog::generators
@@ -0,0 +1,453 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include "visprog/core/CostModel.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "visprog/core/FormatCompat.hpp"
+#include "visprog/core/Port.hpp"
+
+namespace visprog::core {
+
+namespace {
+
+using compat::format;
+
+// Ограничение глубины рекурсии по потоку исполнения/данных (как в кодогенераторе).
+constexpr int kMaxDepth = 200;
+
+// Вес одного выполнения узла в условных «простых операциях».
+constexpr double kCheapWeight = 1.0;
+constexpr double kBranchWeight = 2.0;
+constexpr double kStringCopyWeight = 20.0;
+constexpr double kPrintWeight = 50.0;
+constexpr double kArrayBaseWeight = 4.0;
+constexpr double kThreadSpawnWeight = 10'000.0;
+
+// Узлы, стоимость которых заметна даже при небольшом числе итераций.
+constexpr double kExpensiveWeight = kStringCopyWeight;
+
+[[nodiscard]] auto is_literal(std::string_view type_name) noexcept -> bool {
+    return type_name == NodeTypes::IntLiteral.name || type_name == NodeTypes::BoolLiteral.name ||
+           type_name == NodeTypes::StringLiteral.name ||
+           type_name == NodeTypes::IntArrayLiteral.name;
+}
+
+[[nodiscard]] auto is_array_operation(std::string_view type_name) noexcept -> bool {
+    return type_name == NodeTypes::ArrayAdd.name || type_name == NodeTypes::ArrayMul.name ||
+           type_name == NodeTypes::ArrayMin.name || type_name == NodeTypes::ArrayMax.name ||
+           type_name == NodeTypes::ArrayMapScalar.name ||
+           type_name == NodeTypes::ArrayReduceSum.name;
+}
+
+[[nodiscard]] auto find_port(const Node& node, std::string_view name) -> const Port* {
+    for (const auto& port : node.get_ports()) {
+        if (port.get_name() == name) {
+            return &port;
+        }
+    }
+    return nullptr;
+}
+
+/// @brief Оценка за два линейных прохода: число выполнений по потоку исполнения от Start
+/// в топологическом порядке, затем входы данных каждого исполненного узла.
+class CostEstimator {
+public:
+    CostEstimator(const Graph& graph, const CostModelOptions& options)
+        : graph_(graph), options_(options) {
+        for (const auto& connection : graph_.get_connections()) {
+            sources_by_port_.emplace(connection.to_port, connection.from_node);
+            targets_by_port_.emplace(connection.from_port, connection.to_node);
+        }
+    }
+
+    auto run() -> CostEstimate {
+        CostEstimate estimate;
+        estimate.annotations.reserve(graph_.node_count());
+        for (const auto& node : graph_.get_nodes()) {
+            index_.emplace(node->get_id(), estimate.annotations.size());
+            auto& annotation = estimate.annotations.emplace_back();
+            annotation.node = node->get_id();
+            annotation.cost_weight = base_weight(*node);
+        }
+        annotations_ = &estimate.annotations;
+
+        count_executions();
+
+        for (auto& annotation : estimate.annotations) {
+            annotation.total_cost = annotation.execution_count * annotation.cost_weight;
+            estimate.total_cost += annotation.total_cost;
+            classify(annotation);
+        }
+        return estimate;
+    }
+
+private:
+    /// @brief Exec-связь с множителем повторений и приращением вложенности циклов.
+    struct ExecEdge {
+        const Node* target{nullptr};
+        double factor{1.0};
+        int depth_increment{0};
+        bool back{false};  ///< Замыкает exec-цикл — при подсчёте не учитывается
+    };
+
+    // Вход/выход: execution_count и loop_depth всех узлов, достижимых от Start по exec-связям.
+    // Edge cases: связь в узел, который ещё на стеке обхода (exec-цикл), отбрасывается; узлы,
+    // до которых доходит только нулевой множитель (цикл без итераций), не считаются.
+    // Почему так: узел, достижимый несколькими путями (после Branch), выполняется суммарно
+    // столько раз, сколько приходит по всем путям. В обратном постпорядке DFS все входящие
+    // связи узла обработаны до него, поэтому множители складываются за один проход, а не
+    // перебором путей, число которых растёт экспоненциально.
+    void count_executions() {
+        std::vector<std::vector<ExecEdge>> successors(annotations_->size());
+        std::vector<std::uint8_t> state(annotations_->size(), 0);  // 0 — новый, 1 — на стеке
+        std::vector<const Node*> postorder;
+        std::vector<std::pair<const Node*, std::size_t>> stack;
+
+        for (const auto& root : graph_.get_nodes()) {
+            if (root->get_type().name != NodeTypes::Start.name) {
+                continue;
+            }
+            annotation_for(root->get_id()).execution_count += 1.0;
+            if (state[index_.at(root->get_id())] != 0) {
+                continue;
+            }
+            state[index_.at(root->get_id())] = 1;
+            successors[index_.at(root->get_id())] = exec_successors(*root);
+            stack.emplace_back(root.get(), 0);
+            while (!stack.empty()) {
+                auto& [node, next] = stack.back();
+                auto& edges = successors[index_.at(node->get_id())];
+                if (next == edges.size()) {
+                    state[index_.at(node->get_id())] = 2;
+                    postorder.push_back(node);
+                    stack.pop_back();
+                    continue;
+                }
+                auto& edge = edges[next++];
+                const auto target = index_.at(edge.target->get_id());
+                if (state[target] == 1) {
+                    edge.back = true;
+                } else if (state[target] == 0) {
+                    state[target] = 1;
+                    successors[target] = exec_successors(*edge.target);
+                    stack.emplace_back(edge.target, 0);
+                }
+            }
+        }
+
+        for (auto it = postorder.rbegin(); it != postorder.rend(); ++it) {
+            const auto& node = **it;
+            const auto& annotation = annotation_for(node.get_id());
+            const auto multiplier = annotation.execution_count;
+            if (multiplier <= 0.0) {
+                continue;
+            }
+
+            data_seen_.clear();
+            visit_data_inputs(node, multiplier, annotation.loop_depth, 0);
+            if (node.get_type().name == NodeTypes::ForLoop.name) {
+                outer_iterations_[node.get_id()] = multiplier * trip_counts_[node.get_id()];
+            }
+            for (const auto& edge : successors[index_.at(node.get_id())]) {
+                const auto arrived = multiplier * edge.factor;
+                if (edge.back || arrived <= 0.0) {
+                    continue;
+                }
+                auto& target = annotation_for(edge.target->get_id());
+                target.execution_count += arrived;
+                target.loop_depth =
+                    std::max(target.loop_depth, annotation.loop_depth + edge.depth_increment);
+            }
+        }
+    }
+
+    auto exec_successors(const Node& node) -> std::vector<ExecEdge> {
+        std::vector<ExecEdge> edges;
+        const auto add_edge = [&](const Port* port, double factor, int depth_increment) {
+            const auto* target = port != nullptr ? connected_node(*port) : nullptr;
+            if (target != nullptr) {
+                edges.push_back(ExecEdge{target, factor, depth_increment});
+            }
+        };
+
+        const auto type_name = node.get_type().name;
+        if (type_name == NodeTypes::ForLoop.name) {
+            const auto trips = trip_count(node);
+            trip_counts_[node.get_id()] = trips;
+            add_edge(find_port(node, "loop-body"), trips, 1);
+            add_edge(find_port(node, "completed"), 1.0, 0);
+            return edges;
+        }
+        const auto factor =
+            type_name == NodeTypes::Branch.name ? options_.branch_probability : 1.0;
+        for (const auto* port : node.get_exec_output_ports()) {
+            add_edge(port, factor, 0);
+        }
+        return edges;
+    }
+
+    // Чистые узлы данных вычисляются при каждом выполнении потребителя; литералы генератор
+    // выносит в преамбулу, поэтому они выполняются один раз. Узел данных, на который
+    // несколько раз ссылается одно exec-выполнение, считается один раз (data_seen_).
+    void visit_data_inputs(const Node& node, double multiplier, int loop_depth, int depth) {
+        if (depth > kMaxDepth) {
+            return;
+        }
+        for (const auto* port : node.get_input_ports()) {
+            if (port->get_data_type() == DataType::Execution) {
+                continue;
+            }
+            const auto* source = connected_node(*port);
+            if (source == nullptr || source->has_execution_flow() ||
+                !data_seen_.insert(source->get_id()).second) {
+                continue;
+            }
+
+            auto& annotation = annotation_for(source->get_id());
+            annotation.loop_depth = std::max(annotation.loop_depth, loop_depth);
+            if (is_literal(source->get_type().name)) {
+                annotation.execution_count = 1.0;
+                continue;
+            }
+            annotation.execution_count += multiplier;
+            visit_data_inputs(*source, multiplier, loop_depth, depth + 1);
+        }
+    }
+
+    void classify(NodeCostAnnotation& annotation) const {
+        const auto* node = graph_.get_node(annotation.node);
+        if (node == nullptr || annotation.execution_count <= 0.0) {
+            return;
+        }
+        const auto type_name = node->get_type().name;
+
+        if (type_name == NodeTypes::ForLoop.name) {
+            const auto trips = lookup(trip_counts_, annotation.node);
+            const auto iterations = lookup(outer_iterations_, annotation.node);
+            if (annotation.loop_depth > 0 && iterations >= options_.large_loop_trip_count) {
+                annotation.hot_spot = HotSpotKind::NestedLoop;
+                annotation.note = format("Nested loop runs about ", iterations,
+                                         " body iterations in total");
+            } else if (trips >= options_.large_loop_trip_count) {
+                annotation.hot_spot = HotSpotKind::LargeLoop;
+                annotation.note = format("Loop runs about ", trips, " iterations");
+            }
+            return;
+        }
+
+        if (annotation.loop_depth == 0) {
+            return;
+        }
+        if (type_name == NodeTypes::SetVariable.name && copies_string(*node)) {
+            annotation.hot_spot = HotSpotKind::StringInLoop;
+            annotation.note = format("String is copied about ", annotation.execution_count,
+                                     " times inside a loop");
+        } else if (annotation.cost_weight >= kExpensiveWeight &&
+                   annotation.total_cost >= options_.expensive_cost_threshold) {
+            annotation.hot_spot = HotSpotKind::ExpensiveInLoop;
+            annotation.note = format("Expensive node runs about ", annotation.execution_count,
+                                     " times inside a loop");
+        }
+    }
+
+    [[nodiscard]] auto base_weight(const Node& node) const -> double {
+        const auto type_name = node.get_type().name;
+        if (type_name == NodeTypes::PrintString.name) {
+            return kPrintWeight;
+        }
+        if (type_name == NodeTypes::Branch.name) {
+            return kBranchWeight;
+        }
+        if (type_name == NodeTypes::ParallelSequence.name) {
+            return kThreadSpawnWeight;
+        }
+        if (type_name == NodeTypes::SetVariable.name && copies_string(node)) {
+            return kStringCopyWeight;
+        }
+        if (is_array_operation(type_name)) {
+            return kArrayBaseWeight + array_length(node, 0);
+        }
+        return kCheapWeight;
+    }
+
+    [[nodiscard]] auto copies_string(const Node& node) const -> bool {
+        const auto name = node.get_property<std::string>("variable_name");
+        const auto* variable = name ? graph_.get_variable(*name) : nullptr;
+        return variable != nullptr &&
+               (variable->type == DataType::String || variable->type == DataType::Any);
+    }
+
+    // Оценка длины массива, который обрабатывает узел: длина литерала или минимум операндов.
+    [[nodiscard]] auto array_length(const Node& node, int depth) const -> double {
+        if (node.get_type().name == NodeTypes::IntArrayLiteral.name) {
+            const auto text = node.get_property<std::string>("values").value_or("");
+            return text.empty() ? 0.0
+                                : static_cast<double>(std::ranges::count(text, ',') + 1);
+        }
+        if (depth > kMaxDepth) {
+            return options_.unknown_trip_count;
+        }
+        if (const auto cached = array_lengths_.find(node.get_id());
+            cached != array_lengths_.end()) {
+            return cached->second;
+        }
+
+        std::optional<double> length;
+        for (const auto* port : node.get_input_ports()) {
+            if (port->get_data_type() != DataType::Vector) {
+                continue;
+            }
+            const auto* source = connected_node(*port);
+            const auto source_length =
+                source != nullptr ? array_length(*source, depth + 1) : 0.0;
+            length = length ? std::min(*length, source_length) : source_length;
+        }
+        return array_lengths_.emplace(node.get_id(), length.value_or(options_.unknown_trip_count))
+            .first->second;
+    }
+
+    [[nodiscard]] auto trip_count(const Node& loop) const -> double {
+        const auto first = constant_input(loop, "first", 0);
+        const auto last = constant_input(loop, "last", 0);
+        if (!first || !last) {
+            return options_.unknown_trip_count;
+        }
+        return *last > *first ? static_cast<double>(*last) - static_cast<double>(*first) : 0.0;
+    }
+
+    // Значение Int-входа, известное статически (IntLiteral или Add над константами).
+    // Как и свёртка констант в генераторе, значения вне диапазона int (в т.ч. переполнение
+    // при сложении) константами не считаются — цикл с такой границей оценивается как неизвестный.
+    [[nodiscard]] auto constant_input(const Node& node, std::string_view port_name, int depth) const
+        -> std::optional<std::int64_t> {
+        const auto* port = find_port(node, port_name);
+        if (port == nullptr || depth > kMaxDepth) {
+            return std::nullopt;
+        }
+        const auto* source = connected_node(*port);
+        if (source == nullptr) {
+            return std::int64_t{0};
+        }
+        if (const auto cached = constants_.find(source->get_id()); cached != constants_.end()) {
+            return cached->second;
+        }
+
+        std::optional<std::int64_t> value;
+        const auto type_name = source->get_type().name;
+        if (type_name == NodeTypes::IntLiteral.name) {
+            value = source->get_property<std::int64_t>("value").value_or(0);
+        } else if (type_name == NodeTypes::Add.name) {
+            const auto lhs = constant_input(*source, "a", depth + 1);
+            const auto rhs = lhs ? constant_input(*source, "b", depth + 1) : std::nullopt;
+            if (lhs && rhs) {
+                value = *lhs + *rhs;
+            }
+        }
+        if (value && (*value < std::numeric_limits<int>::min() ||
+                      *value > std::numeric_limits<int>::max())) {
+            value.reset();
+        }
+        // Общие операнды (Add, читающий один выход дважды) вычисляются один раз
+        return constants_.emplace(source->get_id(), value).first->second;
+    }
+
+    [[nodiscard]] auto connected_node(const Port& port) const -> const Node* {
+        const auto& endpoints =
+            port.get_direction() == PortDirection::Input ? sources_by_port_ : targets_by_port_;
+        const auto it = endpoints.find(port.get_id());
+        return it != endpoints.end() ? graph_.get_node(it->second) : nullptr;
+    }
+
+    [[nodiscard]] static auto lookup(const std::unordered_map<NodeId, double>& values, NodeId id)
+        -> double {
+        const auto it = values.find(id);
+        return it != values.end() ? it->second : 0.0;
+    }
+
+    auto annotation_for(NodeId id) -> NodeCostAnnotation& {
+        return (*annotations_)[index_.at(id)];
+    }
+
+    const Graph& graph_;
+    const CostModelOptions& options_;
+    std::vector<NodeCostAnnotation>* annotations_{nullptr};
+    std::unordered_map<NodeId, std::size_t> index_;
+    std::unordered_map<PortId, NodeId> sources_by_port_;
+    std::unordered_map<PortId, NodeId> targets_by_port_;
+    std::unordered_set<NodeId> data_seen_;  ///< Узлы данных, учтённые для текущего exec-узла
+    std::unordered_map<NodeId, double> trip_counts_;
+    std::unordered_map<NodeId, double> outer_iterations_;
+    mutable std::unordered_map<NodeId, std::optional<std::int64_t>> constants_;
+    mutable std::unordered_map<NodeId, double> array_lengths_;
+};
+
+}  // namespace
+
+auto CostEstimate::find(NodeId id) const noexcept -> const NodeCostAnnotation* {
+    const auto it = std::ranges::find(annotations, id, &NodeCostAnnotation::node);
+    return it != annotations.end() ? &*it : nullptr;
+}
+
+auto CostEstimate::hot_spots() const -> std::vector<const NodeCostAnnotation*> {
+    std::vector<const NodeCostAnnotation*> result;
+    for (const auto& annotation : annotations) {
+        if (annotation.hot_spot != HotSpotKind::None) {
+            result.push_back(&annotation);
+        }
+    }
+    std::ranges::sort(result, [](const auto* lhs, const auto* rhs) {
+        return lhs->total_cost > rhs->total_cost;
+    });
+    return result;
+}
+
+auto CostModel::estimate(const Graph& graph, const CostModelOptions& options) -> CostEstimate {
+    CostEstimator estimator(graph, options);
+    return estimator.run();
+}
+
+auto CostModel::hot_spot_name(HotSpotKind kind) noexcept -> std::string_view {
+    switch (kind) {
+        case HotSpotKind::None:
+            return "none";
+        case HotSpotKind::LargeLoop:
+            return "large_loop";
+        case HotSpotKind::NestedLoop:
+            return "nested_loop";
+        case HotSpotKind::ExpensiveInLoop:
+            return "expensive_in_loop";
+        case HotSpotKind::StringInLoop:
+            return "string_in_loop";
+    }
+    return "none";
+}
+
+auto CostModel::to_json(const CostEstimate& estimate) -> nlohmann::json {
+    nlohmann::json nodes_json = nlohmann::json::array();
+    for (const auto& annotation : estimate.annotations) {
+        nlohmann::json node_json;
+        node_json["id"] = annotation.node.value;
+        node_json["executionCount"] = annotation.execution_count;
+        node_json["costWeight"] = annotation.cost_weight;
+        node_json["totalCost"] = annotation.total_cost;
+        node_json["loopDepth"] = annotation.loop_depth;
+        if (annotation.hot_spot != HotSpotKind::None) {
+            node_json["hotSpot"] = hot_spot_name(annotation.hot_spot);
+            node_json["note"] = annotation.note;
+        }
+        nodes_json.push_back(std::move(node_json));
+    }
+    return nlohmann::json{{"totalCost", estimate.total_cost}, {"nodes", std::move(nodes_json)}};
+}
+
+}  // namespace visprog::core
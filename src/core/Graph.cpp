@@ -3,10 +3,14 @@
 #include "visprog/core/Graph.hpp"
 
 #include <algorithm>
+#include <cstddef>
 #include <queue>
 #include <ranges>
 #include <stack>
+#include <tuple>
+#include <type_traits>
 #include <unordered_set>
+#include <variant>
 
 #include "visprog/core/ErrorCodes.hpp"
 #include "visprog/core/FormatCompat.hpp"
@@ -32,6 +36,7 @@ auto Graph::add_variable(std::string name, DataType type) -> Result<void> {
         return Result<void>(Error{.message = format("Variable '", name, "' already exists.")});
     }
 
+    record(VariableAddedEdit{.name = name, .type = type});
     variables_.push_back(Variable{std::move(name), type});
     return Result<void>();
 }
@@ -102,12 +107,8 @@ auto Graph::add_node(std::unique_ptr<Node> node) -> NodeId {
         return NodeId{0};
     }
 
-    node_lookup_[node_id] = node.get();
-    nodes_.push_back(std::move(node));
-
-    adjacency_out_[node_id] = {};
-    adjacency_in_[node_id] = {};
-
+    attach_node(std::move(node), nodes_.size());
+    record(NodeAddedEdit{.node = node_id, .position = nodes_.size() - 1, .detached = nullptr});
     return node_id;
 }
 
@@ -116,16 +117,20 @@ auto Graph::remove_node(NodeId id) -> Result<void> {
         return result;
     }
 
-    remove_node_connections(id);
-    node_lookup_.erase(id);
-    adjacency_out_.erase(id);
-    adjacency_in_.erase(id);
-
-    auto it = std::ranges::find_if(nodes_, [id](const auto& node) { return node->get_id() == id; });
-    if (it != nodes_.end()) {
-        nodes_.erase(it);
+    NodeRemovedEdit edit{.node = id, .position = 0, .detached = nullptr, .connections = {}};
+    for (const auto connection_id : outgoing(id)) {
+        edit.connections.push_back(connections_[connection_lookup_.at(connection_id)]);
     }
+    for (const auto connection_id : incoming(id)) {
+        edit.connections.push_back(connections_[connection_lookup_.at(connection_id)]);
+    }
+
+    ++history_.suspended_;
+    remove_node_connections(id);
+    --history_.suspended_;
 
+    std::tie(edit.detached, edit.position) = detach_node(id);
+    record(std::move(edit));
     return Result<void>();
 }
 
@@ -175,14 +180,9 @@ auto Graph::connect(NodeId from_node, PortId from_port, NodeId to_node, PortId t
                     .to_node = to_node,
                     .to_port = to_port,
                     .type = conn_type};
+    insert_connection(conn);
 
-    const auto index = connections_.size();
-    connections_.push_back(conn);
-    connection_lookup_[conn_id] = index;
-
-    adjacency_out_[from_node].push_back(conn_id);
-    adjacency_in_[to_node].push_back(conn_id);
-
+    record(ConnectionAddedEdit{conn});
     return Result<ConnectionId>(conn_id);
 }
 
@@ -209,7 +209,11 @@ auto Graph::disconnect(ConnectionId id) -> Result<void> {
         connection_lookup_[connections_[index].id] = index;
     }
     connections_.pop_back();
+    ++revision_;
+    // Разрыв связи может разделить компоненту; union-find не умеет разъединять
+    components_dirty_ = true;
 
+    record(ConnectionRemovedEdit{conn});
     return Result<void>();
 }
 
@@ -238,6 +242,20 @@ auto Graph::get_connections_to(NodeId node) const -> std::vector<ConnectionId> {
     return {};
 }
 
+auto Graph::outgoing(NodeId node) const -> std::span<const ConnectionId> {
+    if (auto it = adjacency_out_.find(node); it != adjacency_out_.end()) {
+        return it->second;
+    }
+    return {};
+}
+
+auto Graph::incoming(NodeId node) const -> std::span<const ConnectionId> {
+    if (auto it = adjacency_in_.find(node); it != adjacency_in_.end()) {
+        return it->second;
+    }
+    return {};
+}
+
 auto Graph::has_connection(ConnectionId id) const noexcept -> bool {
     return connection_lookup_.contains(id);
 }
@@ -376,6 +394,7 @@ auto Graph::get_id() const noexcept -> GraphId {
 }
 
 void Graph::set_name(std::string name) {
+    record(GraphRenamedEdit{.before = name_, .after = name});
     name_ = std::move(name);
 }
 
@@ -391,6 +410,56 @@ auto Graph::empty() const noexcept -> bool {
     return nodes_.empty();
 }
 
+auto Graph::revision() const noexcept -> std::uint64_t {
+    return revision_;
+}
+
+auto Graph::property_revision() const noexcept -> std::uint64_t {
+    return property_revision_;
+}
+
+auto Graph::component_of(NodeId node) const -> NodeId {
+    if (!has_node(node)) {
+        return NodeId{0};
+    }
+    rebuild_components();
+    return find_component(node);
+}
+
+auto Graph::same_component(NodeId lhs, NodeId rhs) const -> bool {
+    const auto lhs_root = component_of(lhs);
+    return lhs_root != NodeId{0} && lhs_root == component_of(rhs);
+}
+
+auto Graph::component_count() const -> std::size_t {
+    rebuild_components();
+    return component_count_;
+}
+
+auto Graph::components() const -> std::vector<std::vector<NodeId>> {
+    rebuild_components();
+    std::vector<std::vector<NodeId>> groups;
+    groups.reserve(component_count_);
+    std::unordered_map<NodeId, std::size_t> group_of_root;
+    group_of_root.reserve(component_count_);
+    for (const auto& node : nodes_) {
+        const auto root = find_component(node->get_id());
+        const auto [it, inserted] = group_of_root.try_emplace(root, groups.size());
+        if (inserted) {
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(node->get_id());
+    }
+    return groups;
+}
+
+auto Graph::statistics() const -> const GraphStatistics& {
+    if (!statistics_ || statistics_->revision != revision_) {
+        statistics_ = GraphStatistics::compute(*this);
+    }
+    return *statistics_;
+}
+
 auto Graph::validate_node_exists(NodeId id) const -> Result<void> {
     if (!has_node(id)) {
         return Result<void>(
@@ -470,4 +539,404 @@ auto Graph::remove_node_connections(NodeId node) -> void {
     }
 }
 
+// ============================================================================
+// Undo / Redo
+// ============================================================================
+
+auto Graph::set_node_property(NodeId node, const std::string& key, NodeProperty value)
+    -> Result<void> {
+    auto* target = get_node_mut(node);
+    if (target == nullptr) {
+        return Result<void>(
+            Error{"Node does not exist", error_codes::graph_connection::NodeNotFound});
+    }
+
+    PropertyChangedEdit edit{.node = node, .key = key, .before = std::nullopt, .after = value};
+    if (const auto it = target->get_all_properties().find(key);
+        it != target->get_all_properties().end()) {
+        edit.before = it->second;
+    }
+    target->set_property(key, std::move(value));
+    ++property_revision_;
+    record(std::move(edit));
+    return Result<void>();
+}
+
+// Вход/выход: выставляет key = value всем nodes; в журнал идёт одна PropertyBatchEdit.
+// Edge cases: несуществующий узел — ошибка до любых изменений; повтор NodeId допустим,
+// отмена в обратном порядке всё равно восстанавливает исходное значение.
+// Почему так: N отдельных set_node_property дали бы N шагов истории и N увеличений
+// property_revision(), и каждый подписчик пересчитывался бы на каждый узел пачки.
+auto Graph::set_property_batch(std::span<const NodeId> nodes,
+                               const std::string& key,
+                               const NodeProperty& value) -> Result<void> {
+    std::vector<Node*> targets;
+    targets.reserve(nodes.size());
+    for (const auto id : nodes) {
+        auto* target = get_node_mut(id);
+        if (target == nullptr) {
+            return Result<void>(Error{format("Node ", id.value, " does not exist"),
+                                      error_codes::graph_connection::NodeNotFound});
+        }
+        targets.push_back(target);
+    }
+
+    PropertyBatchEdit edit{
+        .key = key, .after = value, .nodes = {nodes.begin(), nodes.end()}, .before = {}};
+    edit.before.reserve(targets.size());
+    for (auto* target : targets) {
+        const auto& properties = target->get_all_properties();
+        const auto it = properties.find(key);
+        edit.before.push_back(it != properties.end() ? std::optional{it->second} : std::nullopt);
+        target->set_property(key, value);
+    }
+    ++property_revision_;
+    record(std::move(edit));
+    return Result<void>();
+}
+
+// Вход/выход: переносит верхний шаг из undo в redo, применяя обратные правки в обратном порядке.
+// Edge cases: при ошибке (история расходится с графом) шаг отбрасывается, а redo очищается —
+// частично применённый шаг нельзя безопасно повторить.
+// Почему так: обратная правка не записывается в журнал (suspended_), поэтому undo не порождает
+// новых шагов и не сбрасывает стек redo.
+auto Graph::undo() -> Result<void> {
+    if (history_.undo_.empty()) {
+        return Result<void>(
+            Error{"Nothing to undo", error_codes::graph_history::NothingToUndo});
+    }
+
+    auto step = std::move(history_.undo_.back());
+    history_.undo_.pop_back();
+
+    ++history_.suspended_;
+    for (auto it = step.edits.rbegin(); it != step.edits.rend(); ++it) {
+        if (auto result = revert_edit(*it); !result) {
+            --history_.suspended_;
+            history_.redo_.clear();
+            return result;
+        }
+    }
+    --history_.suspended_;
+
+    history_.redo_.push_back(std::move(step));
+    return Result<void>();
+}
+
+auto Graph::redo() -> Result<void> {
+    if (history_.redo_.empty()) {
+        return Result<void>(
+            Error{"Nothing to redo", error_codes::graph_history::NothingToRedo});
+    }
+
+    auto step = std::move(history_.redo_.back());
+    history_.redo_.pop_back();
+
+    ++history_.suspended_;
+    for (auto& edit : step.edits) {
+        if (auto result = reapply_edit(edit); !result) {
+            --history_.suspended_;
+            history_.redo_.clear();
+            return result;
+        }
+    }
+    --history_.suspended_;
+
+    history_.undo_.push_back(std::move(step));
+    return Result<void>();
+}
+
+void Graph::begin_edit_group() {
+    if (history_.group_depth_++ == 0) {
+        history_.open_group_.emplace();
+    }
+}
+
+void Graph::end_edit_group() {
+    if (history_.group_depth_ == 0 || --history_.group_depth_ > 0) {
+        return;
+    }
+
+    auto group = std::move(*history_.open_group_);
+    history_.open_group_.reset();
+    if (group.edits.empty()) {
+        return;
+    }
+    history_.undo_.push_back(std::move(group));
+    while (history_.undo_.size() > history_.limit_) {
+        history_.undo_.pop_front();
+    }
+}
+
+void Graph::set_history_limit(std::size_t limit) {
+    history_.limit_ = limit;
+    while (history_.undo_.size() > history_.limit_) {
+        history_.undo_.pop_front();
+    }
+}
+
+void Graph::clear_history() {
+    history_.undo_.clear();
+    history_.redo_.clear();
+    if (history_.open_group_) {
+        history_.open_group_->edits.clear();
+    }
+}
+
+auto Graph::history() const noexcept -> const GraphHistory& {
+    return history_;
+}
+
+auto Graph::record(GraphEdit edit) -> void {
+    if (history_.suspended_ > 0) {
+        return;
+    }
+
+    history_.redo_.clear();
+    if (history_.open_group_) {
+        history_.open_group_->edits.push_back(std::move(edit));
+        return;
+    }
+
+    EditStep step;
+    step.edits.push_back(std::move(edit));
+    history_.undo_.push_back(std::move(step));
+    while (history_.undo_.size() > history_.limit_) {
+        history_.undo_.pop_front();
+    }
+}
+
+auto Graph::revert_edit(GraphEdit& edit) -> Result<void> {
+    const auto inconsistent = [](std::string_view what) {
+        return Result<void>(Error{format("Undo history is inconsistent: ", what),
+                                  error_codes::graph_history::InconsistentHistory});
+    };
+
+    return std::visit(
+        [&](auto& change) -> Result<void> {
+            using Change = std::decay_t<decltype(change)>;
+            if constexpr (std::is_same_v<Change, NodeAddedEdit>) {
+                if (!outgoing(change.node).empty() || !incoming(change.node).empty()) {
+                    return inconsistent("added node still has connections");
+                }
+                auto [node, position] = detach_node(change.node);
+                if (!node) {
+                    return inconsistent("added node is missing");
+                }
+                change.detached = std::move(node);
+                change.position = position;
+            } else if constexpr (std::is_same_v<Change, NodeRemovedEdit>) {
+                if (!change.detached) {
+                    return inconsistent("removed node was not captured");
+                }
+                attach_node(std::move(change.detached), change.position);
+                for (const auto& connection : change.connections) {
+                    insert_connection(connection);
+                }
+            } else if constexpr (std::is_same_v<Change, ConnectionAddedEdit>) {
+                return disconnect(change.connection.id);
+            } else if constexpr (std::is_same_v<Change, ConnectionRemovedEdit>) {
+                insert_connection(change.connection);
+            } else if constexpr (std::is_same_v<Change, PropertyChangedEdit>) {
+                auto* node = get_node_mut(change.node);
+                if (node == nullptr) {
+                    return inconsistent("property owner is missing");
+                }
+                if (change.before) {
+                    node->set_property(change.key, *change.before);
+                } else {
+                    node->remove_property(change.key);
+                }
+                ++property_revision_;
+            } else if constexpr (std::is_same_v<Change, PropertyBatchEdit>) {
+                for (auto i = change.nodes.size(); i-- > 0;) {
+                    auto* node = get_node_mut(change.nodes[i]);
+                    if (node == nullptr) {
+                        return inconsistent("property owner is missing");
+                    }
+                    if (change.before[i]) {
+                        node->set_property(change.key, *change.before[i]);
+                    } else {
+                        node->remove_property(change.key);
+                    }
+                }
+                ++property_revision_;
+            } else if constexpr (std::is_same_v<Change, VariableAddedEdit>) {
+                std::erase_if(variables_,
+                              [&](const Variable& var) { return var.name == change.name; });
+            } else if constexpr (std::is_same_v<Change, GraphRenamedEdit>) {
+                name_ = change.before;
+            }
+            return Result<void>();
+        },
+        edit);
+}
+
+auto Graph::reapply_edit(GraphEdit& edit) -> Result<void> {
+    const auto inconsistent = [](std::string_view what) {
+        return Result<void>(Error{format("Redo history is inconsistent: ", what),
+                                  error_codes::graph_history::InconsistentHistory});
+    };
+
+    return std::visit(
+        [&](auto& change) -> Result<void> {
+            using Change = std::decay_t<decltype(change)>;
+            if constexpr (std::is_same_v<Change, NodeAddedEdit>) {
+                if (!change.detached) {
+                    return inconsistent("added node was not captured");
+                }
+                attach_node(std::move(change.detached), change.position);
+            } else if constexpr (std::is_same_v<Change, NodeRemovedEdit>) {
+                for (const auto& connection : change.connections) {
+                    if (has_connection(connection.id)) {
+                        [[maybe_unused]] auto result = disconnect(connection.id);
+                    }
+                }
+                auto [node, position] = detach_node(change.node);
+                if (!node) {
+                    return inconsistent("removed node is missing");
+                }
+                change.detached = std::move(node);
+                change.position = position;
+            } else if constexpr (std::is_same_v<Change, ConnectionAddedEdit>) {
+                insert_connection(change.connection);
+            } else if constexpr (std::is_same_v<Change, ConnectionRemovedEdit>) {
+                return disconnect(change.connection.id);
+            } else if constexpr (std::is_same_v<Change, PropertyChangedEdit>) {
+                auto* node = get_node_mut(change.node);
+                if (node == nullptr) {
+                    return inconsistent("property owner is missing");
+                }
+                if (change.after) {
+                    node->set_property(change.key, *change.after);
+                } else {
+                    node->remove_property(change.key);
+                }
+                ++property_revision_;
+            } else if constexpr (std::is_same_v<Change, PropertyBatchEdit>) {
+                for (const auto id : change.nodes) {
+                    auto* node = get_node_mut(id);
+                    if (node == nullptr) {
+                        return inconsistent("property owner is missing");
+                    }
+                    node->set_property(change.key, change.after);
+                }
+                ++property_revision_;
+            } else if constexpr (std::is_same_v<Change, VariableAddedEdit>) {
+                variables_.push_back(Variable{change.name, change.type});
+            } else if constexpr (std::is_same_v<Change, GraphRenamedEdit>) {
+                name_ = change.after;
+            }
+            return Result<void>();
+        },
+        edit);
+}
+
+auto Graph::detach_node(NodeId id) -> std::pair<std::unique_ptr<Node>, std::size_t> {
+    auto it = std::ranges::find_if(nodes_, [id](const auto& node) { return node->get_id() == id; });
+    if (it == nodes_.end()) {
+        return {nullptr, 0};
+    }
+
+    const auto position = static_cast<std::size_t>(it - nodes_.begin());
+    auto node = std::move(*it);
+    nodes_.erase(it);
+    node_lookup_.erase(id);
+    adjacency_out_.erase(id);
+    adjacency_in_.erase(id);
+    ++revision_;
+
+    // Узел отсоединяется без связей; если разбиение не устарело, он — одиночная компонента
+    if (!components_dirty_) {
+        component_links_.erase(id);
+        --component_count_;
+    }
+    return {std::move(node), position};
+}
+
+auto Graph::attach_node(std::unique_ptr<Node> node, std::size_t position) -> void {
+    const auto node_id = node->get_id();
+    node_lookup_[node_id] = node.get();
+    adjacency_out_[node_id] = {};
+    adjacency_in_[node_id] = {};
+
+    const auto offset = static_cast<std::ptrdiff_t>(std::min(position, nodes_.size()));
+    nodes_.insert(nodes_.begin() + offset, std::move(node));
+    ++revision_;
+
+    if (!components_dirty_) {
+        component_links_.emplace(node_id, ComponentLink{.parent = node_id, .size = 1});
+        ++component_count_;
+    }
+}
+
+// Восстанавливает связь с исходным ConnectionId: next_connection_id_ только растёт, поэтому
+// идентификатор не мог быть выдан другой связи.
+auto Graph::insert_connection(const Connection& connection) -> void {
+    connection_lookup_[connection.id] = connections_.size();
+    connections_.push_back(connection);
+    adjacency_out_[connection.from_node].push_back(connection.id);
+    adjacency_in_[connection.to_node].push_back(connection.id);
+    ++revision_;
+
+    if (!components_dirty_) {
+        unite_components(connection.from_node, connection.to_node);
+    }
+}
+
+// ============================================================================
+// Connected components
+// ============================================================================
+
+auto Graph::find_component(NodeId node) const -> NodeId {
+    auto* link = &component_links_.at(node);
+    while (link->parent != node) {
+        // Сжатие путей делением пополам: каждый второй узел перевешивается на деда
+        auto& parent = component_links_.at(link->parent);
+        link->parent = parent.parent;
+        node = link->parent;
+        link = &component_links_.at(node);
+    }
+    return node;
+}
+
+auto Graph::unite_components(NodeId lhs, NodeId rhs) const -> void {
+    auto lhs_root = find_component(lhs);
+    auto rhs_root = find_component(rhs);
+    if (lhs_root == rhs_root) {
+        return;
+    }
+
+    auto* lhs_link = &component_links_.at(lhs_root);
+    auto* rhs_link = &component_links_.at(rhs_root);
+    if (lhs_link->size < rhs_link->size) {
+        std::swap(lhs_root, rhs_root);
+        std::swap(lhs_link, rhs_link);
+    }
+    rhs_link->parent = lhs_root;
+    lhs_link->size += rhs_link->size;
+    --component_count_;
+}
+
+// Вход/выход: пересобирает union-find по всем связям, если разбиение помечено устаревшим.
+// Почему так: разъединение в union-find не поддерживается, а пересборка — O(V+E) и нужна
+// только при первом запросе после удалений, а не после каждого disconnect().
+auto Graph::rebuild_components() const -> void {
+    if (!components_dirty_) {
+        return;
+    }
+
+    component_links_.clear();
+    component_links_.reserve(nodes_.size());
+    for (const auto& node : nodes_) {
+        component_links_.emplace(node->get_id(),
+                                 ComponentLink{.parent = node->get_id(), .size = 1});
+    }
+    component_count_ = nodes_.size();
+    for (const auto& connection : connections_) {
+        unite_components(connection.from_node, connection.to_node);
+    }
+    components_dirty_ = false;
+}
+
 }  // namespace visprog::core
@@ -0,0 +1,72 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include "visprog/core/GraphAlgorithms.hpp"
+
+#include <algorithm>
+
+namespace visprog::core::algorithms {
+
+namespace {
+
+[[nodiscard]] auto by_id(const Node* lhs, const Node* rhs) noexcept -> bool {
+    return lhs->get_id() < rhs->get_id();
+}
+
+}  // namespace
+
+// Вход/выход: заполняет nodes_ узлами графа в порядке NodeId, если граф или его revision()
+// сменились, и снимает отметки прошлого обхода.
+// Edge cases: узлы обычно добавляются с возрастающими ID, поэтому сортировка чаще всего
+// пропускается после проверки is_sorted. Число узлов и первый узел сверяются дополнительно,
+// чтобы не принять за прежний другой граф с тем же адресом и revision().
+// Почему так: кодогенератор запускает короткий обход на каждый exec-узел, и перестройка
+// индекса и обнуление всего битового множества делали каждый такой обход O(V). Теперь
+// стоимость prepare() пропорциональна числу слов, задетых прошлым обходом.
+void TraversalScratch::prepare(const Graph& graph) {
+    const auto nodes = graph.get_nodes();
+    const auto* first = nodes.empty() ? nullptr : nodes.front().get();
+    const bool same_graph = graph_ == &graph && revision_ == graph.revision() &&
+                            nodes_.size() == nodes.size() && first_node_ == first;
+    if (same_graph) {
+        for (const auto word : touched_) {
+            visited_[word] = 0;
+        }
+        touched_.clear();
+    } else {
+        nodes_.clear();
+        for (const auto& node : nodes) {
+            nodes_.push_back(node.get());
+        }
+        if (!std::is_sorted(nodes_.begin(), nodes_.end(), by_id)) {
+            std::sort(nodes_.begin(), nodes_.end(), by_id);
+        }
+        visited_.assign((nodes_.size() + 63) / 64, 0);
+        touched_.clear();
+        touched_.reserve(visited_.size());
+        graph_ = &graph;
+        revision_ = graph.revision();
+        first_node_ = first;
+    }
+    frontier.clear();
+    depths.clear();
+    counters.clear();
+}
+
+auto TraversalScratch::index_of(NodeId id) const noexcept -> std::optional<std::uint32_t> {
+    const auto it = std::lower_bound(
+        nodes_.begin(), nodes_.end(), id, [](const Node* node, NodeId value) noexcept {
+            return node->get_id() < value;
+        });
+    if (it == nodes_.end() || (*it)->get_id() != id) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint32_t>(it - nodes_.begin());
+}
+
+auto TraversalScratch::footprint() const noexcept -> std::size_t {
+    return nodes_.capacity() * sizeof(const Node*) + visited_.capacity() * sizeof(std::uint64_t) +
+           (touched_.capacity() + frontier.capacity() + depths.capacity() + counters.capacity()) *
+               sizeof(std::uint32_t);
+}
+
+}  // namespace visprog::core::algorithms
@@ -0,0 +1,695 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include "visprog/core/GraphClustering.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+#include <utility>
+
+namespace visprog::core {
+
+namespace {
+
+/// @brief Половина неориентированного ребра: CSR хранит каждое ребро в обе стороны.
+struct WeightedLink {
+    std::uint32_t from{0};
+    std::uint32_t to{0};
+    std::uint64_t weight{0};
+};
+
+/// @brief Неориентированный взвешенный граф в CSR; петли учтены только в степенях.
+struct WeightedGraph {
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> targets;
+    std::vector<std::uint64_t> weights;
+    std::vector<std::uint64_t> degrees;
+    std::uint64_t total{0};  ///< 2m
+
+    [[nodiscard]] auto vertex_count() const noexcept -> std::uint32_t {
+        return static_cast<std::uint32_t>(degrees.size());
+    }
+};
+
+// Параллельные половины рёбер сливаются в одну с суммарным весом
+[[nodiscard]] auto make_weighted_graph(std::vector<WeightedLink> links,
+                                       std::vector<std::uint64_t> degrees) -> WeightedGraph {
+    std::ranges::sort(links, [](const WeightedLink& lhs, const WeightedLink& rhs) {
+        return lhs.from != rhs.from ? lhs.from < rhs.from : lhs.to < rhs.to;
+    });
+
+    WeightedGraph graph;
+    graph.offsets.assign(degrees.size() + 1, 0);
+    for (std::size_t i = 0; i < links.size(); ++i) {
+        const auto& link = links[i];
+        if (i > 0 && links[i - 1].from == link.from && links[i - 1].to == link.to) {
+            graph.weights.back() += link.weight;
+            continue;
+        }
+        graph.targets.push_back(link.to);
+        graph.weights.push_back(link.weight);
+        ++graph.offsets[link.from + 1];
+    }
+    for (std::size_t i = 1; i < graph.offsets.size(); ++i) {
+        graph.offsets[i] += graph.offsets[i - 1];
+    }
+    for (const auto degree : degrees) {
+        graph.total += degree;
+    }
+    graph.degrees = std::move(degrees);
+    return graph;
+}
+
+// Номера сообществ 0..k-1 в порядке первого появления; возвращает k
+auto compact(std::vector<std::uint32_t>& communities) -> std::uint32_t {
+    std::vector<std::uint32_t> renumber(communities.size(), Cluster::kNoParent);
+    std::uint32_t count = 0;
+    for (auto& community : communities) {
+        if (renumber[community] == Cluster::kNoParent) {
+            renumber[community] = count++;
+        }
+        community = renumber[community];
+    }
+    return count;
+}
+
+// Вход/выход: сообщество каждой вершины после локальных перемещений Louvain.
+// Edge cases: граф без рёбер остаётся разбиением на одиночки; равный прирост не перемещает
+// вершину, поэтому результат детерминирован и проходы заканчиваются.
+// Почему так: прирост модулярности при переносе изолированной вершины v в сообщество C
+// пропорционален w(v, C) - tot(C) * k(v) / 2m — хватает весов к соседним сообществам и
+// суммарных степеней сообществ.
+[[nodiscard]] auto local_moving(const WeightedGraph& graph, std::uint32_t max_passes)
+    -> std::vector<std::uint32_t> {
+    const auto count = graph.vertex_count();
+    std::vector<std::uint32_t> communities(count);
+    for (std::uint32_t vertex = 0; vertex < count; ++vertex) {
+        communities[vertex] = vertex;
+    }
+    if (graph.total == 0) {
+        return communities;
+    }
+
+    std::vector<std::uint64_t> totals = graph.degrees;
+    std::vector<std::uint64_t> to_community(count, 0);
+    std::vector<std::uint32_t> touched;
+    const auto total = static_cast<double>(graph.total);
+
+    for (std::uint32_t pass = 0; pass < max_passes; ++pass) {
+        bool moved = false;
+        for (std::uint32_t vertex = 0; vertex < count; ++vertex) {
+            touched.clear();
+            for (auto edge = graph.offsets[vertex]; edge < graph.offsets[vertex + 1]; ++edge) {
+                const auto community = communities[graph.targets[edge]];
+                if (to_community[community] == 0) {
+                    touched.push_back(community);
+                }
+                to_community[community] += graph.weights[edge];
+            }
+
+            const auto current = communities[vertex];
+            const auto degree = static_cast<double>(graph.degrees[vertex]);
+            totals[current] -= graph.degrees[vertex];
+            const auto gain = [&](std::uint32_t community) {
+                return static_cast<double>(to_community[community]) -
+                       static_cast<double>(totals[community]) * degree / total;
+            };
+
+            auto best = current;
+            auto best_gain = gain(current);
+            for (const auto community : touched) {
+                if (const auto candidate = gain(community); candidate > best_gain + 1e-9) {
+                    best = community;
+                    best_gain = candidate;
+                }
+            }
+            totals[best] += graph.degrees[vertex];
+            if (best != current) {
+                communities[vertex] = best;
+                moved = true;
+            }
+            for (const auto community : touched) {
+                to_community[community] = 0;
+            }
+        }
+        if (!moved) {
+            break;
+        }
+    }
+    return communities;
+}
+
+// Вход/выход: пары вершин для слияния, когда модулярность больше не растёт.
+// Edge cases: вершина без свободных соседей объединяется со следующей такой же по порядку —
+// так несвязанные компоненты тоже укрупняются, а уровень сокращается почти вдвое.
+[[nodiscard]] auto match_pairs(const WeightedGraph& graph) -> std::vector<std::uint32_t> {
+    const auto count = graph.vertex_count();
+    std::vector<std::uint32_t> communities(count, Cluster::kNoParent);
+    std::optional<std::uint32_t> unmatched;
+    for (std::uint32_t vertex = 0; vertex < count; ++vertex) {
+        if (communities[vertex] != Cluster::kNoParent) {
+            continue;
+        }
+        std::optional<std::uint32_t> heaviest;
+        std::uint64_t heaviest_weight = 0;
+        for (auto edge = graph.offsets[vertex]; edge < graph.offsets[vertex + 1]; ++edge) {
+            const auto neighbor = graph.targets[edge];
+            if (communities[neighbor] == Cluster::kNoParent &&
+                graph.weights[edge] > heaviest_weight) {
+                heaviest = neighbor;
+                heaviest_weight = graph.weights[edge];
+            }
+        }
+        communities[vertex] = vertex;
+        if (heaviest) {
+            communities[*heaviest] = vertex;
+        } else if (unmatched) {
+            communities[vertex] = *unmatched;
+            unmatched.reset();
+        } else {
+            unmatched = vertex;
+        }
+    }
+    return communities;
+}
+
+// Граф сообществ: степени складываются, рёбра внутри сообщества уходят в степени как петли
+[[nodiscard]] auto aggregate(const WeightedGraph& graph,
+                             const std::vector<std::uint32_t>& communities,
+                             std::uint32_t community_count) -> WeightedGraph {
+    std::vector<std::uint64_t> degrees(community_count, 0);
+    std::vector<WeightedLink> links;
+    for (std::uint32_t vertex = 0; vertex < graph.vertex_count(); ++vertex) {
+        const auto community = communities[vertex];
+        degrees[community] += graph.degrees[vertex];
+        for (auto edge = graph.offsets[vertex]; edge < graph.offsets[vertex + 1]; ++edge) {
+            const auto other = communities[graph.targets[edge]];
+            if (other != community) {
+                links.push_back(WeightedLink{
+                    .from = community, .to = other, .weight = graph.weights[edge]});
+            }
+        }
+    }
+    return make_weighted_graph(std::move(links), std::move(degrees));
+}
+
+// Ориентированные рёбра уровня после отображения концов в кластеры; параллельные сливаются
+auto merge_edges(std::vector<ClusterEdge>& edges) -> void {
+    std::ranges::sort(edges, [](const ClusterEdge& lhs, const ClusterEdge& rhs) {
+        return lhs.from != rhs.from ? lhs.from < rhs.from : lhs.to < rhs.to;
+    });
+    std::size_t kept = 0;
+    for (const auto& edge : edges) {
+        if (kept > 0 && edges[kept - 1].from == edge.from && edges[kept - 1].to == edge.to) {
+            edges[kept - 1].exec_links += edge.exec_links;
+            edges[kept - 1].data_links += edge.data_links;
+        } else {
+            edges[kept++] = edge;
+        }
+    }
+    edges.resize(kept);
+}
+
+[[nodiscard]] auto make_level(ClusterLevel& lower,
+                              const std::vector<std::uint32_t>& communities,
+                              std::uint32_t community_count) -> ClusterLevel {
+    ClusterLevel level;
+    level.clusters.resize(community_count);
+    for (std::uint32_t index = 0; index < community_count; ++index) {
+        level.clusters[index].key = index;
+    }
+    std::vector<std::uint32_t> largest_child(community_count, 0);
+    for (std::uint32_t child = 0; child < lower.clusters.size(); ++child) {
+        auto& lower_cluster = lower.clusters[child];
+        auto& cluster = level.clusters[communities[child]];
+        lower_cluster.parent = communities[child];
+        cluster.children.push_back(child);
+        cluster.node_count += lower_cluster.node_count;
+        if (lower_cluster.node_count > largest_child[communities[child]]) {
+            largest_child[communities[child]] = lower_cluster.node_count;
+            cluster.representative = lower_cluster.representative;
+        }
+    }
+    for (const auto& edge : lower.edges) {
+        const auto from = communities[edge.from];
+        const auto to = communities[edge.to];
+        if (from != to) {
+            level.edges.push_back(ClusterEdge{.from = from,
+                                              .to = to,
+                                              .exec_links = edge.exec_links,
+                                              .data_links = edge.data_links});
+        }
+    }
+    merge_edges(level.edges);
+    return level;
+}
+
+}  // namespace
+
+GraphClustering::GraphClustering(ClusteringOptions options) : options_(options) {}
+
+auto GraphClustering::link_weight(const Connection& connection) const noexcept
+    -> std::uint64_t {
+    return connection.type == ConnectionType::Execution ? options_.exec_weight
+                                                        : options_.data_weight;
+}
+
+// Петля (узел связан сам с собой) встречается и во входящих, и в исходящих — вес дважды,
+// как и положено петле в степени
+auto GraphClustering::node_degree(const Graph& graph, NodeId node) const -> std::uint64_t {
+    std::uint64_t degree = 0;
+    for (const auto edges : {graph.outgoing(node), graph.incoming(node)}) {
+        for (const auto id : edges) {
+            if (const auto* connection = graph.get_connection(id)) {
+                degree += link_weight(*connection);
+            }
+        }
+    }
+    return degree;
+}
+
+// ============================================================================
+// Full rebuild
+// ============================================================================
+
+auto GraphClustering::rebuild(const Graph& graph) -> void {
+    slots_.clear();
+    free_slots_.clear();
+    nodes_.clear();
+    links_.clear();
+    total_degree_ = 0;
+
+    const auto nodes = graph.get_nodes();
+    std::unordered_map<NodeId, std::uint32_t> dense;
+    dense.reserve(nodes.size());
+    for (const auto& node : nodes) {
+        dense.emplace(node->get_id(), static_cast<std::uint32_t>(dense.size()));
+    }
+
+    std::vector<std::uint64_t> degrees(nodes.size(), 0);
+    std::vector<WeightedLink> links;
+    links.reserve(graph.connection_count() * 2);
+    for (const auto& connection : graph.get_connections()) {
+        links_.emplace(connection.id, LinkRecord{.from = connection.from_node,
+                                                 .to = connection.to_node});
+        const auto from = dense.find(connection.from_node);
+        const auto to = dense.find(connection.to_node);
+        if (from == dense.end() || to == dense.end()) {
+            continue;
+        }
+        const auto weight = link_weight(connection);
+        degrees[from->second] += weight;
+        degrees[to->second] += weight;
+        if (from->second != to->second) {
+            links.push_back(WeightedLink{.from = from->second, .to = to->second, .weight = weight});
+            links.push_back(WeightedLink{.from = to->second, .to = from->second, .weight = weight});
+        }
+    }
+    const auto weighted = make_weighted_graph(std::move(links), std::move(degrees));
+
+    // Фазы Louvain повторяются над графом сообществ, пока модулярность растёт: уровень 0 —
+    // итоговые сообщества, а не мелкие группы после первой фазы
+    auto communities = local_moving(weighted, options_.max_passes);
+    auto community_count = compact(communities);
+    auto current = aggregate(weighted, communities, community_count);
+    while (community_count > 1) {
+        auto merged = local_moving(current, options_.max_passes);
+        const auto merged_count = compact(merged);
+        if (merged_count == community_count) {
+            break;
+        }
+        for (auto& community : communities) {
+            community = merged[community];
+        }
+        current = aggregate(current, merged, merged_count);
+        community_count = merged_count;
+    }
+    for (std::uint32_t i = 0; i < community_count; ++i) {
+        new_slot();
+    }
+    for (std::uint32_t vertex = 0; vertex < weighted.vertex_count(); ++vertex) {
+        const auto id = nodes[vertex]->get_id();
+        nodes_[id].degree = weighted.degrees[vertex];
+        total_degree_ += weighted.degrees[vertex];
+        attach(id, communities[vertex]);
+    }
+
+    graph_id_ = graph.get_id();
+    revision_ = graph.revision();
+    publish(graph);
+}
+
+// ============================================================================
+// Incremental update
+// ============================================================================
+
+auto GraphClustering::new_slot() -> std::uint32_t {
+    std::uint32_t slot = 0;
+    if (free_slots_.empty()) {
+        slot = static_cast<std::uint32_t>(slots_.size());
+        slots_.emplace_back();
+    } else {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    }
+    // Ключи не переиспользуются: редактор не спутает новый кластер с удалённым
+    slots_[slot].key = next_key_++;
+    return slot;
+}
+
+auto GraphClustering::attach(NodeId node, std::uint32_t slot) -> void {
+    auto& state = nodes_[node];
+    auto& target = slots_[slot];
+    state.slot = slot;
+    state.position = static_cast<std::uint32_t>(target.nodes.size());
+    target.nodes.push_back(node);
+    target.degree += state.degree;
+}
+
+// Пустой слот освобождается сразу; его ключ больше не встречается
+auto GraphClustering::detach(NodeId node) -> void {
+    const auto& state = nodes_.at(node);
+    auto& source = slots_[state.slot];
+    const auto last = source.nodes.back();
+    source.nodes[state.position] = last;
+    nodes_.at(last).position = state.position;
+    source.nodes.pop_back();
+    source.degree -= state.degree;
+    if (source.nodes.empty()) {
+        source.key = 0;
+        free_slots_.push_back(state.slot);
+    }
+}
+
+// Вход/выход: переносит узел в соседний кластер с наибольшим приростом модулярности или
+// выделяет в одиночный кластер; true, если кластер узла сменился.
+// Edge cases: единственный узел кластера остаётся в своём слоте, если переносить некуда.
+auto GraphClustering::local_move(const Graph& graph, NodeId node) -> bool {
+    const auto state = nodes_.at(node);
+    std::unordered_map<std::uint32_t, std::uint64_t> to_slot;
+    for (const auto edges : {graph.outgoing(node), graph.incoming(node)}) {
+        for (const auto id : edges) {
+            const auto* connection = graph.get_connection(id);
+            if (connection == nullptr) {
+                continue;
+            }
+            const auto other =
+                connection->from_node == node ? connection->to_node : connection->from_node;
+            if (other != node) {
+                to_slot[nodes_.at(other).slot] += link_weight(*connection);
+            }
+        }
+    }
+
+    const auto total = static_cast<double>(total_degree_);
+    const auto degree = static_cast<double>(state.degree);
+    const auto own_total = slots_[state.slot].degree - state.degree;
+    const auto gain = [&](std::uint32_t slot, std::uint64_t slot_total) {
+        const auto links = to_slot.find(slot);
+        const auto weight = links != to_slot.end() ? links->second : 0;
+        return static_cast<double>(weight) - static_cast<double>(slot_total) * degree / total;
+    };
+
+    auto best = state.slot;
+    auto best_gain = total > 0.0 ? gain(state.slot, own_total) : 0.0;
+    if (total > 0.0) {
+        std::vector<std::pair<std::uint32_t, std::uint64_t>> candidates(to_slot.begin(),
+                                                                        to_slot.end());
+        std::ranges::sort(candidates);
+        for (const auto& [slot, weight] : candidates) {
+            if (slot == state.slot) {
+                continue;
+            }
+            if (const auto candidate = gain(slot, slots_[slot].degree);
+                candidate > best_gain + 1e-9) {
+                best = slot;
+                best_gain = candidate;
+            }
+        }
+    }
+
+    // Отрицательный прирост в своём кластере — узлу лучше одному (прирост одиночки равен 0)
+    const bool isolate = best == state.slot && best_gain < -1e-9 && own_total > 0 &&
+                         slots_[state.slot].nodes.size() > 1;
+    if (best == state.slot && !isolate) {
+        return false;
+    }
+    detach(node);
+    attach(node, isolate ? new_slot() : best);
+    return true;
+}
+
+// Вход/выход: сверяет узлы и связи со снимком, пересчитывает степени затронутых узлов и
+// перемещает их (и соседей перемещённых) локальными шагами Louvain.
+// Edge cases: неизменённая revision() — ничего не делает; другой граф или правка, задевшая
+// больше rebuild_fraction узлов, — полная перестройка.
+// Почему так: сверка стоит O(V + E) поисков в хеш-таблицах, но сами перемещения касаются только
+// окрестности правки; локальные шаги не разрезают кластер, ставший несвязным, — это
+// исправляет следующий rebuild().
+auto GraphClustering::update(const Graph& graph) -> ClusteringUpdate {
+    if (levels_.empty() || graph.get_id() != graph_id_) {
+        rebuild(graph);
+        return ClusteringUpdate{
+            .rebuilt = true, .changed_nodes = graph.node_count(), .moved_nodes = 0};
+    }
+    if (graph.revision() == revision_ && graph.node_count() == nodes_.size() &&
+        graph.connection_count() == links_.size()) {
+        return ClusteringUpdate{};
+    }
+
+    std::unordered_set<NodeId> changed;
+    std::vector<NodeId> removed_nodes;
+    for (const auto& [id, state] : nodes_) {
+        if (!graph.has_node(id)) {
+            removed_nodes.push_back(id);
+        }
+    }
+    std::vector<ConnectionId> removed_links;
+    for (const auto& [id, link] : links_) {
+        const auto* connection = graph.get_connection(id);
+        if (connection == nullptr || connection->from_node != link.from ||
+            connection->to_node != link.to) {
+            removed_links.push_back(id);
+            changed.insert(link.from);
+            changed.insert(link.to);
+        }
+    }
+    for (const auto id : removed_links) {
+        links_.erase(id);
+    }
+    for (const auto& connection : graph.get_connections()) {
+        if (links_.try_emplace(connection.id, LinkRecord{.from = connection.from_node,
+                                                         .to = connection.to_node})
+                .second) {
+            changed.insert(connection.from_node);
+            changed.insert(connection.to_node);
+        }
+    }
+    for (const auto& node : graph.get_nodes()) {
+        if (!nodes_.contains(node->get_id())) {
+            changed.insert(node->get_id());
+        }
+    }
+    for (const auto id : removed_nodes) {
+        changed.erase(id);
+    }
+
+    const auto changed_count = changed.size() + removed_nodes.size();
+    if (static_cast<double>(changed_count) >
+        options_.rebuild_fraction * static_cast<double>(std::max<std::size_t>(nodes_.size(), 1))) {
+        rebuild(graph);
+        return ClusteringUpdate{.rebuilt = true, .changed_nodes = changed_count, .moved_nodes = 0};
+    }
+
+    for (const auto id : removed_nodes) {
+        total_degree_ -= nodes_.at(id).degree;
+        detach(id);
+        nodes_.erase(id);
+    }
+    std::deque<NodeId> queue;
+    for (const auto id : changed) {
+        if (!nodes_.contains(id)) {
+            attach(id, new_slot());
+        }
+        // Степень меняется вместе с суммой слота и 2m
+        auto& state = nodes_.at(id);
+        const auto degree = node_degree(graph, id);
+        total_degree_ = total_degree_ - state.degree + degree;
+        slots_[state.slot].degree = slots_[state.slot].degree - state.degree + degree;
+        state.degree = degree;
+        queue.push_back(id);
+    }
+    std::ranges::sort(queue);
+
+    std::unordered_set<NodeId> queued(queue.begin(), queue.end());
+    std::size_t moved = 0;
+    auto budget = queue.size() * options_.max_passes;
+    while (!queue.empty() && budget-- > 0) {
+        const auto id = queue.front();
+        queue.pop_front();
+        queued.erase(id);
+        if (!local_move(graph, id)) {
+            continue;
+        }
+        ++moved;
+        for (const auto edges : {graph.outgoing(id), graph.incoming(id)}) {
+            for (const auto link : edges) {
+                const auto* connection = graph.get_connection(link);
+                if (connection == nullptr) {
+                    continue;
+                }
+                const auto other = connection->from_node == id ? connection->to_node
+                                                               : connection->from_node;
+                if (queued.insert(other).second) {
+                    queue.push_back(other);
+                }
+            }
+        }
+    }
+
+    revision_ = graph.revision();
+    publish(graph);
+    return ClusteringUpdate{.rebuilt = false, .changed_nodes = changed_count, .moved_nodes = moved};
+}
+
+// ============================================================================
+// Hierarchy
+// ============================================================================
+
+// Вход/выход: уровень 0 из живых слотов (по возрастанию ключа), затем верхние уровни
+// над графом кластеров, пока их больше target_clusters.
+auto GraphClustering::publish(const Graph& graph) -> void {
+    levels_.clear();
+    std::vector<std::uint32_t> live;
+    for (std::uint32_t slot = 0; slot < slots_.size(); ++slot) {
+        if (!slots_[slot].nodes.empty()) {
+            live.push_back(slot);
+        }
+    }
+    std::ranges::sort(live, [&](std::uint32_t lhs, std::uint32_t rhs) {
+        return slots_[lhs].key < slots_[rhs].key;
+    });
+
+    auto& base = levels_.emplace_back();
+    slot_index_.assign(slots_.size(), Cluster::kNoParent);
+    std::vector<std::uint64_t> degrees(live.size(), 0);
+    for (std::uint32_t index = 0; index < live.size(); ++index) {
+        const auto& slot = slots_[live[index]];
+        slot_index_[live[index]] = index;
+        degrees[index] = slot.degree;
+
+        auto& cluster = base.clusters.emplace_back();
+        cluster.key = slot.key;
+        cluster.node_count = static_cast<std::uint32_t>(slot.nodes.size());
+        cluster.nodes = slot.nodes;
+        std::ranges::sort(cluster.nodes);
+        auto representative = std::ranges::max_element(
+            cluster.nodes, [&](NodeId lhs, NodeId rhs) {
+                const auto lhs_degree = nodes_.at(lhs).degree;
+                const auto rhs_degree = nodes_.at(rhs).degree;
+                return lhs_degree != rhs_degree ? lhs_degree < rhs_degree : rhs < lhs;
+            });
+        cluster.representative = *representative;
+    }
+
+    std::vector<std::uint64_t> internal(live.size(), 0);
+    std::vector<WeightedLink> links;
+    for (const auto& connection : graph.get_connections()) {
+        const auto from_state = nodes_.find(connection.from_node);
+        const auto to_state = nodes_.find(connection.to_node);
+        if (from_state == nodes_.end() || to_state == nodes_.end()) {
+            continue;
+        }
+        const auto from = slot_index_[from_state->second.slot];
+        const auto to = slot_index_[to_state->second.slot];
+        const auto weight = link_weight(connection);
+        if (from == to) {
+            internal[from] += weight;
+            continue;
+        }
+        const bool exec = connection.type == ConnectionType::Execution;
+        base.edges.push_back(ClusterEdge{
+            .from = from, .to = to, .exec_links = exec ? 1U : 0U, .data_links = exec ? 0U : 1U});
+        links.push_back(WeightedLink{.from = from, .to = to, .weight = weight});
+        links.push_back(WeightedLink{.from = to, .to = from, .weight = weight});
+    }
+    merge_edges(base.edges);
+
+    // Q = Σ (2·in(C) / 2m − (tot(C) / 2m)²)
+    modularity_ = 0.0;
+    if (total_degree_ > 0) {
+        const auto total = static_cast<double>(total_degree_);
+        for (std::size_t index = 0; index < live.size(); ++index) {
+            const auto share = static_cast<double>(degrees[index]) / total;
+            modularity_ += 2.0 * static_cast<double>(internal[index]) / total - share * share;
+        }
+    }
+
+    auto current = make_weighted_graph(std::move(links), std::move(degrees));
+    while (levels_.back().clusters.size() > options_.target_clusters &&
+           levels_.size() < options_.max_levels) {
+        auto communities = local_moving(current, options_.max_passes);
+        auto count = compact(communities);
+        if (count == current.vertex_count()) {
+            communities = match_pairs(current);
+            count = compact(communities);
+        }
+        if (count == current.vertex_count()) {
+            break;
+        }
+        auto level = make_level(levels_.back(), communities, count);
+        levels_.push_back(std::move(level));
+        current = aggregate(current, communities, count);
+    }
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+auto GraphClustering::level_for(std::size_t max_clusters) const -> const ClusterLevel* {
+    for (const auto& level : levels_) {
+        if (level.clusters.size() <= max_clusters) {
+            return &level;
+        }
+    }
+    return levels_.empty() ? nullptr : &levels_.back();
+}
+
+auto GraphClustering::cluster_of(NodeId node, std::size_t level) const
+    -> std::optional<std::uint32_t> {
+    const auto state = nodes_.find(node);
+    if (state == nodes_.end() || level >= levels_.size()) {
+        return std::nullopt;
+    }
+    auto index = slot_index_[state->second.slot];
+    for (std::size_t current = 0; current < level; ++current) {
+        index = levels_[current].clusters[index].parent;
+    }
+    return index;
+}
+
+auto GraphClustering::nodes_of(std::size_t level, std::uint32_t cluster) const
+    -> std::vector<NodeId> {
+    std::vector<NodeId> nodes;
+    if (level >= levels_.size() || cluster >= levels_[level].clusters.size()) {
+        return nodes;
+    }
+    std::vector<std::uint32_t> frontier{cluster};
+    for (auto current = level; current > 0; --current) {
+        std::vector<std::uint32_t> children;
+        for (const auto index : frontier) {
+            const auto& next = levels_[current].clusters[index].children;
+            children.insert(children.end(), next.begin(), next.end());
+        }
+        frontier = std::move(children);
+    }
+    for (const auto index : frontier) {
+        const auto& members = levels_[0].clusters[index].nodes;
+        nodes.insert(nodes.end(), members.begin(), members.end());
+    }
+    std::ranges::sort(nodes);
+    return nodes;
+}
+
+}  // namespace visprog::core
@@ -0,0 +1,960 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include "visprog/core/GraphInterpreter.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <iostream>
+#include <utility>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/FormatCompat.hpp"
+#include "visprog/core/GraphProfiler.hpp"
+#include "visprog/core/GraphStatistics.hpp"
+
+namespace visprog::core {
+
+namespace {
+
+using compat::format;
+using IntArray = std::vector<std::int64_t>;
+
+[[nodiscard]] auto find_port_by_name(const Node& node, std::string_view name) -> const Port* {
+    for (const auto& port : node.get_ports()) {
+        if (port.get_name() == name) {
+            return &port;
+        }
+    }
+    return nullptr;
+}
+
+[[nodiscard]] auto as_int(const InterpreterValue& value) -> std::int64_t {
+    if (const auto* number = std::get_if<std::int64_t>(&value)) {
+        return *number;
+    }
+    if (const auto* flag = std::get_if<bool>(&value)) {
+        return *flag ? 1 : 0;
+    }
+    return 0;
+}
+
+[[nodiscard]] auto as_array(InterpreterValue value) -> IntArray {
+    if (auto* array = std::get_if<IntArray>(&value)) {
+        return std::move(*array);
+    }
+    return {};
+}
+
+// Повторяет вывод сгенерированной программы: bool печатается как 1/0 (std::cout без boolalpha)
+[[nodiscard]] auto to_text(const InterpreterValue& value) -> std::string {
+    if (const auto* text = std::get_if<std::string>(&value)) {
+        return *text;
+    }
+    if (const auto* flag = std::get_if<bool>(&value)) {
+        return *flag ? "1" : "0";
+    }
+    if (const auto* number = std::get_if<std::int64_t>(&value)) {
+        return std::to_string(*number);
+    }
+    if (const auto* array = std::get_if<IntArray>(&value)) {
+        std::string text;
+        for (const auto element : *array) {
+            text += text.empty() ? "" : " ";
+            text += std::to_string(element);
+        }
+        return text;
+    }
+    return {};
+}
+
+[[nodiscard]] auto default_value(DataType type) -> InterpreterValue {
+    switch (type) {
+        case DataType::Bool:
+            return false;
+        case DataType::String:
+        case DataType::StringView:
+            return std::string{};
+        case DataType::Vector:
+            return IntArray{};
+        case DataType::Int8:
+        case DataType::Int16:
+        case DataType::Int32:
+        case DataType::Int64:
+        case DataType::UInt8:
+        case DataType::UInt16:
+        case DataType::UInt32:
+        case DataType::UInt64:
+            return std::int64_t{0};
+        default:
+            return std::monostate{};
+    }
+}
+
+/// @brief Список целых свойства "values" ("1, 2, 3"); правила те же, что у генератора C++.
+[[nodiscard]] auto parse_int_list(std::string_view text) -> IntArray {
+    IntArray values;
+    std::size_t position = 0;
+    while (position < text.size()) {
+        auto separator = text.find_first_of(", \t\n;", position);
+        if (separator == std::string_view::npos) {
+            separator = text.size();
+        }
+        const auto token = text.substr(position, separator - position);
+        std::int64_t value = 0;
+        const auto* token_end = token.data() + token.size();
+        if (!token.empty()) {
+            const auto [ptr, ec] = std::from_chars(token.data(), token_end, value);
+            if (ec == std::errc{} && ptr == token_end) {
+                values.push_back(value);
+            }
+        }
+        position = separator + 1;
+    }
+    return values;
+}
+
+// Арифметика по модулю 2^64, как в ColumnarEvaluator: переполнение в графе пользователя
+// не должно быть неопределённым поведением интерпретатора
+[[nodiscard]] auto wrapping_add(std::int64_t lhs, std::int64_t rhs) noexcept -> std::int64_t {
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(lhs) +
+                                     static_cast<std::uint64_t>(rhs));
+}
+
+[[nodiscard]] auto wrapping_mul(std::int64_t lhs, std::int64_t rhs) noexcept -> std::int64_t {
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(lhs) *
+                                     static_cast<std::uint64_t>(rhs));
+}
+
+[[nodiscard]] auto combine(std::string_view operation, std::int64_t lhs, std::int64_t rhs)
+    -> std::int64_t {
+    if (operation == "add") {
+        return wrapping_add(lhs, rhs);
+    }
+    if (operation == "min") {
+        return std::min(lhs, rhs);
+    }
+    if (operation == "max") {
+        return std::max(lhs, rhs);
+    }
+    return wrapping_mul(lhs, rhs);
+}
+
+[[nodiscard]] auto elementwise_operation(std::string_view type_name) -> std::string_view {
+    if (type_name == NodeTypes::ArrayAdd.name) {
+        return "add";
+    }
+    if (type_name == NodeTypes::ArrayMin.name) {
+        return "min";
+    }
+    if (type_name == NodeTypes::ArrayMax.name) {
+        return "max";
+    }
+    return "mul";
+}
+
+[[nodiscard]] auto is_elementwise(std::string_view type_name) -> bool {
+    return type_name == NodeTypes::ArrayAdd.name || type_name == NodeTypes::ArrayMul.name ||
+           type_name == NodeTypes::ArrayMin.name || type_name == NodeTypes::ArrayMax.name;
+}
+
+// Вход/выход: exec-выходы узла в порядке слотов Instruction::targets его обработчика.
+// Edge cases: отсутствующий порт даёт пустой слот (nullptr), чтобы номера слотов были
+// фиксированы: у Branch и ForLoop всегда два слота, у ParallelSequence последний — completed.
+[[nodiscard]] auto exec_slots(const Node& node) -> std::vector<const Port*> {
+    const auto type = node.get_type().name;
+    if (type == NodeTypes::Branch.name) {
+        return {find_port_by_name(node, "true"), find_port_by_name(node, "false")};
+    }
+    if (type == NodeTypes::ForLoop.name) {
+        return {find_port_by_name(node, "loop-body"), find_port_by_name(node, "completed")};
+    }
+
+    auto ports = node.get_exec_output_ports();
+    if (type == NodeTypes::Sequence.name || type == NodeTypes::ParallelSequence.name) {
+        std::ranges::sort(ports, {}, [](const Port* port) { return port->get_name(); });
+        if (type == NodeTypes::ParallelSequence.name) {
+            std::erase_if(ports, [](const Port* port) { return port->get_name() == "completed"; });
+            ports.push_back(find_port_by_name(node, "completed"));
+        }
+        return ports;
+    }
+    if (ports.size() > 1) {
+        ports.resize(1);
+    }
+    return ports;
+}
+
+}  // namespace
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+GraphInterpreter::GraphInterpreter(const Graph& graph, InterpreterOptions options)
+    : graph_(&graph), output_(options.output != nullptr ? options.output : &std::cout) {}
+
+// Вход/выход: граф → таблица инструкций (по одной на exec-узел) и карта источников данных.
+// Edge cases: нет Start — ошибка; циклы по exec- или data-связям отвергаются, потому что
+// исполнение без счётчика шагов на таком графе не завершится.
+// Почему так: переходы между exec-узлами разрешаются в индексы один раз, и цикл исполнения
+// дальше не обращается к хеш-таблицам графа.
+auto GraphInterpreter::compile(const Graph& graph, InterpreterOptions options)
+    -> Result<GraphInterpreter> {
+    const auto& stats = graph.statistics();
+    if (stats.exec_has_cycle || stats.data_has_cycle) {
+        return Result<GraphInterpreter>(
+            Error{format("Graph '", graph.get_name(), "' has a cycle and cannot be interpreted"),
+                  error_codes::interpreter::CyclicGraph});
+    }
+
+    GraphInterpreter interpreter(graph, options);
+    const auto exec_links = interpreter.link_data();
+    for (const auto& node : graph.get_nodes()) {
+        if (node->has_execution_flow()) {
+            interpreter.append_instruction(*node);
+        }
+    }
+
+    interpreter.entry_ = interpreter.find_entry();
+    if (interpreter.entry_ == NoTarget) {
+        return Result<GraphInterpreter>(
+            Error{format("Graph '", graph.get_name(), "' has no Start node"),
+                  error_codes::interpreter::MissingStart});
+    }
+    for (std::uint32_t i = 0; i < interpreter.program_.size(); ++i) {
+        [[maybe_unused]] auto changed = interpreter.link_exec(i, exec_links);
+    }
+    interpreter.compiled_revision_ = graph.revision();
+
+    interpreter.reset();
+    return Result<GraphInterpreter>(std::move(interpreter));
+}
+
+auto GraphInterpreter::select_handler(const Node& node) -> Handler {
+    const auto type = node.get_type().name;
+    if (type == NodeTypes::End.name) {
+        return &GraphInterpreter::run_end;
+    }
+    if (type == NodeTypes::PrintString.name) {
+        return &GraphInterpreter::run_print;
+    }
+    if (type == NodeTypes::SetVariable.name) {
+        return &GraphInterpreter::run_set_variable;
+    }
+    if (type == NodeTypes::Branch.name) {
+        return &GraphInterpreter::run_branch;
+    }
+    if (type == NodeTypes::Sequence.name) {
+        return &GraphInterpreter::run_sequence;
+    }
+    if (type == NodeTypes::ParallelSequence.name) {
+        return &GraphInterpreter::run_parallel;
+    }
+    if (type == NodeTypes::ForLoop.name) {
+        return &GraphInterpreter::run_for_loop;
+    }
+    return &GraphInterpreter::run_jump;
+}
+
+auto GraphInterpreter::append_instruction(const Node& node) -> void {
+    instruction_of_.insert_or_assign(node.get_id(), static_cast<std::uint32_t>(program_.size()));
+    program_.push_back(Instruction{.node = &node,
+                                   .handler = select_handler(node),
+                                   .targets = {},
+                                   .target_ports = {},
+                                   .edge = {}});
+}
+
+// Data-связи перечитываются целиком: их значения всё равно вычисляются лениво при чтении
+auto GraphInterpreter::link_data() -> ExecLinks {
+    ExecLinks exec_links;
+    sources_.clear();
+    for (const auto& connection : graph_->get_connections()) {
+        if (connection.type == ConnectionType::Execution) {
+            exec_links.try_emplace(connection.from_port, connection.to_node);
+        } else {
+            sources_.insert_or_assign(connection.to_port,
+                                      DataSource{.node = graph_->get_node(connection.from_node),
+                                                 .port = connection.from_port});
+        }
+    }
+    return exec_links;
+}
+
+// Вход/выход: пересчитывает слоты переходов инструкции; true, если они изменились.
+auto GraphInterpreter::link_exec(std::uint32_t index, const ExecLinks& exec_links) -> bool {
+    auto& instruction = program_[index];
+    std::vector<std::uint32_t> targets;
+    std::vector<PortId> ports;
+    for (const auto* port : exec_slots(*instruction.node)) {
+        auto target = NoTarget;
+        if (port != nullptr) {
+            if (const auto it = exec_links.find(port->get_id()); it != exec_links.end()) {
+                target = instruction_of_.at(it->second);
+            }
+        }
+        targets.push_back(target);
+        ports.push_back(port != nullptr ? port->get_id() : PortId{});
+    }
+    if (targets == instruction.targets && ports == instruction.target_ports) {
+        return false;
+    }
+    instruction.targets = std::move(targets);
+    instruction.target_ports = std::move(ports);
+    return true;
+}
+
+auto GraphInterpreter::find_entry() const -> std::uint32_t {
+    for (const auto& node : graph_->get_nodes()) {
+        if (node->get_type().name == NodeTypes::Start.name) {
+            if (const auto it = instruction_of_.find(node->get_id()); it != instruction_of_.end()) {
+                return it->second;
+            }
+        }
+    }
+    return NoTarget;
+}
+
+// ============================================================================
+// Hot patching
+// ============================================================================
+
+// Вход/выход: применяет к работающему интерпретатору правки того же графа, сделанные после
+// compile() или прошлого hot_patch(); переменные, значения портов и позиция исполнения
+// сохраняются.
+// Edge cases: удаление узла, на котором стоит исполнение или чей кадр (цикл, Sequence) ещё
+// открыт, — ошибка, и интерпретатор остаётся прежним. Правки свойств узлов не меняют ревизию
+// графа и видны без перекомпиляции: обработчики читают свойства при исполнении.
+// Почему так: индексы уцелевших инструкций не меняются, поэтому pc_ и кадры остаются
+// валидными; новые узлы дописываются в конец таблицы, удалённые превращаются в пустые
+// трамплины, а перелинковываются только инструкции с изменившимися переходами.
+auto GraphInterpreter::hot_patch() -> Result<PatchSummary> {
+    PatchSummary summary;
+    if (graph_->revision() == compiled_revision_) {
+        return Result<PatchSummary>(summary);
+    }
+    const auto& stats = graph_->statistics();
+    if (stats.exec_has_cycle || stats.data_has_cycle) {
+        return Result<PatchSummary>(
+            Error{format("Graph '", graph_->get_name(), "' has a cycle and cannot be interpreted"),
+                  error_codes::interpreter::CyclicGraph});
+    }
+
+    // Указатели удалённых узлов уже висячие: дальше используются только их NodeId
+    std::vector<std::pair<NodeId, std::uint32_t>> removed;
+    for (const auto& [id, index] : instruction_of_) {
+        const auto* node = graph_->get_node(id);
+        if (node == nullptr || node != program_[index].node || !node->has_execution_flow()) {
+            removed.emplace_back(id, index);
+        }
+    }
+
+    std::unordered_set<std::uint32_t> active;
+    if (pc_ != NoTarget) {
+        active.insert(pc_);
+        if (program_[pc_].node == nullptr) {
+            active.insert(program_[pc_].targets.front());
+        }
+    }
+    for (const auto& frame : frames_) {
+        active.insert(frame.instruction);
+    }
+    for (const auto& [id, index] : removed) {
+        if (active.contains(index)) {
+            return Result<PatchSummary>(
+                Error{format("Node ", id.value,
+                             " is on the active execution path and cannot be removed"),
+                      error_codes::interpreter::PatchTouchesActivePath});
+        }
+    }
+
+    bool entry_removed = false;
+    for (const auto& [id, index] : removed) {
+        entry_removed = entry_removed || index == entry_;
+        instruction_of_.erase(id);
+        breakpoints_.erase(id);
+        program_[index] = Instruction{.node = nullptr,
+                                  .handler = &GraphInterpreter::run_jump,
+                                  .targets = {NoTarget},
+                                  .target_ports = {},
+                                  .edge = {}};
+    }
+    summary.removed = removed.size();
+
+    const auto first_new = static_cast<std::uint32_t>(program_.size());
+    for (const auto& node : graph_->get_nodes()) {
+        if (node->has_execution_flow() && !instruction_of_.contains(node->get_id())) {
+            append_instruction(*node);
+        }
+    }
+    summary.added = program_.size() - first_new;
+
+    if (entry_removed) {
+        entry_ = find_entry();
+    }
+
+    const auto exec_links = link_data();
+    for (std::uint32_t i = 0; i < program_.size(); ++i) {
+        if (program_[i].node != nullptr && link_exec(i, exec_links) && i < first_new) {
+            ++summary.relinked;
+        }
+    }
+
+    // Перелинковка заменила трамплины прямыми переходами: взводим уцелевшие точки заново
+    auto edges = std::move(edge_breakpoints_);
+    edge_breakpoints_.clear();
+    for (const auto edge : edges) {
+        [[maybe_unused]] auto armed = set_edge_breakpoint(edge);
+    }
+    for (const auto& variable : graph_->get_variables()) {
+        variables_.try_emplace(variable.name, default_value(variable.type));
+    }
+
+    rebuild_dispatch();
+    compiled_revision_ = graph_->revision();
+    return Result<PatchSummary>(summary);
+}
+
+// ============================================================================
+// Execution
+// ============================================================================
+
+auto GraphInterpreter::run() -> StopReason {
+    return execute(/*step_over_current=*/paused_);
+}
+
+auto GraphInterpreter::step() -> StopReason {
+    stepping_ = true;
+    rebuild_dispatch();
+    const auto reason = execute(/*step_over_current=*/true);
+    stepping_ = false;
+    rebuild_dispatch();
+    return reason;
+}
+
+auto GraphInterpreter::reset() -> void {
+    pc_ = entry_;
+    frames_.clear();
+    if (profile_ != nullptr) {
+        profile_->truncate(0);
+    }
+    finished_ = false;
+    paused_ = false;
+    stop_reason_ = StopReason::Finished;
+    port_values_.clear();
+    value_epochs_.clear();
+    variables_.clear();
+    for (const auto& variable : graph_->get_variables()) {
+        variables_.insert_or_assign(variable.name, default_value(variable.type));
+    }
+    rebuild_dispatch();
+}
+
+auto GraphInterpreter::current_node() const noexcept -> NodeId {
+    if (pc_ == NoTarget) {
+        return NodeId{};
+    }
+    const auto* instruction = &program_[pc_];
+    if (instruction->node == nullptr) {
+        const auto target = instruction->targets.front();
+        if (target == NoTarget) {
+            return NodeId{};
+        }
+        instruction = &program_[target];
+    }
+    return instruction->node->get_id();
+}
+
+auto GraphInterpreter::current_edge() const noexcept -> ConnectionId {
+    if (pc_ == NoTarget || program_[pc_].node != nullptr) {
+        return ConnectionId{};
+    }
+    return program_[pc_].edge;
+}
+
+// Вход/выход: крутит цикл диспетчеризации, пока есть текущая инструкция или незакрытый кадр.
+// Edge cases: step_over_current пропускает ловушку на текущей инструкции — иначе продолжение
+// после останова сразу остановилось бы на той же точке.
+// Почему так: обработчик сам выбирает следующую инструкцию, а ловушка — обычная запись
+// таблицы, поэтому в цикле нет проверок точек останова.
+auto GraphInterpreter::execute(bool step_over_current) -> StopReason {
+    if (finished_) {
+        return StopReason::Finished;
+    }
+    bypass_trap_ = step_over_current && pc_ != NoTarget && dispatch_[pc_] == &trap;
+    paused_ = false;
+    // Выборки профилировщика вне исполнения (на остановке, после конца) не учитываются
+    if (profile_ != nullptr) {
+        profile_->running.store(true, std::memory_order_release);
+    }
+
+    for (;;) {
+        while (pc_ != NoTarget) {
+            ++step_epoch_;
+            if (!dispatch_[pc_](*this, pc_)) {
+                paused_ = true;
+                if (profile_ != nullptr) {
+                    profile_->running.store(false, std::memory_order_release);
+                }
+                return stop_reason_;
+            }
+        }
+        if (frames_.empty()) {
+            finished_ = true;
+            if (profile_ != nullptr) {
+                profile_->running.store(false, std::memory_order_release);
+            }
+            return StopReason::Finished;
+        }
+        continue_frame();
+    }
+}
+
+auto GraphInterpreter::continue_frame() -> void {
+    auto& frame = frames_.back();
+    const auto& instruction = program_[frame.instruction];
+    const auto& targets = instruction.targets;
+
+    switch (frame.kind) {
+        case FrameKind::Sequence:
+            if (frame.next_slot < targets.size()) {
+                pc_ = targets[frame.next_slot++];
+            } else {
+                pop_frame();
+            }
+            return;
+        case FrameKind::Parallel:
+            // completed исполняется уже вне кадра: End в нём завершает всю программу
+            if (frame.next_slot + 1 < targets.size()) {
+                pc_ = targets[frame.next_slot++];
+            } else {
+                pc_ = targets.back();
+                pop_frame();
+            }
+            return;
+        case FrameKind::Loop:
+            if (++frame.index < frame.last) {
+                store(*instruction.node, "index", frame.index);
+                pc_ = targets[0];
+            } else {
+                pc_ = targets[1];
+                pop_frame();
+            }
+            return;
+    }
+}
+
+// End завершает программу, а внутри ветви ParallelSequence — только эту ветвь
+auto GraphInterpreter::unwind_to_branch() -> void {
+    while (!frames_.empty() && frames_.back().kind != FrameKind::Parallel) {
+        pop_frame();
+    }
+}
+
+// Узел кадра уже опубликован как текущий (кадр открывает его же обработчик), поэтому
+// профилю достаточно сдвинуть глубину: следующий узел встанет над кадром
+auto GraphInterpreter::push_frame(Frame frame) -> void {
+    frames_.push_back(frame);
+    if (profile_ != nullptr) {
+        profile_->truncate(static_cast<std::uint32_t>(frames_.size()));
+    }
+}
+
+auto GraphInterpreter::pop_frame() -> void {
+    frames_.pop_back();
+    if (profile_ != nullptr) {
+        profile_->truncate(static_cast<std::uint32_t>(frames_.size()));
+    }
+}
+
+// ============================================================================
+// Breakpoints
+// ============================================================================
+
+auto GraphInterpreter::rebuild_dispatch() -> void {
+    dispatch_.resize(program_.size());
+    for (std::uint32_t i = 0; i < program_.size(); ++i) {
+        const auto& instruction = program_[i];
+        const bool armed = instruction.node != nullptr
+                               ? breakpoints_.contains(instruction.node->get_id())
+                               : edge_breakpoints_.contains(instruction.edge);
+        dispatch_[i] = stepping_ || armed ? &trap : handler_of(i);
+    }
+}
+
+auto GraphInterpreter::set_breakpoint(NodeId node, BreakCondition condition) -> Result<void> {
+    const auto it = instruction_of_.find(node);
+    if (it == instruction_of_.end()) {
+        return Result<void>(Error{format("Node ", node.value, " is not an executable node"),
+                                  error_codes::interpreter::NotExecutable});
+    }
+    breakpoints_.insert_or_assign(node, std::move(condition));
+    dispatch_[it->second] = &trap;
+    return Result<void>();
+}
+
+auto GraphInterpreter::clear_breakpoint(NodeId node) -> void {
+    if (breakpoints_.erase(node) != 0 && !stepping_) {
+        const auto index = instruction_of_.at(node);
+        dispatch_[index] = handler_of(index);
+    }
+}
+
+// Вход/выход: связь → трамплин, вставленный в слот перехода исходного узла.
+// Почему так: у exec-связи нет своей записи в таблице, поэтому точка останова на ней
+// становится отдельной инструкцией; без точек останова переходы идут напрямую.
+auto GraphInterpreter::set_edge_breakpoint(ConnectionId connection) -> Result<void> {
+    const auto* link = graph_->get_connection(connection);
+    if (link == nullptr || link->type != ConnectionType::Execution) {
+        return Result<void>(
+            Error{format("Connection ", connection.value, " is not an execution link"),
+                  error_codes::interpreter::NotExecutable});
+    }
+    const auto from = instruction_of_.find(link->from_node);
+    if (from == instruction_of_.end()) {
+        return Result<void>(Error{format("Connection ", connection.value, " is not compiled"),
+                                  error_codes::interpreter::NotExecutable});
+    }
+
+    bool patched = false;
+    for (std::size_t slot = 0; slot < program_[from->second].targets.size(); ++slot) {
+        const auto target = program_[from->second].targets[slot];
+        if (program_[from->second].target_ports[slot] != link->from_port || target == NoTarget) {
+            continue;
+        }
+        if (program_[target].node == nullptr) {
+            // Трамплин уже вставлен прежним вызовом: достаточно снова взвести его
+            if (program_[target].edge == connection) {
+                dispatch_[target] = &trap;
+                patched = true;
+            }
+            continue;
+        }
+        if (program_[target].node->get_id() != link->to_node) {
+            continue;
+        }
+        const auto trampoline = static_cast<std::uint32_t>(program_.size());
+        program_.push_back(Instruction{.node = nullptr,
+                                       .handler = &GraphInterpreter::run_jump,
+                                       .targets = {target},
+                                       .target_ports = {},
+                                       .edge = connection});
+        dispatch_.push_back(&trap);
+        program_[from->second].targets[slot] = trampoline;
+        patched = true;
+    }
+    if (!patched) {
+        return Result<void>(
+            Error{format("Connection ", connection.value, " is never taken by the interpreter"),
+                  error_codes::interpreter::NotExecutable});
+    }
+    edge_breakpoints_.insert(connection);
+    return Result<void>();
+}
+
+auto GraphInterpreter::clear_edge_breakpoint(ConnectionId connection) -> void {
+    // Трамплин остаётся в таблице и, будучи разоружён, просто передаёт управление дальше
+    if (edge_breakpoints_.erase(connection) == 0) {
+        return;
+    }
+    for (std::uint32_t i = 0; i < program_.size(); ++i) {
+        if (program_[i].node == nullptr && program_[i].edge == connection && !stepping_) {
+            dispatch_[i] = handler_of(i);
+        }
+    }
+}
+
+auto GraphInterpreter::clear_breakpoints() -> void {
+    breakpoints_.clear();
+    edge_breakpoints_.clear();
+    rebuild_dispatch();
+}
+
+// Вход/выход: подменённая запись таблицы; false останавливает цикл исполнения.
+// Edge cases: условие точки останова вычисляется до узла и может читать watch()/variable().
+auto GraphInterpreter::trap(GraphInterpreter& self, std::uint32_t index) -> bool {
+    const auto& instruction = self.program_[index];
+    if (std::exchange(self.bypass_trap_, false)) {
+        return self.handler_of(index)(self, index);
+    }
+
+    if (instruction.node == nullptr) {
+        if (self.edge_breakpoints_.contains(instruction.edge)) {
+            self.stop_reason_ = StopReason::EdgeBreakpoint;
+            return false;
+        }
+        return self.handler_of(index)(self, index);
+    }
+
+    if (self.stepping_) {
+        self.stop_reason_ = StopReason::Step;
+        return false;
+    }
+    const auto it = self.breakpoints_.find(instruction.node->get_id());
+    if (it != self.breakpoints_.end() && (!it->second || it->second(self))) {
+        self.stop_reason_ = StopReason::Breakpoint;
+        return false;
+    }
+    return self.handler_of(index)(self, index);
+}
+
+// ============================================================================
+// Profiling
+// ============================================================================
+
+auto GraphInterpreter::handler_of(std::uint32_t index) const -> Handler {
+    const auto& instruction = program_[index];
+    return profile_ != nullptr && instruction.node != nullptr ? &profile : instruction.handler;
+}
+
+// Вход/выход: подменённая запись таблицы на время профилирования — публикует узел поверх
+// открытых кадров и исполняет его обычный обработчик.
+auto GraphInterpreter::profile(GraphInterpreter& self, std::uint32_t index) -> bool {
+    const auto& instruction = self.program_[index];
+    self.profile_->assign(static_cast<std::uint32_t>(self.frames_.size()),
+                          instruction.node->get_id());
+    return instruction.handler(self, index);
+}
+
+// Edge cases: подключение посреди исполнения сразу публикует открытые кадры и текущий узел.
+// Почему так: как и точки останова, профилирование — подмена записей таблицы, поэтому без
+// профилировщика цикл исполнения не платит ни одной проверки на узел.
+auto GraphInterpreter::attach_profile(ExecutionStack* stack) -> void {
+    profile_ = stack;
+    if (profile_ != nullptr) {
+        for (std::uint32_t i = 0; i < frames_.size(); ++i) {
+            profile_->assign(i, program_[frames_[i].instruction].node->get_id());
+        }
+        profile_->truncate(static_cast<std::uint32_t>(frames_.size()));
+    }
+    rebuild_dispatch();
+}
+
+// ============================================================================
+// Node handlers
+// ============================================================================
+
+auto GraphInterpreter::run_jump(GraphInterpreter& self, std::uint32_t index) -> bool {
+    const auto& targets = self.program_[index].targets;
+    self.pc_ = targets.empty() ? NoTarget : targets.front();
+    return true;
+}
+
+auto GraphInterpreter::run_end(GraphInterpreter& self, std::uint32_t /*index*/) -> bool {
+    self.unwind_to_branch();
+    self.pc_ = NoTarget;
+    return true;
+}
+
+auto GraphInterpreter::run_print(GraphInterpreter& self, std::uint32_t index) -> bool {
+    const auto& node = *self.program_[index].node;
+    *self.output_ << to_text(self.input(node, "string")) << '\n';
+    return run_jump(self, index);
+}
+
+auto GraphInterpreter::run_set_variable(GraphInterpreter& self, std::uint32_t index) -> bool {
+    const auto& node = *self.program_[index].node;
+    auto value = self.input(node, "value-in");
+    if (const auto name = node.get_property<std::string>("variable_name"); name && !name->empty()) {
+        self.variables_.insert_or_assign(*name, value);
+    }
+    self.store(node, "value-out", std::move(value));
+    return run_jump(self, index);
+}
+
+auto GraphInterpreter::run_branch(GraphInterpreter& self, std::uint32_t index) -> bool {
+    const auto& instruction = self.program_[index];
+    const bool condition = as_int(self.input(*instruction.node, "condition")) != 0;
+    self.pc_ = instruction.targets[condition ? 0 : 1];
+    return true;
+}
+
+auto GraphInterpreter::run_sequence(GraphInterpreter& self, std::uint32_t index) -> bool {
+    self.push_frame(Frame{
+        .kind = FrameKind::Sequence, .instruction = index, .next_slot = 0, .index = 0, .last = 0});
+    self.pc_ = NoTarget;
+    return true;
+}
+
+auto GraphInterpreter::run_parallel(GraphInterpreter& self, std::uint32_t index) -> bool {
+    self.push_frame(Frame{
+        .kind = FrameKind::Parallel, .instruction = index, .next_slot = 0, .index = 0, .last = 0});
+    self.pc_ = NoTarget;
+    return true;
+}
+
+// Edge cases: как и в генераторе, без порта first/last берутся границы [0, 10);
+// неподключённый порт даёт 0.
+auto GraphInterpreter::run_for_loop(GraphInterpreter& self, std::uint32_t index) -> bool {
+    const auto& node = *self.program_[index].node;
+    const auto bound = [&](std::string_view port, std::int64_t fallback) {
+        return find_port_by_name(node, port) != nullptr ? as_int(self.input(node, port))
+                                                         : fallback;
+    };
+    const auto first = bound("first", 0);
+    const auto last = bound("last", 10);
+    // Кадр начинает с first - 1: continue_frame увеличивает индекс перед каждой итерацией
+    self.push_frame(Frame{.kind = FrameKind::Loop,
+                          .instruction = index,
+                          .next_slot = 0,
+                          .index = first - 1,
+                          .last = last});
+    self.pc_ = NoTarget;
+    return true;
+}
+
+// ============================================================================
+// Data evaluation
+// ============================================================================
+
+auto GraphInterpreter::input(const Node& node, std::string_view port) -> InterpreterValue {
+    const auto* input_port = find_port_by_name(node, port);
+    if (input_port == nullptr) {
+        return std::monostate{};
+    }
+    const auto it = sources_.find(input_port->get_id());
+    if (it == sources_.end() || it->second.node == nullptr) {
+        return default_value(input_port->get_data_type());
+    }
+    return evaluate(*it->second.node, it->second.port);
+}
+
+// Вход/выход: значение выхода port; результат запоминается для watch().
+// Edge cases: в пределах одного exec-узла (step_epoch_) выход вычисляется один раз — узел,
+// читающий один выход дважды, и общие подвыражения не пересчитываются.
+// Почему так: входы чистых узлов (индекс цикла, переменные) меняются только между
+// exec-узлами, поэтому кеш сбрасывается увеличением эпохи перед каждым обработчиком, а без
+// кеша цепочка Add, читающих предыдущий выход дважды, вычислялась за 2^N.
+auto GraphInterpreter::evaluate(const Node& node, PortId port) -> InterpreterValue {
+    if (const auto cached = value_epochs_.find(port);
+        cached != value_epochs_.end() && cached->second == step_epoch_) {
+        return port_values_.at(port);
+    }
+    // Узлы данных вычисляются внутри exec-узла и в профиле стоят над ним
+    const auto depth = profile_ != nullptr ? profile_->size() : 0;
+    if (profile_ != nullptr) {
+        profile_->assign(depth, node.get_id());
+    }
+    auto value = compute(node, port);
+    if (profile_ != nullptr) {
+        profile_->truncate(depth);
+    }
+    port_values_.insert_or_assign(port, value);
+    value_epochs_.insert_or_assign(port, step_epoch_);
+    return value;
+}
+
+auto GraphInterpreter::compute(const Node& node, PortId port) -> InterpreterValue {
+    const auto type = node.get_type().name;
+    if (type == NodeTypes::IntLiteral.name) {
+        return node.get_property<std::int64_t>("value").value_or(0);
+    }
+    if (type == NodeTypes::BoolLiteral.name) {
+        return node.get_property<bool>("value").value_or(false);
+    }
+    if (type == NodeTypes::StringLiteral.name) {
+        return node.get_property<std::string>("value").value_or("");
+    }
+    if (type == NodeTypes::Add.name) {
+        return wrapping_add(as_int(input(node, "a")), as_int(input(node, "b")));
+    }
+    if (type == NodeTypes::IntArrayLiteral.name) {
+        return parse_int_list(node.get_property<std::string>("values").value_or(""));
+    }
+    if (is_elementwise(type)) {
+        const auto lhs = as_array(input(node, "a"));
+        const auto rhs = as_array(input(node, "b"));
+        const auto operation = elementwise_operation(type);
+        IntArray result(std::min(lhs.size(), rhs.size()));
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = combine(operation, lhs[i], rhs[i]);
+        }
+        return result;
+    }
+    if (type == NodeTypes::ArrayMapScalar.name) {
+        auto values = as_array(input(node, "array"));
+        const auto scalar = as_int(input(node, "scalar"));
+        const auto operation = node.get_property<std::string>("operation").value_or("mul");
+        for (auto& element : values) {
+            element = combine(operation, element, scalar);
+        }
+        return values;
+    }
+    if (type == NodeTypes::ArrayReduceSum.name) {
+        const auto values = as_array(input(node, "array"));
+        std::int64_t sum = 0;
+        for (const auto element : values) {
+            sum = wrapping_add(sum, element);
+        }
+        return sum;
+    }
+    if (type == NodeTypes::GetVariable.name) {
+        const auto name = node.get_property<std::string>("variable_name").value_or("");
+        if (const auto* value = variable(name)) {
+            return *value;
+        }
+        return std::monostate{};
+    }
+
+    // Выходы exec-узлов (index у ForLoop, value-out у SetVariable) пишет их обработчик
+    if (const auto it = port_values_.find(port); it != port_values_.end()) {
+        return it->second;
+    }
+    return std::monostate{};
+}
+
+auto GraphInterpreter::store(const Node& node, std::string_view port, InterpreterValue value)
+    -> void {
+    if (const auto* output = find_port_by_name(node, port)) {
+        port_values_.insert_or_assign(output->get_id(), std::move(value));
+    }
+}
+
+// ============================================================================
+// Watches
+// ============================================================================
+
+auto GraphInterpreter::watch(NodeId node, std::string_view port) const
+    -> std::optional<InterpreterValue> {
+    const auto* target = graph_->get_node(node);
+    if (target == nullptr) {
+        return std::nullopt;
+    }
+
+    const Port* watched = nullptr;
+    if (port.empty()) {
+        for (const auto* output : target->get_output_ports()) {
+            if (!output->is_execution()) {
+                watched = output;
+                break;
+            }
+        }
+    } else {
+        watched = find_port_by_name(*target, port);
+    }
+    if (watched == nullptr || watched->is_execution()) {
+        return std::nullopt;
+    }
+
+    auto id = watched->get_id();
+    if (watched->is_input()) {
+        const auto source = sources_.find(id);
+        if (source == sources_.end()) {
+            return std::nullopt;
+        }
+        id = source->second.port;
+    }
+    if (const auto it = port_values_.find(id); it != port_values_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+auto GraphInterpreter::variable(std::string_view name) const -> const InterpreterValue* {
+    if (const auto it = variables_.find(name); it != variables_.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+}  // namespace visprog::core
@@ -0,0 +1,299 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include "visprog/core/GraphProfiler.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/FormatCompat.hpp"
+
+#if defined(__linux__)
+#define MULTICODE_HAS_THREAD_TIMER 1
+#include <signal.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+// glibc объявляет поле SIGEV_THREAD_ID только под этим именем
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace visprog::core {
+
+namespace {
+
+using compat::format;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+                  std::atomic<std::size_t>::is_always_lock_free &&
+                  std::atomic<std::uint32_t>::is_always_lock_free,
+              "the profiling signal handler needs lock-free atomics");
+
+/// @brief Профилировщик, которому обработчик SIGPROF передаёт выборки.
+std::atomic<GraphProfiler*> active_profiler{nullptr};
+/// @brief Обработчики SIGPROF, которые могли прочитать active_profiler и ещё не вышли.
+std::atomic<std::uint32_t> handlers_in_flight{0};
+
+#if defined(MULTICODE_HAS_THREAD_TIMER)
+timer_t profiling_timer{};
+/// @brief Обработчик SIGPROF ставится первым start() с таймером и больше не снимается.
+bool handler_installed{false};
+
+// Счётчик поднимается до чтения указателя: stop(), дождавшийся нуля после сброса
+// active_profiler, знает, что ни один обработчик больше не обратится к профилировщику
+auto on_profiling_signal(int /*signal*/) -> void {
+    const auto saved_errno = errno;
+    handlers_in_flight.fetch_add(1);
+    if (auto* profiler = active_profiler.load()) {
+        profiler->sample_now();
+    }
+    handlers_in_flight.fetch_sub(1);
+    errno = saved_errno;
+}
+
+[[nodiscard]] auto to_timespec(std::chrono::microseconds interval) -> timespec {
+    timespec value{};
+    value.tv_sec = static_cast<decltype(value.tv_sec)>(interval.count() / 1'000'000);
+    value.tv_nsec = static_cast<decltype(value.tv_nsec)>(interval.count() % 1'000'000 * 1000);
+    return value;
+}
+#endif
+
+auto wait_until_zero(const std::atomic<std::uint32_t>& counter) -> void {
+    while (counter.load() != 0) {
+        std::this_thread::yield();
+    }
+}
+
+// Имя кадра в свёрнутом стеке: ';' разделяет кадры, перевод строки — стеки
+[[nodiscard]] auto frame_name(std::string_view name) -> std::string {
+    std::string frame(name);
+    std::ranges::replace(frame, ';', ':');
+    std::ranges::replace(frame, '\n', ' ');
+    return frame;
+}
+
+}  // namespace
+
+GraphProfiler::GraphProfiler(ProfilerOptions options) : options_(options) {}
+
+GraphProfiler::~GraphProfiler() {
+    stop();
+}
+
+// ============================================================================
+// Sampling
+// ============================================================================
+
+// Вход/выход: подключает интерпретатор (его таблица переходит на публикующие обработчики),
+// выделяет буфер выборок и взводит таймер процессорного времени вызывающего потока, который
+// шлёт SIGPROF только ему.
+// Edge cases: повторный start() сначала останавливает прежний сеанс; второй профилировщик
+// с таймером в процессе или на интерпретаторе, который уже публикует путь другому
+// профилировщику, — ошибка AlreadyRunning: обработчик SIGPROF и стек интерпретатора одни.
+// Почему так: ITIMER_PROF считает время всего процесса и отдаёт сигнал любому потоку —
+// выборки приписывали бы узлу время чужих потоков.
+auto GraphProfiler::start(GraphInterpreter& interpreter) -> Result<void> {
+    stop();
+    samples_.assign(options_.max_samples, Sample{});
+    next_sample_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    recorded_ = 0;
+    stacks_.clear();
+    names_.clear();
+    if (interpreter.profile_ != nullptr) {
+        return Result<void>(Error{"The interpreter is already attached to a graph profiler",
+                                  error_codes::profiler::AlreadyRunning});
+    }
+
+    if (options_.interval.count() > 0) {
+#if defined(MULTICODE_HAS_THREAD_TIMER)
+        GraphProfiler* expected = nullptr;
+        if (!active_profiler.compare_exchange_strong(expected, this)) {
+            return Result<void>(Error{"Another graph profiler is already sampling",
+                                      error_codes::profiler::AlreadyRunning});
+        }
+        struct sigaction action {};
+        action.sa_handler = &on_profiling_signal;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigevent event{};
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = SIGPROF;
+        event.sigev_notify_thread_id = static_cast<pid_t>(syscall(SYS_gettid));
+        itimerspec timer{};
+        timer.it_interval = to_timespec(options_.interval);
+        timer.it_value = timer.it_interval;
+        if (!handler_installed && sigaction(SIGPROF, &action, nullptr) != 0) {
+            active_profiler.store(nullptr, std::memory_order_release);
+            return Result<void>(Error{format("sigaction(SIGPROF) failed, errno ", errno),
+                                      error_codes::profiler::TimerFailed});
+        }
+        handler_installed = true;
+        if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &profiling_timer) != 0) {
+            const auto error = errno;
+            active_profiler.store(nullptr, std::memory_order_release);
+            return Result<void>(Error{format("timer_create failed, errno ", error),
+                                      error_codes::profiler::TimerFailed});
+        }
+        if (timer_settime(profiling_timer, 0, &timer, nullptr) != 0) {
+            const auto error = errno;
+            timer_delete(profiling_timer);
+            active_profiler.store(nullptr, std::memory_order_release);
+            return Result<void>(Error{format("timer_settime failed, errno ", error),
+                                      error_codes::profiler::TimerFailed});
+        }
+        timer_armed_ = true;
+#else
+        return Result<void>(Error{"Timer-driven sampling is not supported on this platform",
+                                  error_codes::profiler::Unsupported});
+#endif
+    }
+
+    interpreter_ = &interpreter;
+    interpreter.attach_profile(&stack_);
+    capacity_.store(samples_.size(), std::memory_order_release);
+    return Result<void>();
+}
+
+// Вход/выход: снимает таймер, отключает обработчик от профилировщика, затем агрегирует выборки.
+// Edge cases: stop() может вызываться из другого потока, пока обработчик исполняется
+// в потоке интерпретатора; тогда stop() ждёт его выхода. Обработчик остаётся установленным:
+// timer_delete не отменяет уже поставленный в очередь SIGPROF, а с SIG_DFL такой сигнал
+// завершил бы процесс; без active_profiler обработчик ничего не делает.
+// Почему так: capacity_ = 0 запрещает новые записи, а счётчики активных выборок гарантируют,
+// что начатая запись завершилась до чтения буфера в aggregate() и до освобождения профилировщика.
+auto GraphProfiler::stop() -> void {
+    capacity_.store(0);
+#if defined(MULTICODE_HAS_THREAD_TIMER)
+    if (timer_armed_) {
+        timer_delete(profiling_timer);
+        active_profiler.store(nullptr);
+        wait_until_zero(handlers_in_flight);
+        timer_armed_ = false;
+    }
+#endif
+    wait_until_zero(active_samples_);
+    if (interpreter_ == nullptr) {
+        return;
+    }
+    interpreter_->attach_profile(nullptr);
+    aggregate();
+    interpreter_ = nullptr;
+}
+
+// Вызывается из обработчика сигнала: только атомики и запись в заранее выделенный буфер.
+// Почему так: путь читается без согласования с интерпретатором, поэтому выборка, попавшая
+// ровно между сменой глубины и записью узла, может содержать предыдущий узел этого уровня —
+// для статистического профиля это допустимая погрешность.
+auto GraphProfiler::sample_now() noexcept -> void {
+    active_samples_.fetch_add(1);
+    record_sample();
+    active_samples_.fetch_sub(1);
+}
+
+// Счётчик active_samples_ поднят до чтения capacity_: stop() обнуляет capacity_ и ждёт
+// нуля счётчика, поэтому запись либо видит 0, либо успевает завершиться до aggregate()
+auto GraphProfiler::record_sample() noexcept -> void {
+    const auto capacity = capacity_.load();
+    if (capacity == 0 || !stack_.running.load(std::memory_order_acquire)) {
+        return;
+    }
+    const auto depth = std::min(stack_.depth.load(std::memory_order_acquire),
+                                ExecutionStack::kMaxDepth);
+    if (depth == 0) {
+        return;
+    }
+    const auto slot = next_sample_.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= capacity) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    auto& sample = samples_[slot];
+    sample.depth = depth;
+    for (std::uint32_t i = 0; i < depth; ++i) {
+        sample.nodes[i] = stack_.nodes[i].load(std::memory_order_relaxed);
+    }
+}
+
+auto GraphProfiler::sample_count() const noexcept -> std::size_t {
+    if (interpreter_ == nullptr) {
+        return recorded_;
+    }
+    return std::min(next_sample_.load(std::memory_order_relaxed), samples_.size());
+}
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+// Выборки сворачиваются в счётчики по путям, имена узлов запоминаются сразу: отчёты после
+// stop() не обращаются ни к интерпретатору, ни к графу
+auto GraphProfiler::aggregate() -> void {
+    const auto& graph = *interpreter_->graph_;
+    graph_name_ = graph.get_name();
+    recorded_ = std::min(next_sample_.load(std::memory_order_relaxed), samples_.size());
+    for (std::size_t i = 0; i < recorded_; ++i) {
+        const auto& sample = samples_[i];
+        std::vector<std::uint64_t> path(sample.nodes.begin(), sample.nodes.begin() + sample.depth);
+        for (const auto id : path) {
+            if (!names_.contains(id)) {
+                const auto* node = graph.get_node(NodeId{id});
+                names_.emplace(id, node != nullptr ? std::string(node->get_display_name())
+                                                   : format("node ", id));
+            }
+        }
+        ++stacks_[std::move(path)];
+    }
+    samples_.clear();
+    samples_.shrink_to_fit();
+}
+
+auto GraphProfiler::node_profiles() const -> std::vector<NodeProfile> {
+    std::unordered_map<std::uint64_t, NodeProfile> by_node;
+    for (const auto& [path, count] : stacks_) {
+        for (auto it = path.begin(); it != path.end(); ++it) {
+            auto& profile = by_node[*it];
+            // Узел, встретившийся в пути дважды, учитывается в total один раз
+            if (std::find(path.begin(), it, *it) == it) {
+                profile.total_samples += count;
+            }
+        }
+        by_node[path.back()].self_samples += count;
+    }
+
+    std::vector<NodeProfile> profiles;
+    profiles.reserve(by_node.size());
+    for (auto& [id, profile] : by_node) {
+        profile.node = NodeId{id};
+        profile.name = names_.at(id);
+        profile.self_time = options_.interval * static_cast<std::int64_t>(profile.self_samples);
+        profile.total_time =
+            options_.interval * static_cast<std::int64_t>(profile.total_samples);
+        profiles.push_back(std::move(profile));
+    }
+    std::ranges::sort(profiles, [](const NodeProfile& lhs, const NodeProfile& rhs) {
+        return lhs.self_samples != rhs.self_samples ? lhs.self_samples > rhs.self_samples
+                                                    : lhs.node < rhs.node;
+    });
+    return profiles;
+}
+
+auto GraphProfiler::collapsed_stacks() const -> std::string {
+    std::stringstream ss;
+    for (const auto& [path, count] : stacks_) {
+        ss << frame_name(graph_name_);
+        for (const auto id : path) {
+            ss << ';' << frame_name(names_.at(id));
+        }
+        ss << ' ' << count << '\n';
+    }
+    return ss.str();
+}
+
+}  // namespace visprog::core
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <limits>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -17,6 +18,7 @@
 #include "visprog/core/FormatCompat.hpp"
 #include "visprog/core/NodeFactory.hpp"
 #include "visprog/core/Port.hpp"
+#include "visprog/core/Workspace.hpp"
 
 namespace {
 
@@ -30,6 +32,7 @@ using visprog::core::Error;
 using visprog::core::Graph;
 using visprog::core::GraphId;
 using visprog::core::GraphSerializer;
+using visprog::core::IdRemap;
 using visprog::core::Node;
 using visprog::core::NodeFactory;
 using visprog::core::NodeId;
@@ -97,11 +100,19 @@ namespace NodeTypes = visprog::core::NodeTypes;
         {NodeTypes::Branch.name, &NodeTypes::Branch},
         {NodeTypes::Sequence.name, &NodeTypes::Sequence},
         {NodeTypes::ForLoop.name, &NodeTypes::ForLoop},
+        {NodeTypes::ParallelSequence.name, &NodeTypes::ParallelSequence},
         {NodeTypes::PrintString.name, &NodeTypes::PrintString},
         {NodeTypes::StringLiteral.name, &NodeTypes::StringLiteral},
         {NodeTypes::BoolLiteral.name, &NodeTypes::BoolLiteral},
         {NodeTypes::IntLiteral.name, &NodeTypes::IntLiteral},
         {NodeTypes::Add.name, &NodeTypes::Add},
+        {NodeTypes::IntArrayLiteral.name, &NodeTypes::IntArrayLiteral},
+        {NodeTypes::ArrayAdd.name, &NodeTypes::ArrayAdd},
+        {NodeTypes::ArrayMul.name, &NodeTypes::ArrayMul},
+        {NodeTypes::ArrayMin.name, &NodeTypes::ArrayMin},
+        {NodeTypes::ArrayMax.name, &NodeTypes::ArrayMax},
+        {NodeTypes::ArrayReduceSum.name, &NodeTypes::ArrayReduceSum},
+        {NodeTypes::ArrayMapScalar.name, &NodeTypes::ArrayMapScalar},
         {NodeTypes::GetVariable.name, &NodeTypes::GetVariable},
         {NodeTypes::SetVariable.name, &NodeTypes::SetVariable},
 
@@ -111,11 +122,19 @@ namespace NodeTypes = visprog::core::NodeTypes;
         {"Branch", &NodeTypes::Branch},
         {"Sequence", &NodeTypes::Sequence},
         {"ForLoop", &NodeTypes::ForLoop},
+        {"ParallelSequence", &NodeTypes::ParallelSequence},
         {"Print", &NodeTypes::PrintString},
         {"ConstString", &NodeTypes::StringLiteral},
         {"ConstBool", &NodeTypes::BoolLiteral},
         {"ConstNumber", &NodeTypes::IntLiteral},
         {"Add", &NodeTypes::Add},
+        {"ConstIntArray", &NodeTypes::IntArrayLiteral},
+        {"ArrayAdd", &NodeTypes::ArrayAdd},
+        {"ArrayMultiply", &NodeTypes::ArrayMul},
+        {"ArrayMin", &NodeTypes::ArrayMin},
+        {"ArrayMax", &NodeTypes::ArrayMax},
+        {"ArraySum", &NodeTypes::ArrayReduceSum},
+        {"ArrayMapScalar", &NodeTypes::ArrayMapScalar},
         {"GetVariable", &NodeTypes::GetVariable},
         {"SetVariable", &NodeTypes::SetVariable},
     };
@@ -384,28 +403,42 @@ struct ConnectionKeyHash {
     return Result<void>();
 }
 
-}  // namespace
+// --- Save Helpers ---
 
-namespace visprog::core {
+template <typename Id>
+[[nodiscard]] auto mapped_id(const std::unordered_map<Id, Id>& remap, Id id) -> std::uint64_t {
+    if (const auto it = remap.find(id); it != remap.end()) {
+        return it->second.value;
+    }
+    return id.value;
+}
 
-auto GraphSerializer::to_json(const Graph& graph) -> nlohmann::json {
+// Вход/выход: пишет узлы и связи в заданном порядке, подставляя ID из remap (если он не пуст).
+// Почему так: to_json и компактное сохранение дают один и тот же формат документа; поле
+// firstPortId пишется только при перенумерации, где порты узла гарантированно идут подряд.
+[[nodiscard]] auto write_document(const Graph& graph,
+                                  std::span<const Node* const> nodes,
+                                  std::span<const Connection* const> connections,
+                                  const IdRemap& remap) -> nlohmann::json {
     nlohmann::json doc;
-    doc["schema"] = {{"version", kSchemaVersion},
-                     {"coreMin", kSchemaCoreMin},
-                     {"coreMax", kSchemaCoreMax}};
+    doc["schema"] = {{"version", GraphSerializer::kSchemaVersion},
+                     {"coreMin", GraphSerializer::kSchemaCoreMin},
+                     {"coreMax", GraphSerializer::kSchemaCoreMax}};
     doc["graph"] = {{"id", graph.get_id().value}, {"name", graph.get_name()}};
 
     nlohmann::json nodes_json = nlohmann::json::array();
-    for (const auto& node_ptr : graph.get_nodes()) {
-        const auto& node = *node_ptr;
+    for (const auto* node : nodes) {
         nlohmann::json node_json;
-        node_json["id"] = node.get_id().value;
-        node_json["type"] = node.get_type().name;
-        node_json["instanceName"] = node.get_instance_name();
+        node_json["id"] = mapped_id(remap.nodes, node->get_id());
+        node_json["type"] = node->get_type().name;
+        node_json["instanceName"] = node->get_instance_name();
+        if (!remap.empty() && !node->get_ports().empty()) {
+            node_json["firstPortId"] = mapped_id(remap.ports, node->get_ports().front().get_id());
+        }
 
         // Serialize properties
         nlohmann::json props_json = nlohmann::json::object();
-        for (const auto& [key, prop] : node.get_all_properties()) {
+        for (const auto& [key, prop] : node->get_all_properties()) {
             std::visit([&](const auto& value) { props_json[key] = value; }, prop);
         }
         if (!props_json.empty()) {
@@ -416,13 +449,14 @@ auto GraphSerializer::to_json(const Graph& graph) -> nlohmann::json {
     }
     doc["nodes"] = std::move(nodes_json);
 
-    // Connections (unchanged, but shown for completeness)
     nlohmann::json conns_json = nlohmann::json::array();
-    for (const auto& conn : graph.get_connections()) {
+    for (const auto* conn : connections) {
         nlohmann::json conn_json;
-        conn_json["id"] = conn.id.value;
-        conn_json["from"] = {{"nodeId", conn.from_node.value}, {"portId", conn.from_port.value}};
-        conn_json["to"] = {{"nodeId", conn.to_node.value}, {"portId", conn.to_port.value}};
+        conn_json["id"] = mapped_id(remap.connections, conn->id);
+        conn_json["from"] = {{"nodeId", mapped_id(remap.nodes, conn->from_node)},
+                             {"portId", mapped_id(remap.ports, conn->from_port)}};
+        conn_json["to"] = {{"nodeId", mapped_id(remap.nodes, conn->to_node)},
+                           {"portId", mapped_id(remap.ports, conn->to_port)}};
         conns_json.push_back(std::move(conn_json));
     }
     doc["connections"] = std::move(conns_json);
@@ -430,7 +464,115 @@ auto GraphSerializer::to_json(const Graph& graph) -> nlohmann::json {
     return doc;
 }
 
-auto GraphSerializer::from_json(const nlohmann::json& doc) -> Result<Graph> {
+// Вход/выход: порядок обхода для компактной нумерации — BFS по исходящим связям от узлов без
+// входящих связей (в порядке графа), затем от оставшихся узлов (циклы без входа).
+// Edge cases: каждая связь попадает в порядок ровно один раз — при обработке её источника.
+// Почему так: соседние по потоку узлы получают близкие ID, что выгодно для delta/varint.
+auto build_compaction(const Graph& graph,
+                      std::vector<const Node*>& node_order,
+                      std::vector<const Connection*>& connection_order) -> IdRemap {
+    const auto nodes = graph.get_nodes();
+    node_order.reserve(nodes.size());
+    connection_order.reserve(graph.connection_count());
+
+    std::unordered_set<NodeId> visited;
+    visited.reserve(nodes.size());
+    const auto visit_from = [&](const Node& root) {
+        if (!visited.insert(root.get_id()).second) {
+            return;
+        }
+        std::size_t head = node_order.size();
+        node_order.push_back(&root);
+        for (; head < node_order.size(); ++head) {
+            for (const auto connection_id : graph.outgoing(node_order[head]->get_id())) {
+                const auto* connection = graph.get_connection(connection_id);
+                connection_order.push_back(connection);
+                if (visited.insert(connection->to_node).second) {
+                    node_order.push_back(graph.get_node(connection->to_node));
+                }
+            }
+        }
+    };
+
+    for (const auto& node : nodes) {
+        if (graph.incoming(node->get_id()).empty()) {
+            visit_from(*node);
+        }
+    }
+    for (const auto& node : nodes) {
+        visit_from(*node);
+    }
+
+    IdRemap remap;
+    remap.nodes.reserve(node_order.size());
+    remap.connections.reserve(connection_order.size());
+    std::uint64_t next_port = 1;
+    for (std::size_t i = 0; i < node_order.size(); ++i) {
+        remap.nodes.emplace(node_order[i]->get_id(), NodeId{i + 1});
+        for (const auto& port : node_order[i]->get_ports()) {
+            remap.ports.emplace(port.get_id(), PortId{next_port++});
+        }
+    }
+    for (std::size_t i = 0; i < connection_order.size(); ++i) {
+        remap.connections.emplace(connection_order[i]->id, ConnectionId{i + 1});
+    }
+    return remap;
+}
+
+template <typename Id>
+[[nodiscard]] auto remap_table_to_json(const std::unordered_map<Id, Id>& table) -> nlohmann::json {
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> pairs;
+    pairs.reserve(table.size());
+    for (const auto& [from, to] : table) {
+        pairs.emplace_back(from.value, to.value);
+    }
+    std::ranges::sort(pairs, {}, &std::pair<std::uint64_t, std::uint64_t>::second);
+
+    nlohmann::json array = nlohmann::json::array();
+    for (const auto& [from, to] : pairs) {
+        array.push_back({from, to});
+    }
+    return array;
+}
+
+}  // namespace
+
+namespace visprog::core {
+
+auto GraphSerializer::to_json(const Graph& graph) -> nlohmann::json {
+    std::vector<const Node*> nodes;
+    nodes.reserve(graph.node_count());
+    for (const auto& node : graph.get_nodes()) {
+        nodes.push_back(node.get());
+    }
+    std::vector<const Connection*> connections;
+    connections.reserve(graph.connection_count());
+    for (const auto& conn : graph.get_connections()) {
+        connections.push_back(&conn);
+    }
+    return write_document(graph, nodes, connections, IdRemap{});
+}
+
+auto GraphSerializer::save(const Graph& graph, const SaveOptions& options) -> SavedDocument {
+    if (!options.compact_ids) {
+        return SavedDocument{.document = to_json(graph), .remap = {}};
+    }
+
+    std::vector<const Node*> nodes;
+    std::vector<const Connection*> connections;
+    auto remap = build_compaction(graph, nodes, connections);
+    auto document = write_document(graph, nodes, connections, remap);
+    return SavedDocument{.document = std::move(document), .remap = std::move(remap)};
+}
+
+auto GraphSerializer::remap_to_json(const IdRemap& remap) -> nlohmann::json {
+    return {{"nodes", remap_table_to_json(remap.nodes)},
+            {"ports", remap_table_to_json(remap.ports)},
+            {"connections", remap_table_to_json(remap.connections)}};
+}
+
+auto GraphSerializer::from_json(const nlohmann::json& doc, const NodeTypeRegistry* node_types)
+    -> Result<Graph> {
     if (!doc.is_object()) {
         return Result<Graph>(
             Error{.message = "Root JSON must be an object",
@@ -525,18 +667,30 @@ auto GraphSerializer::from_json(const nlohmann::json& doc) -> Result<Graph> {
         if (!type_name_res)
             return Result<Graph>(type_name_res.error());
 
-        auto it = node_type_lookup.find(type_name_res.value());
-        if (it == node_type_lookup.end()) {
+        const auto it = node_type_lookup.find(type_name_res.value());
+        const NodeType* node_type = it != node_type_lookup.end() ? it->second : nullptr;
+        if (node_type == nullptr && node_types != nullptr) {
+            node_type = node_types->find(type_name_res.value());
+        }
+        if (node_type == nullptr) {
             return Result<Graph>(
                 Error{.message = format(ctx, ": unknown node type '", type_name_res.value(), "'"),
                       .code = visprog::core::error_codes::serializer::InvalidEnum});
         }
-        const NodeType* node_type = it->second;
 
         const auto name_res = require_field<std::string>(node_json, "instanceName", ctx);
         if (!name_res)
             return Result<Graph>(name_res.error());
 
+        // Компактно сохранённый документ указывает первый порт узла явно (порты идут подряд).
+        if (node_json.contains("firstPortId")) {
+            const auto first_port_res = require_uint64(node_json, "firstPortId", ctx);
+            if (!first_port_res)
+                return Result<Graph>(first_port_res.error());
+            NodeFactory::force_id_counters(NodeFactory::get_id_counters().next_node_id,
+                                           PortId{first_port_res.value()});
+        }
+
         auto node = NodeFactory::create_with_id(node_id, *node_type, name_res.value());
 
         if (auto props_it = node_json.find("properties"); props_it != node_json.end()) {
@@ -630,6 +784,8 @@ auto GraphSerializer::from_json(const nlohmann::json& doc) -> Result<Graph> {
     graph.next_connection_id_.value =
         std::max(graph.next_connection_id_.value, max_connection_id + 1);
 
+    // Загрузка документа не является правкой пользователя и не должна отменяться.
+    graph.clear_history();
     return Result<Graph>(std::move(graph));
 }
 
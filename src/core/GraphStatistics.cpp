@@ -0,0 +1,135 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include "visprog/core/GraphStatistics.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+#include "visprog/core/Graph.hpp"
+
+namespace visprog::core {
+
+namespace {
+
+struct LongestPath {
+    std::size_t depth{0};
+    bool has_cycle{false};
+};
+
+auto add_to_histogram(DegreeDistribution& distribution, std::size_t degree) -> void {
+    if (distribution.histogram.size() <= degree) {
+        distribution.histogram.resize(degree + 1, 0);
+    }
+    ++distribution.histogram[degree];
+    distribution.max = std::max(distribution.max, degree);
+}
+
+// Вход/выход: самый длинный путь по связям типа type (алгоритм Кана, уровни узлов).
+// Edge cases: узлы цикла не достигают нулевой входящей степени и не учитываются в depth.
+// Почему так: один проход по очереди Кана — O(V+E) без рекурсии.
+auto longest_path(const Graph& graph,
+                  const std::unordered_map<NodeId, std::uint32_t>& index,
+                  std::vector<std::uint32_t> in_degree,
+                  ConnectionType type) -> LongestPath {
+    const auto nodes = graph.get_nodes();
+    std::vector<std::uint32_t> levels(nodes.size(), 0);
+    std::vector<std::uint32_t> queue;
+    queue.reserve(nodes.size());
+    for (std::uint32_t i = 0; i < in_degree.size(); ++i) {
+        if (in_degree[i] == 0) {
+            queue.push_back(i);
+        }
+    }
+
+    LongestPath result;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const auto current = queue[head];
+        result.depth = std::max<std::size_t>(result.depth, levels[current]);
+        for (const auto connection_id : graph.outgoing(nodes[current]->get_id())) {
+            const auto* connection = graph.get_connection(connection_id);
+            if (connection == nullptr || connection->type != type) {
+                continue;
+            }
+            const auto next = index.at(connection->to_node);
+            levels[next] = std::max(levels[next], levels[current] + 1);
+            if (--in_degree[next] == 0) {
+                queue.push_back(next);
+            }
+        }
+    }
+    result.has_cycle = queue.size() != nodes.size();
+    return result;
+}
+
+}  // namespace
+
+auto GraphStatistics::compute(const Graph& graph) -> GraphStatistics {
+    GraphStatistics stats;
+    stats.revision = graph.revision();
+
+    const auto nodes = graph.get_nodes();
+    stats.node_count = nodes.size();
+
+    std::unordered_map<NodeId, std::uint32_t> index;
+    index.reserve(nodes.size());
+    std::size_t largest_fan_out = 0;
+    std::size_t total_degree = 0;
+    for (std::uint32_t i = 0; i < nodes.size(); ++i) {
+        const auto& node = *nodes[i];
+        index.emplace(node.get_id(), i);
+
+        const auto type_name = node.get_type().name;
+        if (const auto it = stats.nodes_by_type.find(type_name); it != stats.nodes_by_type.end()) {
+            ++it->second;
+        } else {
+            stats.nodes_by_type.emplace(std::string(type_name), 1);
+        }
+
+        const auto out = graph.outgoing(node.get_id()).size();
+        const auto in = graph.incoming(node.get_id()).size();
+        add_to_histogram(stats.out_degree, out);
+        add_to_histogram(stats.in_degree, in);
+        total_degree += out;
+        if (out > largest_fan_out) {
+            largest_fan_out = out;
+            stats.largest_fan_out_node = node.get_id();
+        }
+        if (out == 0 && in == 0) {
+            ++stats.isolated_nodes;
+        }
+    }
+
+    std::vector<std::uint32_t> exec_in(nodes.size(), 0);
+    std::vector<std::uint32_t> data_in(nodes.size(), 0);
+    for (const auto& connection : graph.get_connections()) {
+        const auto to = index.at(connection.to_node);
+        if (connection.type == ConnectionType::Execution) {
+            ++stats.exec_connection_count;
+            ++exec_in[to];
+        } else {
+            ++stats.data_connection_count;
+            ++data_in[to];
+        }
+    }
+
+    // Компоненты берутся из union-find графа: после connect() он уже актуален
+    stats.connected_components = graph.component_count();
+
+    if (!nodes.empty()) {
+        // Каждая связь даёт одну исходящую и одну входящую степень, поэтому средние равны
+        const auto mean = static_cast<double>(total_degree) / static_cast<double>(nodes.size());
+        stats.out_degree.mean = mean;
+        stats.in_degree.mean = mean;
+    }
+
+    const auto exec = longest_path(graph, index, std::move(exec_in), ConnectionType::Execution);
+    const auto data = longest_path(graph, index, std::move(data_in), ConnectionType::Data);
+    stats.exec_depth = exec.depth;
+    stats.exec_has_cycle = exec.has_cycle;
+    stats.data_depth = data.depth;
+    stats.data_has_cycle = data.has_cycle;
+    return stats;
+}
+
+}  // namespace visprog::core
@@ -3,9 +3,32 @@
 #include "visprog/core/NodeFactory.hpp"
 
 #include <string>
+#include <string_view>
 
 namespace visprog::core {
 
+namespace {
+
+/// @brief Тип элемента массивов в узлах семейства Array Math.
+constexpr auto kArrayElementTypeName = "int32";
+
+[[nodiscard]] auto is_elementwise_array_node(std::string_view type_name) noexcept -> bool {
+    return type_name == NodeTypes::ArrayAdd.name || type_name == NodeTypes::ArrayMul.name ||
+           type_name == NodeTypes::ArrayMin.name || type_name == NodeTypes::ArrayMax.name;
+}
+
+auto add_array_input(Node& node, std::string name, PortId id) -> void {
+    auto& port = node.add_input_port(DataType::Vector, std::move(name), id);
+    [[maybe_unused]] const bool typed = port.set_type_name(kArrayElementTypeName);
+}
+
+auto add_array_output(Node& node, std::string name, PortId id) -> void {
+    auto& port = node.add_output_port(DataType::Vector, std::move(name), id);
+    [[maybe_unused]] const bool typed = port.set_type_name(kArrayElementTypeName);
+}
+
+}  // namespace
+
 auto NodeFactory::create(const NodeType& type, std::string instance_name) -> std::unique_ptr<Node> {
     const auto node_id = generate_node_id();
     if (instance_name.empty()) {
@@ -44,6 +67,11 @@ void NodeFactory::configure_ports(Node& node) {
         node.add_input_port(DataType::Execution, "exec-in", generate_port_id());
         node.add_output_port(DataType::Execution, "then-0", generate_port_id());
         node.add_output_port(DataType::Execution, "then-1", generate_port_id());
+    } else if (type.name == NodeTypes::ParallelSequence.name) {
+        node.add_input_port(DataType::Execution, "exec-in", generate_port_id());
+        node.add_output_port(DataType::Execution, "then-0", generate_port_id());
+        node.add_output_port(DataType::Execution, "then-1", generate_port_id());
+        node.add_output_port(DataType::Execution, "completed", generate_port_id());
     } else if (type.name == NodeTypes::ForLoop.name) {
         node.add_input_port(DataType::Execution, "exec-in", generate_port_id());
         node.add_input_port(DataType::Int32, "first", generate_port_id());
@@ -64,6 +92,21 @@ void NodeFactory::configure_ports(Node& node) {
         node.add_input_port(DataType::Int32, "a", generate_port_id());
         node.add_input_port(DataType::Int32, "b", generate_port_id());
         node.add_output_port(DataType::Int32, "result", generate_port_id());
+    } else if (type.name == NodeTypes::IntArrayLiteral.name) {
+        add_array_output(node, "result", generate_port_id());
+        node.set_property("values", std::string(""));
+    } else if (is_elementwise_array_node(type.name)) {
+        add_array_input(node, "a", generate_port_id());
+        add_array_input(node, "b", generate_port_id());
+        add_array_output(node, "result", generate_port_id());
+    } else if (type.name == NodeTypes::ArrayReduceSum.name) {
+        add_array_input(node, "array", generate_port_id());
+        node.add_output_port(DataType::Int32, "result", generate_port_id());
+    } else if (type.name == NodeTypes::ArrayMapScalar.name) {
+        add_array_input(node, "array", generate_port_id());
+        node.add_input_port(DataType::Int32, "scalar", generate_port_id());
+        add_array_output(node, "result", generate_port_id());
+        node.set_property("operation", std::string("mul"));
     } else if (type.name == NodeTypes::GetVariable.name) {
         node.set_property("variable_name", std::string(""));
         node.add_output_port(DataType::Any, "value-out", generate_port_id());
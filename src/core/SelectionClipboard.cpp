@@ -0,0 +1,594 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include "visprog/core/SelectionClipboard.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/FormatCompat.hpp"
+#include "visprog/core/NodeFactory.hpp"
+
+namespace visprog::core {
+
+namespace {
+
+using compat::format;
+
+constexpr std::array<std::byte, 4> kMagic = {std::byte{'M'}, std::byte{'C'}, std::byte{'S'},
+                                             std::byte{'B'}};
+
+enum class PropertyTag : std::uint8_t {
+    String = 0,
+    Double = 1,
+    Int64 = 2,
+    Bool = 3,
+};
+
+// --- Запись ---
+
+class BlobWriter {
+public:
+    auto put_u8(std::uint8_t value) -> void {
+        bytes_.push_back(static_cast<std::byte>(value));
+    }
+
+    auto put_varint(std::uint64_t value) -> void {
+        while (value >= 0x80U) {
+            put_u8(static_cast<std::uint8_t>(value | 0x80U));
+            value >>= 7U;
+        }
+        put_u8(static_cast<std::uint8_t>(value));
+    }
+
+    auto put_double(double value) -> void {
+        const auto bits = std::bit_cast<std::uint64_t>(value);
+        for (unsigned shift = 0; shift < 64; shift += 8) {
+            put_u8(static_cast<std::uint8_t>(bits >> shift));
+        }
+    }
+
+    auto put_bytes(std::span<const std::byte> bytes) -> void {
+        bytes_.insert(bytes_.end(), bytes.begin(), bytes.end());
+    }
+
+    [[nodiscard]] auto take() -> std::vector<std::byte> {
+        return std::move(bytes_);
+    }
+
+private:
+    std::vector<std::byte> bytes_;
+};
+
+/// @brief Таблица строк: повторяющиеся имена типов и ключи свойств пишутся один раз.
+class StringTable {
+public:
+    auto intern(std::string_view text) -> std::uint64_t {
+        const auto [it, inserted] = index_.try_emplace(text, strings_.size());
+        if (inserted) {
+            strings_.push_back(text);
+        }
+        return it->second;
+    }
+
+    auto write(BlobWriter& writer) const -> void {
+        writer.put_varint(strings_.size());
+        for (const auto text : strings_) {
+            writer.put_varint(text.size());
+            writer.put_bytes(std::as_bytes(std::span(text.data(), text.size())));
+        }
+    }
+
+private:
+    std::vector<std::string_view> strings_;
+    std::unordered_map<std::string_view, std::uint64_t> index_;
+};
+
+[[nodiscard]] auto zigzag_encode(std::int64_t value) noexcept -> std::uint64_t {
+    return (static_cast<std::uint64_t>(value) << 1U) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+[[nodiscard]] auto zigzag_decode(std::uint64_t value) noexcept -> std::int64_t {
+    return static_cast<std::int64_t>(value >> 1U) ^ -static_cast<std::int64_t>(value & 1U);
+}
+
+[[nodiscard]] auto port_ordinal(const Node& node, PortId port) -> std::uint64_t {
+    const auto ports = node.get_ports();
+    const auto it =
+        std::ranges::find_if(ports, [port](const Port& p) { return p.get_id() == port; });
+    return static_cast<std::uint64_t>(it - ports.begin());
+}
+
+[[nodiscard]] auto is_variable_node(const Node& node) -> bool {
+    const auto type = node.get_type();
+    return type.name == NodeTypes::GetVariable.name || type.name == NodeTypes::SetVariable.name;
+}
+
+// --- Чтение ---
+
+/// @brief Последовательное чтение с проверкой границ; выход за границу даёт nullopt.
+class BlobReader {
+public:
+    explicit BlobReader(std::span<const std::byte> bytes) noexcept : bytes_(bytes) {}
+
+    [[nodiscard]] auto get_u8() -> std::optional<std::uint8_t> {
+        if (offset_ >= bytes_.size()) {
+            return std::nullopt;
+        }
+        return static_cast<std::uint8_t>(bytes_[offset_++]);
+    }
+
+    [[nodiscard]] auto get_varint() -> std::optional<std::uint64_t> {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            const auto byte = get_u8();
+            if (!byte) {
+                return std::nullopt;
+            }
+            value |= static_cast<std::uint64_t>(*byte & 0x7FU) << shift;
+            if ((*byte & 0x80U) == 0) {
+                return value;
+            }
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] auto get_double() -> std::optional<double> {
+        if (remaining() < 8) {
+            return std::nullopt;
+        }
+        std::uint64_t bits = 0;
+        for (unsigned shift = 0; shift < 64; shift += 8) {
+            bits |= static_cast<std::uint64_t>(bytes_[offset_++]) << shift;
+        }
+        return std::bit_cast<double>(bits);
+    }
+
+    [[nodiscard]] auto get_bytes(std::size_t count) -> std::optional<std::span<const std::byte>> {
+        if (remaining() < count) {
+            return std::nullopt;
+        }
+        const auto slice = bytes_.subspan(offset_, count);
+        offset_ += count;
+        return slice;
+    }
+
+    /// @brief Счётчик элементов; каждый элемент занимает хотя бы байт, что отсекает
+    /// заведомо ложные размеры до reserve().
+    [[nodiscard]] auto get_count() -> std::optional<std::size_t> {
+        const auto count = get_varint();
+        if (!count || *count > remaining()) {
+            return std::nullopt;
+        }
+        return static_cast<std::size_t>(*count);
+    }
+
+    [[nodiscard]] auto offset() const noexcept -> std::size_t {
+        return offset_;
+    }
+
+    [[nodiscard]] auto remaining() const noexcept -> std::size_t {
+        return bytes_.size() - offset_;
+    }
+
+private:
+    std::span<const std::byte> bytes_;
+    std::size_t offset_{0};
+};
+
+struct DecodedLink {
+    std::uint64_t from_node;
+    std::uint64_t from_port;
+    std::uint64_t to_node;
+    std::uint64_t to_port;
+
+    [[nodiscard]] auto operator==(const DecodedLink& other) const noexcept -> bool = default;
+};
+
+struct DecodedLinkHash {
+    [[nodiscard]] auto operator()(const DecodedLink& link) const noexcept -> std::size_t {
+        std::size_t seed = 0;
+        for (const auto value : {link.from_node, link.from_port, link.to_node, link.to_port}) {
+            seed ^= std::hash<std::uint64_t>{}(value) + 0x9e3779b9 + (seed << 6U) + (seed >> 2U);
+        }
+        return seed;
+    }
+};
+
+/// @brief Разобранный блоб: готовые узлы (ещё вне графа), связи по номерам и переменные.
+struct DecodedSelection {
+    std::vector<Variable> variables;
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::vector<DecodedLink> links;
+};
+
+[[nodiscard]] auto malformed(const BlobReader& reader, std::string_view what) -> Error {
+    return Error{format("Clipboard blob is malformed at offset ", reader.offset(), ": ", what),
+                 error_codes::clipboard::MalformedBlob};
+}
+
+[[nodiscard]] auto find_runtime_type(std::string_view name) -> const NodeType* {
+    for (const auto* type : NodeTypes::CoreRuntimeNodeTypes) {
+        if (type->name == name) {
+            return type;
+        }
+    }
+    return nullptr;
+}
+
+[[nodiscard]] auto decode_property(BlobReader& reader,
+                                   std::span<const std::string_view> strings)
+    -> std::optional<NodeProperty> {
+    const auto tag = reader.get_u8();
+    if (!tag) {
+        return std::nullopt;
+    }
+    switch (static_cast<PropertyTag>(*tag)) {
+        case PropertyTag::String:
+            if (const auto index = reader.get_varint(); index && *index < strings.size()) {
+                return NodeProperty{std::string(strings[*index])};
+            }
+            return std::nullopt;
+        case PropertyTag::Double:
+            if (const auto value = reader.get_double()) {
+                return NodeProperty{*value};
+            }
+            return std::nullopt;
+        case PropertyTag::Int64:
+            if (const auto value = reader.get_varint()) {
+                return NodeProperty{zigzag_decode(*value)};
+            }
+            return std::nullopt;
+        case PropertyTag::Bool:
+            if (const auto value = reader.get_u8(); value && *value <= 1) {
+                return NodeProperty{*value == 1};
+            }
+            return std::nullopt;
+    }
+    return std::nullopt;
+}
+
+// Вход/выход: разбирает весь блоб в DecodedSelection; граф не трогается.
+// Edge cases: усечённый блоб, индексы строк вне таблицы, неизвестный тип узла, мусор в хвосте.
+// Почему так: узлы создаются фабрикой сразу с новыми NodeId/PortId — это и есть перенумерация,
+// а связи в блобе адресуют узлы и порты порядковыми номерами и не требуют таблиц соответствия.
+[[nodiscard]] auto decode(std::span<const std::byte> blob) -> Result<DecodedSelection> {
+    BlobReader reader(blob);
+    const auto magic = reader.get_bytes(kMagic.size());
+    if (!magic || !std::ranges::equal(*magic, kMagic)) {
+        return Result<DecodedSelection>(malformed(reader, "missing magic"));
+    }
+    const auto version = reader.get_u8();
+    if (!version || *version != SelectionClipboard::kFormatVersion) {
+        return Result<DecodedSelection>(
+            Error{format("Unsupported clipboard format version ", version.value_or(0)),
+                  error_codes::clipboard::UnsupportedVersion});
+    }
+
+    const auto string_count = reader.get_count();
+    if (!string_count) {
+        return Result<DecodedSelection>(malformed(reader, "bad string table size"));
+    }
+    std::vector<std::string_view> strings;
+    strings.reserve(*string_count);
+    for (std::size_t i = 0; i < *string_count; ++i) {
+        const auto length = reader.get_varint();
+        const auto bytes = length ? reader.get_bytes(*length) : std::nullopt;
+        if (!bytes) {
+            return Result<DecodedSelection>(malformed(reader, "truncated string"));
+        }
+        strings.emplace_back(reinterpret_cast<const char*>(bytes->data()), bytes->size());
+    }
+    const auto get_string = [&]() -> std::optional<std::string_view> {
+        if (const auto index = reader.get_varint(); index && *index < strings.size()) {
+            return strings[*index];
+        }
+        return std::nullopt;
+    };
+
+    DecodedSelection selection;
+
+    const auto variable_count = reader.get_count();
+    if (!variable_count) {
+        return Result<DecodedSelection>(malformed(reader, "bad variable count"));
+    }
+    selection.variables.reserve(*variable_count);
+    for (std::size_t i = 0; i < *variable_count; ++i) {
+        const auto name = get_string();
+        const auto type = reader.get_u8();
+        if (!name || !type || *type > static_cast<std::uint8_t>(DataType::Unknown)) {
+            return Result<DecodedSelection>(malformed(reader, "bad variable record"));
+        }
+        selection.variables.push_back(
+            Variable{std::string(*name), static_cast<DataType>(*type)});
+    }
+
+    const auto node_count = reader.get_count();
+    if (!node_count) {
+        return Result<DecodedSelection>(malformed(reader, "bad node count"));
+    }
+    selection.nodes.reserve(*node_count);
+    for (std::size_t i = 0; i < *node_count; ++i) {
+        const auto type_name = get_string();
+        const auto instance_name = get_string();
+        const auto property_count = reader.get_count();
+        if (!type_name || !instance_name || !property_count) {
+            return Result<DecodedSelection>(malformed(reader, "bad node record"));
+        }
+        const auto* type = find_runtime_type(*type_name);
+        if (type == nullptr) {
+            return Result<DecodedSelection>(
+                Error{format("Clipboard node ", i, " has unknown type '", *type_name, "'"),
+                      error_codes::clipboard::UnknownNodeType});
+        }
+
+        auto node = NodeFactory::create(*type, std::string(*instance_name));
+        for (std::size_t p = 0; p < *property_count; ++p) {
+            const auto key = get_string();
+            auto value = key ? decode_property(reader, strings) : std::nullopt;
+            if (!value) {
+                return Result<DecodedSelection>(malformed(reader, "bad property record"));
+            }
+            std::visit([&](auto&& v) { node->set_property(std::string(*key), std::move(v)); },
+                       std::move(*value));
+        }
+        selection.nodes.push_back(std::move(node));
+    }
+
+    const auto link_count = reader.get_count();
+    if (!link_count) {
+        return Result<DecodedSelection>(malformed(reader, "bad connection count"));
+    }
+    selection.links.reserve(*link_count);
+    for (std::size_t i = 0; i < *link_count; ++i) {
+        const auto from_node = reader.get_varint();
+        const auto from_port = reader.get_varint();
+        const auto to_node = reader.get_varint();
+        const auto to_port = reader.get_varint();
+        if (!from_node || !from_port || !to_node || !to_port) {
+            return Result<DecodedSelection>(malformed(reader, "truncated connection"));
+        }
+        selection.links.push_back(DecodedLink{.from_node = *from_node,
+                                              .from_port = *from_port,
+                                              .to_node = *to_node,
+                                              .to_port = *to_port});
+    }
+
+    if (reader.remaining() != 0) {
+        return Result<DecodedSelection>(malformed(reader, "trailing bytes"));
+    }
+    return Result<DecodedSelection>(std::move(selection));
+}
+
+// Единственный проход проверки связей: все концы — узлы из блоба, поэтому достаточно
+// проверить номера, совместимость портов и дубликаты внутри блоба, без поиска по графу.
+[[nodiscard]] auto validate_links(const DecodedSelection& selection) -> Result<void> {
+    std::unordered_set<DecodedLink, DecodedLinkHash> seen;
+    seen.reserve(selection.links.size());
+    const auto node_count = selection.nodes.size();
+
+    for (std::size_t i = 0; i < selection.links.size(); ++i) {
+        const auto& link = selection.links[i];
+        const auto invalid = [i](std::string_view what) {
+            return Result<void>(Error{format("Clipboard connection ", i, ": ", what),
+                                      error_codes::clipboard::InvalidConnection});
+        };
+        if (link.from_node >= node_count || link.to_node >= node_count) {
+            return invalid("node index out of range");
+        }
+        if (link.from_node == link.to_node) {
+            return invalid("self-connection");
+        }
+        const auto from_ports = selection.nodes[link.from_node]->get_ports();
+        const auto to_ports = selection.nodes[link.to_node]->get_ports();
+        if (link.from_port >= from_ports.size() || link.to_port >= to_ports.size()) {
+            return invalid("port index out of range");
+        }
+        const auto& from_port = from_ports[link.from_port];
+        const auto& to_port = to_ports[link.to_port];
+        if (!from_port.is_output() || !to_port.is_input() || !from_port.can_connect_to(to_port)) {
+            return invalid("incompatible ports");
+        }
+        if (!seen.insert(link).second) {
+            return invalid("duplicate connection");
+        }
+    }
+    return Result<void>();
+}
+
+}  // namespace
+
+// Вход/выход: выделение → блоб; неизвестный NodeId в выделении — ошибка.
+// Edge cases: связи с узлами вне выделения отбрасываются; переменная, на которую ссылается
+// узел, но которой нет в графе, не пишется (вставка повторит исходное состояние).
+auto SelectionClipboard::copy(const Graph& graph, std::span<const NodeId> selection)
+    -> Result<std::vector<std::byte>> {
+    std::unordered_set<NodeId> selected;
+    selected.reserve(selection.size());
+    for (const auto id : selection) {
+        if (!graph.has_node(id)) {
+            return Result<std::vector<std::byte>>(
+                Error{format("Selected node ", id.value, " does not exist"),
+                      error_codes::clipboard::InvalidSelection});
+        }
+        selected.insert(id);
+    }
+
+    std::vector<const Node*> nodes;
+    nodes.reserve(selected.size());
+    std::unordered_map<NodeId, std::uint64_t> ordinals;
+    ordinals.reserve(selected.size());
+    for (const auto& node : graph.get_nodes()) {
+        if (selected.contains(node->get_id())) {
+            ordinals.emplace(node->get_id(), nodes.size());
+            nodes.push_back(node.get());
+        }
+    }
+
+    StringTable strings;
+    BlobWriter body;
+
+    std::vector<const Variable*> variables;
+    std::unordered_set<std::string_view> seen_variables;
+    for (const auto* node : nodes) {
+        if (!is_variable_node(*node)) {
+            continue;
+        }
+        const auto& properties = node->get_all_properties();
+        const auto it = properties.find("variable_name");
+        const auto* name = it != properties.end() ? std::get_if<std::string>(&it->second) : nullptr;
+        if (name == nullptr || !seen_variables.insert(*name).second) {
+            continue;
+        }
+        for (const auto& variable : graph.get_variables()) {
+            if (variable.name == *name) {
+                variables.push_back(&variable);
+                break;
+            }
+        }
+    }
+    body.put_varint(variables.size());
+    for (const auto* variable : variables) {
+        body.put_varint(strings.intern(variable->name));
+        body.put_u8(static_cast<std::uint8_t>(variable->type));
+    }
+
+    body.put_varint(nodes.size());
+    for (const auto* node : nodes) {
+        body.put_varint(strings.intern(node->get_type().name));
+        body.put_varint(strings.intern(node->get_instance_name()));
+        const auto& properties = node->get_all_properties();
+        body.put_varint(properties.size());
+        for (const auto& [key, value] : properties) {
+            body.put_varint(strings.intern(key));
+            std::visit(
+                [&](const auto& v) {
+                    using T = std::decay_t<decltype(v)>;
+                    if constexpr (std::is_same_v<T, std::string>) {
+                        body.put_u8(static_cast<std::uint8_t>(PropertyTag::String));
+                        body.put_varint(strings.intern(v));
+                    } else if constexpr (std::is_same_v<T, double>) {
+                        body.put_u8(static_cast<std::uint8_t>(PropertyTag::Double));
+                        body.put_double(v);
+                    } else if constexpr (std::is_same_v<T, std::int64_t>) {
+                        body.put_u8(static_cast<std::uint8_t>(PropertyTag::Int64));
+                        body.put_varint(zigzag_encode(v));
+                    } else {
+                        body.put_u8(static_cast<std::uint8_t>(PropertyTag::Bool));
+                        body.put_u8(v ? 1 : 0);
+                    }
+                },
+                value);
+        }
+    }
+
+    std::vector<const Connection*> links;
+    for (const auto* node : nodes) {
+        for (const auto connection_id : graph.outgoing(node->get_id())) {
+            const auto* connection = graph.get_connection(connection_id);
+            if (connection != nullptr && ordinals.contains(connection->to_node)) {
+                links.push_back(connection);
+            }
+        }
+    }
+    body.put_varint(links.size());
+    for (const auto* connection : links) {
+        body.put_varint(ordinals.at(connection->from_node));
+        const auto& from_node = *graph.get_node(connection->from_node);
+        const auto& to_node = *graph.get_node(connection->to_node);
+        body.put_varint(port_ordinal(from_node, connection->from_port));
+        body.put_varint(ordinals.at(connection->to_node));
+        body.put_varint(port_ordinal(to_node, connection->to_port));
+    }
+
+    BlobWriter blob;
+    blob.put_bytes(kMagic);
+    blob.put_u8(kFormatVersion);
+    strings.write(blob);
+    const auto payload = body.take();
+    blob.put_bytes(payload);
+    return Result<std::vector<std::byte>>(blob.take());
+}
+
+// Вход/выход: блоб → новые узлы/связи в graph; при ошибке граф не изменяется.
+// Edge cases: переменная с тем же именем и типом переиспользуется, с другим типом — ошибка.
+// Почему так: проверка идёт до мутаций, поэтому вставка обходит Graph::connect() с его
+// поиском дубликатов по всем связям графа и стоит O(размер блоба), а не O(связей графа).
+auto SelectionClipboard::paste(Graph& graph, std::span<const std::byte> blob)
+    -> Result<PasteResult> {
+    auto decoded = decode(blob);
+    if (!decoded) {
+        return Result<PasteResult>(decoded.error());
+    }
+    auto& selection = decoded.value();
+    if (auto result = validate_links(selection); !result) {
+        return Result<PasteResult>(result.error());
+    }
+
+    std::vector<const Variable*> missing_variables;
+    for (const auto& variable : selection.variables) {
+        const auto existing = graph.get_variables();
+        const auto it = std::ranges::find_if(
+            existing, [&](const Variable& v) { return v.name == variable.name; });
+        if (it == existing.end()) {
+            missing_variables.push_back(&variable);
+        } else if (it->type != variable.type) {
+            return Result<PasteResult>(
+                Error{format("Variable '", variable.name, "' already exists with another type"),
+                      error_codes::clipboard::VariableTypeConflict});
+        }
+    }
+
+    PasteResult pasted;
+    pasted.nodes.reserve(selection.nodes.size());
+    pasted.connections.reserve(selection.links.size());
+
+    graph.nodes_.reserve(graph.nodes_.size() + selection.nodes.size());
+    graph.node_lookup_.reserve(graph.node_lookup_.size() + selection.nodes.size());
+    graph.connections_.reserve(graph.connections_.size() + selection.links.size());
+    graph.connection_lookup_.reserve(graph.connection_lookup_.size() + selection.links.size());
+
+    graph.begin_edit_group();
+    for (const auto* variable : missing_variables) {
+        [[maybe_unused]] auto result = graph.add_variable(variable->name, variable->type);
+    }
+
+    std::vector<const Node*> placed;
+    placed.reserve(selection.nodes.size());
+    for (auto& node : selection.nodes) {
+        const auto node_id = node->get_id();
+        placed.push_back(node.get());
+        graph.attach_node(std::move(node), graph.nodes_.size());
+        graph.record(NodeAddedEdit{
+            .node = node_id, .position = graph.nodes_.size() - 1, .detached = nullptr});
+        pasted.nodes.push_back(node_id);
+    }
+
+    for (const auto& link : selection.links) {
+        const auto& from_port = placed[link.from_node]->get_ports()[link.from_port];
+        const Connection connection{
+            .id = graph.generate_connection_id(),
+            .from_node = placed[link.from_node]->get_id(),
+            .from_port = from_port.get_id(),
+            .to_node = placed[link.to_node]->get_id(),
+            .to_port = placed[link.to_node]->get_ports()[link.to_port].get_id(),
+            .type = from_port.is_execution() ? ConnectionType::Execution : ConnectionType::Data};
+        graph.insert_connection(connection);
+        graph.record(ConnectionAddedEdit{connection});
+        pasted.connections.push_back(connection.id);
+    }
+    graph.end_edit_group();
+
+    return Result<PasteResult>(std::move(pasted));
+}
+
+}  // namespace visprog::core
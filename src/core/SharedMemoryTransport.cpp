@@ -0,0 +1,444 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include "visprog/core/SharedMemoryTransport.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/FormatCompat.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MULTICODE_HAS_POSIX_SHM 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+namespace visprog::core {
+
+/// @brief Служебные поля кольца; head и tail на разных кеш-линиях, чтобы писатель
+/// и читатель не делили линию.
+struct SharedRing::Header {
+    alignas(64) std::atomic<std::uint64_t> head{0};
+    alignas(64) std::atomic<std::uint64_t> tail{0};
+    alignas(64) std::atomic<std::uint32_t> sequence{0};
+    std::atomic<std::uint32_t> waiters{0};
+};
+
+namespace {
+
+using compat::format;
+
+constexpr std::uint32_t kSegmentMagic = 0x4D43524Eu;  // "MCRN"
+constexpr std::uint32_t kSegmentVersion = 1;
+constexpr std::size_t kMinRingCapacity = 4096;
+constexpr std::size_t kFrameHeaderSize = 8;
+constexpr std::uint16_t kWrapKind = 0xFFFF;
+constexpr std::size_t kCacheLine = 64;
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "shared-memory rings need lock-free 64-bit atomics");
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+static_assert(std::atomic_ref<std::uint32_t>::is_always_lock_free);
+
+struct SegmentHeader {
+    std::uint32_t magic{0};
+    std::uint32_t version{0};
+    std::uint64_t ring_capacity{0};
+};
+
+/// @brief Заголовок кадра в кольце; payload выровнен на 8 байт.
+struct FrameHeader {
+    std::uint32_t size{0};
+    std::uint16_t kind{0};
+    std::uint16_t reserved{0};
+};
+static_assert(sizeof(FrameHeader) == kFrameHeaderSize);
+
+[[nodiscard]] constexpr auto align_up(std::size_t value, std::size_t alignment) -> std::size_t {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+[[nodiscard]] constexpr auto frame_size(std::size_t payload) -> std::size_t {
+    return kFrameHeaderSize + align_up(payload, kFrameHeaderSize);
+}
+
+auto write_frame(std::byte* at, std::uint32_t size, std::uint16_t kind) -> void {
+    const FrameHeader frame{.size = size, .kind = kind, .reserved = 0};
+    std::memcpy(at, &frame, sizeof(frame));
+}
+
+[[nodiscard]] auto read_frame(const std::byte* at) -> FrameHeader {
+    FrameHeader frame;
+    std::memcpy(&frame, at, sizeof(frame));
+    return frame;
+}
+
+[[nodiscard]] constexpr auto is_known_kind(std::uint16_t kind) noexcept -> bool {
+    return kind == static_cast<std::uint16_t>(TransportMessageKind::EditCommand) ||
+           kind == static_cast<std::uint16_t>(TransportMessageKind::GeneratedCode) ||
+           kind == static_cast<std::uint16_t>(TransportMessageKind::Diagnostics);
+}
+
+}  // namespace
+
+// ============================================================================
+// SharedRing
+// ============================================================================
+
+auto SharedRing::header_size() noexcept -> std::size_t {
+    return align_up(sizeof(Header), kCacheLine);
+}
+
+auto SharedRing::max_message_size() const noexcept -> std::size_t {
+    return capacity_ / 2 - kFrameHeaderSize;
+}
+
+auto SharedRing::free_space() const noexcept -> std::size_t {
+    const auto head = header_->head.load(std::memory_order_relaxed);
+    const auto tail = header_->tail.load(std::memory_order_acquire);
+    return capacity_ - static_cast<std::size_t>(head - tail);
+}
+
+// Вход/выход: окно под payload прямо в кольце; nullopt — места нет или сообщение больше
+// max_message_size().
+// Edge cases: кадр не разрезается на конце буфера — остаток хвоста закрывается кадром-
+// пропуском, и payload всегда непрерывен для чтения без копии.
+auto SharedRing::reserve(TransportMessageKind kind, std::size_t size)
+    -> std::optional<std::span<std::byte>> {
+    if (size > max_message_size()) {
+        return std::nullopt;
+    }
+    const auto frame = frame_size(size);
+    const auto head = header_->head.load(std::memory_order_relaxed);
+    auto offset = static_cast<std::size_t>(head & (capacity_ - 1));
+    const auto contiguous = capacity_ - offset;
+    const auto skip = frame > contiguous ? contiguous : 0;
+    if (frame + skip > free_space()) {
+        return std::nullopt;
+    }
+
+    auto start = head;
+    if (skip != 0) {
+        write_frame(data_ + offset,
+                    static_cast<std::uint32_t>(contiguous - kFrameHeaderSize),
+                    kWrapKind);
+        start += skip;
+        offset = 0;
+    }
+    write_frame(data_ + offset, static_cast<std::uint32_t>(size), static_cast<std::uint16_t>(kind));
+    pending_head_ = start + frame;
+    return std::span<std::byte>{data_ + offset + kFrameHeaderSize, size};
+}
+
+auto SharedRing::commit() -> void {
+    header_->head.store(pending_head_, std::memory_order_release);
+    notify();
+}
+
+auto SharedRing::write(TransportMessageKind kind, std::span<const std::byte> payload) -> bool {
+    const auto window = reserve(kind, payload.size());
+    if (!window) {
+        return false;
+    }
+    std::ranges::copy(payload, window->begin());
+    commit();
+    return true;
+}
+
+// Вход/выход: первый кадр между tail и head; кадры-пропуски освобождаются сразу.
+// Edge cases: кадр, выходящий за конец буфера или за опубликованный head, и кадр
+// неизвестного вида помечают кольцо повреждённым — peek() больше ничего не возвращает.
+// Почему так: сегмент пишет другой процесс, и без проверки испорченный size дал бы span
+// за пределами отображения, а tail ушёл бы в произвольное место кольца.
+auto SharedRing::peek() -> std::optional<TransportMessage> {
+    if (corrupted_) {
+        return std::nullopt;
+    }
+    auto tail = header_->tail.load(std::memory_order_relaxed);
+    const auto head = header_->head.load(std::memory_order_acquire);
+    while (tail != head) {
+        const auto offset = static_cast<std::size_t>(tail & (capacity_ - 1));
+        const auto frame = read_frame(data_ + offset);
+        const auto room = capacity_ - offset - kFrameHeaderSize;
+        const auto published = static_cast<std::size_t>(head - tail);
+        if (frame.kind == kWrapKind) {
+            if (frame.size != room || capacity_ - offset > published) {
+                corrupted_ = true;
+                return std::nullopt;
+            }
+            tail += capacity_ - offset;
+            header_->tail.store(tail, std::memory_order_release);
+            notify();
+            continue;
+        }
+        if (frame.size > room || frame_size(frame.size) > published || !is_known_kind(frame.kind)) {
+            corrupted_ = true;
+            return std::nullopt;
+        }
+        pending_tail_ = tail + frame_size(frame.size);
+        return TransportMessage{
+            .kind = static_cast<TransportMessageKind>(frame.kind),
+            .payload = {data_ + offset + kFrameHeaderSize, frame.size},
+        };
+    }
+    return std::nullopt;
+}
+
+auto SharedRing::release() -> void {
+    if (pending_tail_ > header_->tail.load(std::memory_order_relaxed)) {
+        header_->tail.store(pending_tail_, std::memory_order_release);
+        notify();
+    }
+}
+
+// Пробуждение — системный вызов, поэтому делается только если кто-то ждёт
+auto SharedRing::notify() const -> void {
+    header_->sequence.fetch_add(1);
+    if (header_->waiters.load() == 0) {
+        return;
+    }
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&header_->sequence), FUTEX_WAKE, INT_MAX,
+            nullptr, nullptr, 0);
+#endif
+}
+
+// Вход/выход: ждёт, пока ready() не станет true, не дольше timeout.
+// Почему так: ждущий регистрируется в waiters до повторной проверки ready(), а futex
+// засыпает, только если sequence не изменился, — публикация между проверкой и сном не
+// теряется.
+auto SharedRing::wait_until(std::chrono::milliseconds timeout, auto&& ready) const -> bool {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        if (ready()) {
+            return true;
+        }
+        header_->waiters.fetch_add(1);
+        const auto sequence = header_->sequence.load();
+        if (ready()) {
+            header_->waiters.fetch_sub(1);
+            return true;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            header_->waiters.fetch_sub(1);
+            return false;
+        }
+#if defined(__linux__)
+        const auto remaining =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+        timespec relative{.tv_sec = static_cast<time_t>(remaining / 1'000'000'000),
+                          .tv_nsec = static_cast<long>(remaining % 1'000'000'000)};
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&header_->sequence), FUTEX_WAIT,
+                sequence, &relative, nullptr, 0);
+#else
+        (void)sequence;
+        std::this_thread::sleep_for(
+            std::min<std::chrono::steady_clock::duration>(deadline - now,
+                                                          std::chrono::milliseconds(1)));
+#endif
+        header_->waiters.fetch_sub(1);
+    }
+}
+
+auto SharedRing::wait_readable(std::chrono::milliseconds timeout) const -> bool {
+    return wait_until(timeout, [this] {
+        return header_->head.load(std::memory_order_acquire) !=
+               header_->tail.load(std::memory_order_relaxed);
+    });
+}
+
+auto SharedRing::wait_writable(std::size_t size, std::chrono::milliseconds timeout) const
+    -> bool {
+    // С запасом на кадр-пропуск у конца буфера: столько места хватает при любом head
+    const auto needed = 2 * frame_size(size);
+    return wait_until(timeout, [this, needed] { return free_space() >= needed; });
+}
+
+// ============================================================================
+// SharedMemoryTransport
+// ============================================================================
+
+namespace {
+
+[[nodiscard]] auto shm_name(const std::string& name) -> std::string {
+    return name.starts_with('/') ? name : "/" + name;
+}
+
+}  // namespace
+
+// Раскладка сегмента: [SegmentHeader][Header кольца к ядру][данные][Header кольца к хосту][данные]
+auto SharedMemoryTransport::segment_size(std::size_t capacity) noexcept -> std::size_t {
+    return kCacheLine + 2 * (SharedRing::header_size() + capacity);
+}
+
+SharedMemoryTransport::SharedMemoryTransport(SharedMemoryTransport&& other) noexcept
+    : name_(std::move(other.name_)),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      descriptor_(std::exchange(other.descriptor_, -1)),
+      owner_(std::exchange(other.owner_, false)),
+      to_core_(other.to_core_),
+      to_host_(other.to_host_) {}
+
+SharedMemoryTransport& SharedMemoryTransport::operator=(SharedMemoryTransport&& other) noexcept {
+    if (this != &other) {
+        close();
+        name_ = std::move(other.name_);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapping_size_ = std::exchange(other.mapping_size_, 0);
+        descriptor_ = std::exchange(other.descriptor_, -1);
+        owner_ = std::exchange(other.owner_, false);
+        to_core_ = other.to_core_;
+        to_host_ = other.to_host_;
+    }
+    return *this;
+}
+
+SharedMemoryTransport::~SharedMemoryTransport() {
+    close();
+}
+
+auto SharedMemoryTransport::map_rings() -> void {
+    auto* base = static_cast<std::byte*>(mapping_);
+    const auto* segment = std::launder(reinterpret_cast<const SegmentHeader*>(base));
+    const auto capacity = static_cast<std::size_t>(segment->ring_capacity);
+    auto* first = base + kCacheLine;
+    auto* second = first + SharedRing::header_size() + capacity;
+    to_core_ = SharedRing(std::launder(reinterpret_cast<SharedRing::Header*>(first)),
+                          first + SharedRing::header_size(), capacity);
+    to_host_ = SharedRing(std::launder(reinterpret_cast<SharedRing::Header*>(second)),
+                          second + SharedRing::header_size(), capacity);
+}
+
+auto SharedMemoryTransport::close() noexcept -> void {
+#if defined(MULTICODE_HAS_POSIX_SHM)
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mapping_size_);
+        mapping_ = nullptr;
+    }
+    if (descriptor_ >= 0) {
+        ::close(descriptor_);
+        descriptor_ = -1;
+    }
+    if (owner_) {
+        shm_unlink(name_.c_str());
+        owner_ = false;
+    }
+#endif
+}
+
+// Вход/выход: новый сегмент с двумя пустыми кольцами ёмкостью ring_capacity (степень двойки).
+// Edge cases: сегмент с тем же именем уже есть — ошибка (O_EXCL), чужой сегмент не
+// перезаписывается.
+auto SharedMemoryTransport::create(const std::string& name, std::size_t ring_capacity)
+    -> Result<SharedMemoryTransport> {
+#if defined(MULTICODE_HAS_POSIX_SHM)
+    const auto capacity = std::bit_ceil(std::max(ring_capacity, kMinRingCapacity));
+    SharedMemoryTransport transport;
+    transport.name_ = shm_name(name);
+    transport.mapping_size_ = segment_size(capacity);
+
+    transport.descriptor_ = shm_open(transport.name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (transport.descriptor_ < 0) {
+        return Result<SharedMemoryTransport>(
+            Error{format("shm_open('", transport.name_, "') failed: ", std::strerror(errno)),
+                  error_codes::transport::SharedMemoryFailed});
+    }
+    transport.owner_ = true;
+    if (ftruncate(transport.descriptor_, static_cast<off_t>(transport.mapping_size_)) != 0) {
+        return Result<SharedMemoryTransport>(
+            Error{format("Cannot size '", transport.name_, "': ", std::strerror(errno)),
+                  error_codes::transport::SharedMemoryFailed});
+    }
+    transport.mapping_ = mmap(nullptr, transport.mapping_size_, PROT_READ | PROT_WRITE,
+                              MAP_SHARED, transport.descriptor_, 0);
+    if (transport.mapping_ == MAP_FAILED) {
+        transport.mapping_ = nullptr;
+        return Result<SharedMemoryTransport>(
+            Error{format("Cannot map '", transport.name_, "': ", std::strerror(errno)),
+                  error_codes::transport::SharedMemoryFailed});
+    }
+
+    auto* base = static_cast<std::byte*>(transport.mapping_);
+    new (base + kCacheLine) SharedRing::Header{};
+    new (base + kCacheLine + SharedRing::header_size() + capacity) SharedRing::Header{};
+    // Заголовок сегмента пишется последним: open() не примет наполовину созданный сегмент
+    // magic публикуется release-записью: open() в другом процессе, увидевший magic через
+    // acquire, видит и готовые заголовки колец
+    auto* segment = new (base) SegmentHeader{.magic = 0,
+                                             .version = kSegmentVersion,
+                                             .ring_capacity = capacity};
+    std::atomic_ref<std::uint32_t>(segment->magic).store(kSegmentMagic, std::memory_order_release);
+    transport.map_rings();
+    return Result<SharedMemoryTransport>(std::move(transport));
+#else
+    (void)name;
+    (void)ring_capacity;
+    return Result<SharedMemoryTransport>(Error{"Shared-memory transport requires POSIX shm",
+                                               error_codes::transport::Unsupported});
+#endif
+}
+
+auto SharedMemoryTransport::open(const std::string& name) -> Result<SharedMemoryTransport> {
+#if defined(MULTICODE_HAS_POSIX_SHM)
+    SharedMemoryTransport transport;
+    transport.name_ = shm_name(name);
+    transport.descriptor_ = shm_open(transport.name_.c_str(), O_RDWR, 0600);
+    if (transport.descriptor_ < 0) {
+        return Result<SharedMemoryTransport>(
+            Error{format("shm_open('", transport.name_, "') failed: ", std::strerror(errno)),
+                  error_codes::transport::SharedMemoryFailed});
+    }
+    struct stat info {};
+    if (fstat(transport.descriptor_, &info) != 0 ||
+        static_cast<std::size_t>(info.st_size) < kCacheLine) {
+        return Result<SharedMemoryTransport>(
+            Error{format("'", transport.name_, "' is not a transport segment"),
+                  error_codes::transport::InvalidSegment});
+    }
+    transport.mapping_size_ = static_cast<std::size_t>(info.st_size);
+    transport.mapping_ = mmap(nullptr, transport.mapping_size_, PROT_READ | PROT_WRITE,
+                              MAP_SHARED, transport.descriptor_, 0);
+    if (transport.mapping_ == MAP_FAILED) {
+        transport.mapping_ = nullptr;
+        return Result<SharedMemoryTransport>(
+            Error{format("Cannot map '", transport.name_, "': ", std::strerror(errno)),
+                  error_codes::transport::SharedMemoryFailed});
+    }
+
+    auto* header = std::launder(reinterpret_cast<SegmentHeader*>(transport.mapping_));
+    const auto magic =
+        std::atomic_ref<std::uint32_t>(header->magic).load(std::memory_order_acquire);
+    const auto capacity = static_cast<std::size_t>(header->ring_capacity);
+    if (magic != kSegmentMagic || header->version != kSegmentVersion ||
+        !std::has_single_bit(capacity) || segment_size(capacity) != transport.mapping_size_) {
+        return Result<SharedMemoryTransport>(
+            Error{format("'", transport.name_, "' is not a transport segment"),
+                  error_codes::transport::InvalidSegment});
+    }
+    transport.map_rings();
+    return Result<SharedMemoryTransport>(std::move(transport));
+#else
+    (void)name;
+    return Result<SharedMemoryTransport>(Error{"Shared-memory transport requires POSIX shm",
+                                               error_codes::transport::Unsupported});
+#endif
+}
+
+}  // namespace visprog::core
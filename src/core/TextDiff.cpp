@@ -0,0 +1,302 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include "visprog/core/TextDiff.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/FormatCompat.hpp"
+
+namespace visprog::core {
+
+namespace {
+
+using compat::format;
+using Index = std::ptrdiff_t;
+
+/// @brief Нижняя граница предела шагов поиска середины (как too_expensive в GNU diff).
+constexpr Index kMinSearchCost = 4096;
+
+/// @brief Строки текста вместе с переводом строки; последняя может быть без него.
+[[nodiscard]] auto split_lines(std::string_view text) -> std::vector<std::string_view> {
+    std::vector<std::string_view> lines;
+    std::size_t start = 0;
+    while (start < text.size()) {
+        const auto end = text.find('\n', start);
+        const auto next = end == std::string_view::npos ? text.size() : end + 1;
+        lines.push_back(text.substr(start, next - start));
+        start = next;
+    }
+    return lines;
+}
+
+// Вход/выход: множества удалённых строк a и вставленных строк b (флаги по индексам).
+// Edge cases: участок, середину которого не удалось найти за max_cost шагов, целиком
+// становится одной заменой — результат уже не минимален, зато время O((N + M) · max_cost).
+// Почему так: строки заранее заменены целочисленными id, поэтому сравнение в змеях — одно
+// сравнение чисел; массивы диагоналей выделяются один раз на N + M + 3 элемента, и вся
+// рекурсия укладывается в линейную память.
+class MyersDiff {
+public:
+    MyersDiff(const std::vector<std::uint32_t>& a,
+              const std::vector<std::uint32_t>& b,
+              std::size_t max_cost)
+        : a_(a),
+          b_(b),
+          deleted_(a.size(), false),
+          inserted_(b.size(), false),
+          offset_(static_cast<Index>(b.size()) + 1),
+          max_cost_(max_cost != 0 ? static_cast<Index>(max_cost) : default_cost(a, b)),
+          forward_(a.size() + b.size() + 3),
+          backward_(a.size() + b.size() + 3) {}
+
+    auto run() -> void {
+        compare(0, static_cast<Index>(a_.size()), 0, static_cast<Index>(b_.size()));
+    }
+
+    [[nodiscard]] auto deleted() const noexcept -> const std::vector<bool>& {
+        return deleted_;
+    }
+    [[nodiscard]] auto inserted() const noexcept -> const std::vector<bool>& {
+        return inserted_;
+    }
+
+private:
+    struct Split {
+        Index x{0};
+        Index y{0};
+    };
+
+    // Около 2·sqrt(N + M), но не меньше kMinSearchCost — та же оценка, что в GNU diff
+    [[nodiscard]] static auto default_cost(const std::vector<std::uint32_t>& a,
+                                           const std::vector<std::uint32_t>& b) -> Index {
+        Index cost = 1;
+        for (auto diagonals = a.size() + b.size() + 3; diagonals != 0; diagonals >>= 2U) {
+            cost <<= 1;
+        }
+        return std::max(cost, kMinSearchCost);
+    }
+
+    [[nodiscard]] auto same(Index x, Index y) const -> bool {
+        return a_[static_cast<std::size_t>(x)] == b_[static_cast<std::size_t>(y)];
+    }
+    [[nodiscard]] auto fd(Index diagonal) -> Index& {
+        return forward_[static_cast<std::size_t>(diagonal + offset_)];
+    }
+    [[nodiscard]] auto bd(Index diagonal) -> Index& {
+        return backward_[static_cast<std::size_t>(diagonal + offset_)];
+    }
+
+    auto compare(Index a_lo, Index a_hi, Index b_lo, Index b_hi) -> void {
+        while (a_lo < a_hi && b_lo < b_hi && same(a_lo, b_lo)) {
+            ++a_lo;
+            ++b_lo;
+        }
+        while (a_lo < a_hi && b_lo < b_hi && same(a_hi - 1, b_hi - 1)) {
+            --a_hi;
+            --b_hi;
+        }
+        if (a_lo == a_hi) {
+            for (auto y = b_lo; y < b_hi; ++y) {
+                inserted_[static_cast<std::size_t>(y)] = true;
+            }
+            return;
+        }
+        if (b_lo == b_hi) {
+            for (auto x = a_lo; x < a_hi; ++x) {
+                deleted_[static_cast<std::size_t>(x)] = true;
+            }
+            return;
+        }
+        const auto split = middle_snake(a_lo, a_hi, b_lo, b_hi);
+        if (!split) {
+            for (auto x = a_lo; x < a_hi; ++x) {
+                deleted_[static_cast<std::size_t>(x)] = true;
+            }
+            for (auto y = b_lo; y < b_hi; ++y) {
+                inserted_[static_cast<std::size_t>(y)] = true;
+            }
+            return;
+        }
+        compare(a_lo, split->x, b_lo, split->y);
+        compare(split->x, a_hi, split->y, b_hi);
+    }
+
+    // Вход/выход: точка на пути кратчайшего редакционного предписания для
+    // a[a_lo, a_hi) → b[b_lo, b_hi); обе части непусты и не имеют общих начала и конца.
+    // nullopt — фронты не встретились за max_cost_ шагов (расстояние больше 2 · max_cost_).
+    // Почему так: поиск идёт одновременно с обоих концов по диагоналям d = x - y, пока
+    // фронты не встретятся; хранятся только текущие фронты, а не вся матрица.
+    [[nodiscard]] auto middle_snake(Index a_lo, Index a_hi, Index b_lo, Index b_hi)
+        -> std::optional<Split> {
+        const auto d_min = a_lo - b_hi;
+        const auto d_max = a_hi - b_lo;
+        const auto f_mid = a_lo - b_lo;
+        const auto b_mid = a_hi - b_hi;
+        const bool odd = ((f_mid - b_mid) & 1) != 0;
+        auto f_min = f_mid;
+        auto f_max = f_mid;
+        auto b_min = b_mid;
+        auto b_max = b_mid;
+        fd(f_mid) = a_lo;
+        bd(b_mid) = a_hi;
+
+        for (Index cost = 1;; ++cost) {
+            if (cost > max_cost_) {
+                return std::nullopt;
+            }
+            if (f_min > d_min) {
+                fd(--f_min - 1) = -1;
+            } else {
+                ++f_min;
+            }
+            if (f_max < d_max) {
+                fd(++f_max + 1) = -1;
+            } else {
+                --f_max;
+            }
+            for (auto d = f_max; d >= f_min; d -= 2) {
+                const auto low = fd(d - 1);
+                const auto high = fd(d + 1);
+                auto x = low >= high ? low + 1 : high;
+                auto y = x - d;
+                while (x < a_hi && y < b_hi && same(x, y)) {
+                    ++x;
+                    ++y;
+                }
+                fd(d) = x;
+                if (odd && b_min <= d && d <= b_max && bd(d) <= x) {
+                    return Split{.x = x, .y = y};
+                }
+            }
+
+            if (b_min > d_min) {
+                bd(--b_min - 1) = std::numeric_limits<Index>::max();
+            } else {
+                ++b_min;
+            }
+            if (b_max < d_max) {
+                bd(++b_max + 1) = std::numeric_limits<Index>::max();
+            } else {
+                --b_max;
+            }
+            for (auto d = b_max; d >= b_min; d -= 2) {
+                const auto low = bd(d - 1);
+                const auto high = bd(d + 1);
+                auto x = low < high ? low : high - 1;
+                auto y = x - d;
+                while (x > a_lo && y > b_lo && same(x - 1, y - 1)) {
+                    --x;
+                    --y;
+                }
+                bd(d) = x;
+                if (!odd && f_min <= d && d <= f_max && x <= fd(d)) {
+                    return Split{.x = x, .y = y};
+                }
+            }
+        }
+    }
+
+    const std::vector<std::uint32_t>& a_;
+    const std::vector<std::uint32_t>& b_;
+    std::vector<bool> deleted_;
+    std::vector<bool> inserted_;
+    Index offset_;
+    Index max_cost_;
+    std::vector<Index> forward_;
+    std::vector<Index> backward_;
+};
+
+}  // namespace
+
+auto diff_lines(std::string_view before, std::string_view after, std::size_t max_cost)
+    -> std::vector<LineEdit> {
+    const auto old_lines = split_lines(before);
+    const auto new_lines = split_lines(after);
+
+    std::size_t prefix = 0;
+    while (prefix < old_lines.size() && prefix < new_lines.size() &&
+           old_lines[prefix] == new_lines[prefix]) {
+        ++prefix;
+    }
+    std::size_t suffix = 0;
+    while (suffix < old_lines.size() - prefix && suffix < new_lines.size() - prefix &&
+           old_lines[old_lines.size() - 1 - suffix] == new_lines[new_lines.size() - 1 - suffix]) {
+        ++suffix;
+    }
+
+    // Оставшаяся середина сравнивается по id строк: одинаковые строки получают один id
+    std::unordered_map<std::string_view, std::uint32_t> ids;
+    const auto intern = [&](std::span<const std::string_view> lines) {
+        std::vector<std::uint32_t> result;
+        result.reserve(lines.size());
+        for (const auto line : lines) {
+            result.push_back(
+                ids.try_emplace(line, static_cast<std::uint32_t>(ids.size())).first->second);
+        }
+        return result;
+    };
+    const auto a = intern(std::span(old_lines).subspan(prefix, old_lines.size() - prefix - suffix));
+    const auto b = intern(std::span(new_lines).subspan(prefix, new_lines.size() - prefix - suffix));
+
+    MyersDiff myers(a, b, max_cost);
+    myers.run();
+    const auto& deleted = myers.deleted();
+    const auto& inserted = myers.inserted();
+
+    std::vector<LineEdit> edits;
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < a.size() || j < b.size()) {
+        if (i < a.size() && j < b.size() && !deleted[i] && !inserted[j]) {
+            ++i;
+            ++j;
+            continue;
+        }
+        LineEdit edit{.old_start = prefix + i,
+                      .old_count = 0,
+                      .new_start = prefix + j,
+                      .new_count = 0,
+                      .text = {}};
+        for (; i < a.size() && deleted[i]; ++i) {
+            ++edit.old_count;
+        }
+        for (; j < b.size() && inserted[j]; ++j) {
+            edit.text += new_lines[prefix + j];
+            ++edit.new_count;
+        }
+        edits.push_back(std::move(edit));
+    }
+    return edits;
+}
+
+auto apply_line_edits(std::string_view before, std::span<const LineEdit> edits)
+    -> Result<std::string> {
+    const auto lines = split_lines(before);
+    std::string result;
+    result.reserve(before.size());
+    std::size_t next = 0;
+    for (const auto& edit : edits) {
+        if (edit.old_start < next || edit.old_start + edit.old_count > lines.size()) {
+            return Result<std::string>(
+                Error{format("Edit at line ", edit.old_start, " is out of order or out of range"),
+                      error_codes::text_diff::InvalidEdit});
+        }
+        for (; next < edit.old_start; ++next) {
+            result += lines[next];
+        }
+        result += edit.text;
+        next += edit.old_count;
+    }
+    for (; next < lines.size(); ++next) {
+        result += lines[next];
+    }
+    return Result<std::string>(std::move(result));
+}
+
+}  // namespace visprog::core
@@ -0,0 +1,325 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include "visprog/core/Workspace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/FormatCompat.hpp"
+
+namespace visprog::core {
+
+namespace {
+
+using compat::format;
+
+// Вход/выход: вызывает task(i) для i в [0, count) на пуле из threads потоков.
+// Почему так: задачи — файлы разного размера, поэтому потоки разбирают индексы из общего
+// атомарного счётчика, а не фиксированными диапазонами.
+template <typename Task>
+auto parallel_for(std::size_t count, std::size_t threads, Task&& task) -> void {
+    if (threads == 0) {
+        threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, count);
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    const auto worker = [&] {
+        for (auto i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            task(i);
+        }
+    };
+    std::vector<std::jthread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+}
+
+[[nodiscard]] auto is_variable_node(const Node& node) -> bool {
+    const auto type = node.get_type();
+    return type.name == NodeTypes::GetVariable.name || type.name == NodeTypes::SetVariable.name;
+}
+
+/// @brief Разобранный файл: JSON-документ либо ошибка чтения/разбора.
+struct ParsedFile {
+    nlohmann::json document;
+    std::optional<Error> error;
+};
+
+[[nodiscard]] auto read_and_parse(const std::filesystem::path& path) -> ParsedFile {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        return ParsedFile{.document = {},
+                          .error = Error{format("Cannot open '", path.string(), "'"),
+                                         error_codes::workspace::IoError}};
+    }
+    const std::string text{std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+    auto document = nlohmann::json::parse(text, nullptr, /*allow_exceptions=*/false);
+    if (document.is_discarded()) {
+        return ParsedFile{.document = {},
+                          .error = Error{format("'", path.string(), "' is not valid JSON"),
+                                         error_codes::workspace::ParseError}};
+    }
+    return ParsedFile{.document = std::move(document), .error = std::nullopt};
+}
+
+}  // namespace
+
+// ============================================================================
+// StringInterner
+// ============================================================================
+
+auto StringInterner::intern(std::string_view text) -> std::string_view {
+    if (const auto it = index_.find(text); it != index_.end()) {
+        return *it;
+    }
+    const std::string_view stored = storage_.emplace_back(text);
+    index_.insert(stored);
+    return stored;
+}
+
+auto StringInterner::find(std::string_view text) const -> std::string_view {
+    if (const auto it = index_.find(text); it != index_.end()) {
+        return *it;
+    }
+    return {};
+}
+
+// ============================================================================
+// NodeTypeRegistry
+// ============================================================================
+
+NodeTypeRegistry::NodeTypeRegistry(StringInterner& strings) : strings_(&strings) {
+    by_name_.reserve(NodeTypes::CoreRuntimeNodeTypes.size());
+    for (const auto* type : NodeTypes::CoreRuntimeNodeTypes) {
+        by_name_.emplace(type->name, type);
+    }
+}
+
+auto NodeTypeRegistry::register_type(std::string_view name, std::string_view label)
+    -> Result<const NodeType*> {
+    if (const auto* existing = find(name)) {
+        if (existing->label != label) {
+            return Result<const NodeType*>(
+                Error{format("Node type '", name, "' is already registered as '",
+                             existing->label, "'"),
+                      error_codes::workspace::TypeConflict});
+        }
+        return Result<const NodeType*>(existing);
+    }
+
+    const auto& type = custom_types_.emplace_back(
+        NodeType{.name = strings_->intern(name), .label = strings_->intern(label)});
+    by_name_.emplace(type.name, &type);
+    return Result<const NodeType*>(&type);
+}
+
+auto NodeTypeRegistry::find(std::string_view name) const -> const NodeType* {
+    if (const auto it = by_name_.find(name); it != by_name_.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// Workspace
+// ============================================================================
+
+Workspace::Workspace() : node_types_(strings_) {}
+
+auto Workspace::add_graph(Graph graph) -> Result<GraphId> {
+    const auto id = graph.get_id();
+    if (graph_lookup_.contains(id)) {
+        return Result<GraphId>(Error{format("Graph ", id.value, " already exists in workspace"),
+                                     error_codes::workspace::DuplicateGraph});
+    }
+
+    auto& stored = graphs_.emplace_back(std::make_unique<Graph>(std::move(graph)));
+    graph_lookup_.emplace(id, stored.get());
+    index_graph(*stored);
+    return Result<GraphId>(id);
+}
+
+auto Workspace::create_graph(std::string name) -> GraphId {
+    std::uint64_t next = 1;
+    for (const auto& graph : graphs_) {
+        next = std::max(next, graph->get_id().value + 1);
+    }
+    Graph graph{GraphId{next}};
+    graph.set_name(std::move(name));
+    graph.clear_history();
+    return add_graph(std::move(graph)).value();
+}
+
+auto Workspace::remove_graph(GraphId id) -> Result<void> {
+    if (!graph_lookup_.erase(id)) {
+        return Result<void>(Error{format("Graph ", id.value, " not found in workspace"),
+                                  error_codes::workspace::GraphNotFound});
+    }
+    unindex_graph(id);
+    std::erase_if(graphs_, [id](const auto& graph) { return graph->get_id() == id; });
+    return Result<void>();
+}
+
+auto Workspace::find_graph(GraphId id) -> Graph* {
+    const auto it = graph_lookup_.find(id);
+    return it != graph_lookup_.end() ? it->second : nullptr;
+}
+
+auto Workspace::find_graph(GraphId id) const -> const Graph* {
+    const auto it = graph_lookup_.find(id);
+    return it != graph_lookup_.end() ? it->second : nullptr;
+}
+
+// ============================================================================
+// Cross-graph reference index
+// ============================================================================
+
+auto Workspace::reindex(GraphId id) -> Result<void> {
+    const auto* graph = find_graph(id);
+    if (graph == nullptr) {
+        return Result<void>(Error{format("Graph ", id.value, " not found in workspace"),
+                                  error_codes::workspace::GraphNotFound});
+    }
+    unindex_graph(id);
+    index_graph(*graph);
+    return Result<void>();
+}
+
+auto Workspace::variable_references(std::string_view name) const
+    -> std::span<const SymbolReference> {
+    if (const auto it = variable_index_.find(name); it != variable_index_.end()) {
+        return it->second;
+    }
+    return {};
+}
+
+auto Workspace::type_usages(std::string_view type_name) const -> std::span<const SymbolReference> {
+    if (const auto it = type_index_.find(type_name); it != type_index_.end()) {
+        return it->second;
+    }
+    return {};
+}
+
+// Ключи индекса интернируются: имена типов и переменных повторяются во всех графах проекта
+// и хранятся один раз.
+auto Workspace::index_graph(const Graph& graph) -> void {
+    for (const auto& node : graph.get_nodes()) {
+        const SymbolReference reference{.graph = graph.get_id(), .node = node->get_id()};
+        type_index_[strings_.intern(node->get_type().name)].push_back(reference);
+
+        if (is_variable_node(*node)) {
+            if (const auto name = node->get_property<std::string>("variable_name")) {
+                variable_index_[strings_.intern(*name)].push_back(reference);
+            }
+        }
+    }
+}
+
+auto Workspace::unindex_graph(GraphId id) -> void {
+    const auto drop = [id](ReferenceIndex& index) {
+        for (auto it = index.begin(); it != index.end();) {
+            std::erase_if(it->second, [id](const SymbolReference& ref) { return ref.graph == id; });
+            it = it->second.empty() ? index.erase(it) : std::next(it);
+        }
+    };
+    drop(variable_index_);
+    drop(type_index_);
+}
+
+// ============================================================================
+// Bulk I/O
+// ============================================================================
+
+// Вход/выход: файлы → графы рабочей области; при любой ошибке рабочая область не меняется.
+// Edge cases: повтор GraphId среди файлов или с уже загруженными графами — ошибка; типы узлов
+// ищутся и в реестре проекта, поэтому их нужно зарегистрировать до загрузки.
+// Почему так: чтение и JSON-разбор независимы и идут параллельно, а GraphSerializer::from_json
+// временно переключает глобальные счётчики NodeFactory и потому вызывается последовательно.
+auto Workspace::load_files(std::span<const std::filesystem::path> files, std::size_t threads)
+    -> Result<std::vector<GraphId>> {
+    std::vector<ParsedFile> parsed(files.size());
+    parallel_for(files.size(), threads, [&](std::size_t i) {
+        parsed[i] = read_and_parse(files[i]);
+    });
+
+    std::vector<Graph> loaded;
+    loaded.reserve(files.size());
+    std::unordered_set<GraphId> seen;
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        if (parsed[i].error) {
+            return Result<std::vector<GraphId>>(*parsed[i].error);
+        }
+        auto graph = GraphSerializer::from_json(parsed[i].document, &node_types_);
+        if (!graph) {
+            return Result<std::vector<GraphId>>(
+                Error{format("'", files[i].string(), "': ", graph.error().message),
+                      graph.error().code});
+        }
+        const auto id = graph.value().get_id();
+        if (graph_lookup_.contains(id) || !seen.insert(id).second) {
+            return Result<std::vector<GraphId>>(
+                Error{format("'", files[i].string(), "': graph ", id.value, " is already loaded"),
+                      error_codes::workspace::DuplicateGraph});
+        }
+        loaded.push_back(std::move(graph).value());
+    }
+
+    std::vector<GraphId> ids;
+    ids.reserve(loaded.size());
+    graphs_.reserve(graphs_.size() + loaded.size());
+    for (auto& graph : loaded) {
+        ids.push_back(add_graph(std::move(graph)).value());
+    }
+    return Result<std::vector<GraphId>>(std::move(ids));
+}
+
+auto Workspace::save_all(const std::filesystem::path& directory,
+                         const SaveOptions& options,
+                         std::size_t threads) const -> Result<std::vector<std::filesystem::path>> {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        return Result<std::vector<std::filesystem::path>>(
+            Error{format("Cannot create '", directory.string(), "': ", ec.message()),
+                  error_codes::workspace::IoError});
+    }
+
+    std::vector<std::filesystem::path> paths(graphs_.size());
+    std::vector<std::optional<Error>> errors(graphs_.size());
+    parallel_for(graphs_.size(), threads, [&](std::size_t i) {
+        const auto& graph = *graphs_[i];
+        paths[i] = directory / format("graph-", graph.get_id().value, ".json");
+        const auto text = GraphSerializer::save(graph, options).document.dump(2);
+
+        std::ofstream output(paths[i], std::ios::binary | std::ios::trunc);
+        output << text;
+        if (!output) {
+            errors[i] = Error{format("Cannot write '", paths[i].string(), "'"),
+                              error_codes::workspace::IoError};
+        }
+    });
+
+    for (auto& error : errors) {
+        if (error) {
+            return Result<std::vector<std::filesystem::path>>(std::move(*error));
+        }
+    }
+    return Result<std::vector<std::filesystem::path>>(std::move(paths));
+}
+
+}  // namespace visprog::core
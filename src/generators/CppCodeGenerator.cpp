@@ -3,14 +3,26 @@
 #include "visprog/generators/CppCodeGenerator.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
 #include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "visprog/core/Connection.hpp"
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/FormatCompat.hpp"
 #include "visprog/core/Graph.hpp"
+#include "visprog/core/GraphAlgorithms.hpp"
 #include "visprog/core/Node.hpp"
 #include "visprog/core/Port.hpp"
 #include "visprog/core/Types.hpp"
@@ -19,6 +31,9 @@ namespace visprog::generators {
 
 namespace {
 
+// Ограничение глубины свёртки констант (защита от циклов в потоке данных).
+constexpr int kMaxFoldDepth = 200;
+
 const core::Port* find_port_by_name(const core::Node& node, std::string_view name) {
     for (const auto& port : node.get_ports()) {
         if (port.get_name() == name) {
@@ -86,18 +101,256 @@ std::string to_cpp_type(core::DataType type) {
             return "std::string";
         case core::DataType::Bool:
             return "bool";
+        case core::DataType::Array:
+        case core::DataType::Vector:
+            return "std::vector<int>";
         default:
             return "auto";
     }
 }
 
+// ============================================================================
+// Array Math helpers
+// ============================================================================
+
+/// @brief Операция над элементами массива для узлов семейства Array Math.
+[[nodiscard]] auto array_operation_for(std::string_view node_type) -> std::string_view {
+    if (node_type == core::NodeTypes::ArrayAdd.name) {
+        return "add";
+    }
+    if (node_type == core::NodeTypes::ArrayMul.name) {
+        return "mul";
+    }
+    if (node_type == core::NodeTypes::ArrayMin.name) {
+        return "min";
+    }
+    if (node_type == core::NodeTypes::ArrayMax.name) {
+        return "max";
+    }
+    return {};
+}
+
+/// @brief Выражение над одним элементом: lhs/rhs — уже проиндексированные операнды.
+[[nodiscard]] auto array_element_expression(std::string_view operation,
+                                            std::string_view lhs,
+                                            std::string_view rhs) -> std::optional<std::string> {
+    const auto l = std::string(lhs);
+    const auto r = std::string(rhs);
+    if (operation == "add") {
+        return l + " + " + r;
+    }
+    if (operation == "mul") {
+        return l + " * " + r;
+    }
+    if (operation == "min") {
+        return r + " < " + l + " ? " + r + " : " + l;
+    }
+    if (operation == "max") {
+        return l + " < " + r + " ? " + r + " : " + l;
+    }
+    return std::nullopt;
+}
+
+// Вспомогательные функции генерируются как простые циклы по сырым указателям с __restrict:
+// без алиасинга и с вынесенной длиной компилятор векторизует их на -O2/-O3.
+[[nodiscard]] auto make_elementwise_helper(std::string_view function_name,
+                                           std::string_view element_expr) -> std::string {
+    std::stringstream ss;
+    ss << "[[nodiscard]] inline std::vector<int> " << function_name
+       << "(const std::vector<int>& lhs, const std::vector<int>& rhs) {\n"
+       << "    const std::size_t size = lhs.size() < rhs.size() ? lhs.size() : rhs.size();\n"
+       << "    std::vector<int> result(size);\n"
+       << "    const int* __restrict a = lhs.data();\n"
+       << "    const int* __restrict b = rhs.data();\n"
+       << "    int* __restrict out = result.data();\n"
+       << "    for (std::size_t i = 0; i < size; ++i) {\n"
+       << "        out[i] = " << element_expr << ";\n"
+       << "    }\n"
+       << "    return result;\n"
+       << "}\n";
+    return ss.str();
+}
+
+[[nodiscard]] auto make_scalar_map_helper(std::string_view function_name,
+                                          std::string_view element_expr) -> std::string {
+    std::stringstream ss;
+    ss << "[[nodiscard]] inline std::vector<int> " << function_name
+       << "(const std::vector<int>& values, const int scalar) {\n"
+       << "    const std::size_t size = values.size();\n"
+       << "    std::vector<int> result(size);\n"
+       << "    const int* __restrict a = values.data();\n"
+       << "    int* __restrict out = result.data();\n"
+       << "    for (std::size_t i = 0; i < size; ++i) {\n"
+       << "        out[i] = " << element_expr << ";\n"
+       << "    }\n"
+       << "    return result;\n"
+       << "}\n";
+    return ss.str();
+}
+
+[[nodiscard]] auto make_reduce_sum_helper() -> std::string {
+    return "[[nodiscard]] inline int mc_array_sum(const std::vector<int>& values) {\n"
+           "    const std::size_t size = values.size();\n"
+           "    const int* __restrict a = values.data();\n"
+           "    int sum = 0;\n"
+           "    for (std::size_t i = 0; i < size; ++i) {\n"
+           "        sum += a[i];\n"
+           "    }\n"
+           "    return sum;\n"
+           "}\n";
+}
+
+// Сток стенда: значения переменных графа сворачиваются в volatile-переменную, запись в которую
+// компилятор обязан выполнить, поэтому вычисления run_graph() не удаляются как мёртвый код.
+// Выбран volatile, а не asm volatile("" ::: "memory"): он переносим между GCC, Clang и MSVC.
+[[nodiscard]] auto make_harness_sink_helper() -> std::string {
+    return "inline volatile unsigned long long mc_harness_sink = 0;\n\n"
+           "template <typename T>\n"
+           "inline void mc_harness_consume(const T& value) {\n"
+           "    unsigned long long folded = 0;\n"
+           "    if constexpr (requires { value.begin(); }) {\n"
+           "        for (const auto element : value) {\n"
+           "            folded += static_cast<unsigned long long>(element);\n"
+           "        }\n"
+           "    } else {\n"
+           "        folded = static_cast<unsigned long long>(value);\n"
+           "    }\n"
+           "    mc_harness_sink = mc_harness_sink + folded;\n"
+           "}\n\n"
+           "template <typename Consume>\n"
+           "struct mc_harness_observer {\n"
+           "    Consume consume;\n"
+           "    ~mc_harness_observer() {\n"
+           "        consume();\n"
+           "    }\n"
+           "};\n"
+           "template <typename Consume>\n"
+           "mc_harness_observer(Consume) -> mc_harness_observer<Consume>;\n";
+}
+
+/// @brief Разбирает свойство "values" узла Int Array Literal ("1, 2, 3").
+/// @details Нечисловые элементы пропускаются, пустые — игнорируются.
+[[nodiscard]] auto parse_int_list(std::string_view text) -> std::vector<std::int64_t> {
+    std::vector<std::int64_t> values;
+    std::size_t position = 0;
+    while (position < text.size()) {
+        auto separator = text.find_first_of(", \t\n;", position);
+        if (separator == std::string_view::npos) {
+            separator = text.size();
+        }
+
+        const auto token = text.substr(position, separator - position);
+        std::int64_t value = 0;
+        const auto* token_end = token.data() + token.size();
+        if (!token.empty()) {
+            const auto [ptr, ec] = std::from_chars(token.data(), token_end, value);
+            if (ec == std::errc{} && ptr == token_end && value >= std::numeric_limits<int>::min() &&
+                value <= std::numeric_limits<int>::max()) {
+                values.push_back(value);
+            }
+        }
+        position = separator + 1;
+    }
+    return values;
+}
+
+/// @brief Переменные, которые ветвь исполнения читает и записывает.
+struct VariableAccess {
+    std::set<std::string> reads;
+    std::set<std::string> writes;
+};
+
+/// @brief Ключ узла DAG выражений: операция (с параметрами листа) и номера значений операндов.
+struct ValueKey {
+    std::string operation;
+    std::vector<std::uint32_t> operands;
+
+    [[nodiscard]] auto operator==(const ValueKey& other) const noexcept -> bool = default;
+};
+
+struct ValueKeyHash {
+    [[nodiscard]] auto operator()(const ValueKey& key) const noexcept -> std::size_t {
+        auto seed = std::hash<std::string>{}(key.operation);
+        for (const auto operand : key.operands) {
+            seed ^= std::hash<std::uint32_t>{}(operand) + 0x9e3779b9 + (seed << 6U) + (seed >> 2U);
+        }
+        return seed;
+    }
+};
+
+/// @brief Значение в DAG выражений: все выходные порты, вычисляющие его, и число потребителей.
+struct ValueInfo {
+    std::vector<std::uint32_t> operands;
+    std::vector<const core::Port*> sources;
+    std::uint32_t uses{0};
+    bool pure{false};  ///< Зависит только от литералов — можно вычислить один раз в начале
+    bool reads_variables{false};  ///< Зависит от GetVariable — верно только до ближайшего Set
+};
+
+/// @brief Перекос Branch по профилю: какая ветвь исполнялась почти всегда.
+enum class BranchBias : std::uint8_t { None, True, False };
+
 class GraphCodeBuilder {
 public:
-    explicit GraphCodeBuilder(const core::Graph& graph) : graph_(graph) {}
+    GraphCodeBuilder(const core::Graph& graph,
+                     const CppGeneratorOptions& options,
+                     std::vector<core::Error>& warnings)
+        : graph_(graph), options_(options), warnings_(warnings) {}
+
+    /// @brief Вместо include и хелперов подключать общий заголовок (многофайловый вывод).
+    void use_prelude(std::string_view header) {
+        prelude_header_ = header;
+    }
+
+    /// @brief Генерировать по профилю исполнения; профиль должен пережить build().
+    void use_profile(const ExecutionProfile& profile) {
+        profile_ = &profile;
+    }
+
+    [[nodiscard]] auto required_includes() const -> std::set<std::string> {
+        auto includes = includes_;
+        if (!is_throughput()) {
+            includes.emplace("<iostream>");
+            includes.emplace("<string>");
+        }
+        return includes;
+    }
+
+    [[nodiscard]] auto helpers() const noexcept -> const std::map<std::string, std::string>& {
+        return helpers_;
+    }
 
     auto build() -> core::Result<std::string> {
+        writes_console_ = std::ranges::any_of(graph_.get_nodes(), [](const auto& node) {
+            return node->get_type().name == core::NodeTypes::PrintString.name;
+        });
+        has_parallel_branches_ = std::ranges::any_of(graph_.get_nodes(), [](const auto& node) {
+            return node->get_type().name == core::NodeTypes::ParallelSequence.name;
+        });
+        if (writes_console_) {
+            require_include("<iostream>");
+        }
+        if (options_.harness.enabled) {
+            for (const auto* header : {"<algorithm>", "<chrono>", "<cstdlib>", "<iostream>",
+                                       "<vector>"}) {
+                require_include(header);
+            }
+        }
+
         for (const auto& var : graph_.get_variables()) {
-            preamble_ << "    " << to_cpp_type(var.type) << " " << var.name << ";\n";
+            const auto cpp_type = to_cpp_type(var.type);
+            if (cpp_type == "std::string") {
+                require_include("<string>");
+            } else if (cpp_type.starts_with("std::vector")) {
+                require_include("<vector>");
+            }
+            // В стенде каждый прогон начинается с одинаковых значений, а сток не читает
+            // неинициализированную переменную
+            preamble_ << "    " << cpp_type << " " << var.name
+                      << (options_.harness.enabled ? "{};\n" : ";\n");
+        }
+        if (options_.harness.enabled) {
+            emit_harness_observer();
         }
         if (!graph_.get_variables().empty()) {
             preamble_ << "\n";
@@ -108,6 +361,8 @@ public:
             return core::Result<std::string>{core::Error{"Graph must have a Start node."}};
         }
 
+        count_value_uses(*start_node);
+
         const auto start_exec_ports = start_node->get_exec_output_ports();
         if (!start_exec_ports.empty()) {
             generate_exec_flow(get_connected_node(graph_, *start_exec_ports[0]));
@@ -130,13 +385,24 @@ private:
 
         const auto type = current_node->get_type();
         const auto indentation = std::string(static_cast<std::size_t>(indent * 4), ' ');
+        statement_indentation_ = indentation;
+
+        // Не исполнявшийся в профиле узел открывает холодный участок: всё, что генерируется
+        // из него, тоже холодное, поэтому помечается только вход в участок
+        const bool enters_cold = profile_ != nullptr && !in_cold_code_ &&
+                                 counters_of(*current_node).executions == 0;
+        if (enters_cold) {
+            report_cold_code(*current_node, indentation);
+            in_cold_code_ = true;
+        }
 
         if (type.name == core::NodeTypes::End.name) {
-            main_body_ << indentation << "return 0;\n";
+            emit_return(indentation);
         } else if (type.name == core::NodeTypes::PrintString.name) {
             if (const auto* msg_port = find_port_by_names(*current_node, {"string", "value"})) {
                 const auto value_expr = generate_data_expression(*msg_port);
-                main_body_ << indentation << "std::cout << " << value_expr << " << std::endl;\n";
+                main_body_ << indentation << "std::cout << " << value_expr
+                           << (is_throughput() ? " << '\\n';\n" : " << std::endl;\n");
             }
             generate_exec_flow(get_next_exec_node(*current_node), indent);
         } else if (type.name == core::NodeTypes::SetVariable.name) {
@@ -159,65 +425,602 @@ private:
             for (const auto* port : exec_ports) {
                 generate_exec_flow(get_connected_node(graph_, *port), indent);
             }
+        } else if (type.name == core::NodeTypes::ParallelSequence.name) {
+            generate_parallel_sequence(*current_node, indent);
         } else if (type.name == core::NodeTypes::Branch.name) {
-            const auto* cond_port = find_port_by_name(*current_node, "condition");
-            const auto condition_expr = cond_port ? generate_data_expression(*cond_port) : "false";
+            generate_branch(*current_node, indent);
+        } else if (type.name == core::NodeTypes::ForLoop.name) {
+            generate_for_loop(*current_node, indent);
+        } else {
+            generate_exec_flow(get_next_exec_node(*current_node), indent);
+        }
 
-            main_body_ << indentation << "if (" << condition_expr << ") {\n";
-            if (const auto* true_exec = find_port_by_names(*current_node, {"true", "true_exec"})) {
-                generate_exec_flow(get_connected_node(graph_, *true_exec), indent + 1);
+        if (enters_cold) {
+            in_cold_code_ = false;
+        }
+        recursion_depth_--;
+    }
+
+    // Вход/выход: if/else по условию Branch. С профилем ветвь, исполнявшаяся не реже
+    // branch_bias, помечается [[likely]], другая — [[unlikely]]; горячая ветвь false
+    // генерируется первой под инвертированным условием.
+    // Edge cases: Branch, исполнявшийся реже min_branch_samples раз или без явного перекоса,
+    // генерируется как без профиля.
+    // Почему так: условие вычисляется один раз в обоих вариантах, поэтому перестановка ветвей
+    // не меняет семантику, а горячий путь идёт в машинном коде сразу за проверкой.
+    void generate_branch(const core::Node& node, int indent) {
+        const auto indentation = std::string(static_cast<std::size_t>(indent * 4), ' ');
+        const auto* cond_port = find_port_by_name(node, "condition");
+        const auto condition_expr = cond_port ? generate_data_expression(*cond_port) : "false";
+        const auto* true_exec = find_port_by_names(node, {"true", "true_exec"});
+        const auto* false_exec = find_port_by_names(node, {"false", "false_exec"});
+
+        const auto generate_arm = [&](const core::Port* exec_port) {
+            if (exec_port != nullptr) {
+                generate_exec_flow(get_connected_node(graph_, *exec_port), indent + 1);
             }
-            main_body_ << indentation << "} else {\n";
-            if (const auto* false_exec =
-                    find_port_by_names(*current_node, {"false", "false_exec"})) {
-                generate_exec_flow(get_connected_node(graph_, *false_exec), indent + 1);
+        };
+
+        const auto bias = branch_bias(node);
+        if (bias == BranchBias::False) {
+            main_body_ << indentation << "if (!(" << condition_expr << ")) [[likely]] {\n";
+            generate_arm(false_exec);
+            main_body_ << indentation << "} else [[unlikely]] {\n";
+            generate_arm(true_exec);
+        } else {
+            const bool biased = bias == BranchBias::True;
+            main_body_ << indentation << "if (" << condition_expr << ")"
+                       << (biased ? " [[likely]]" : "") << " {\n";
+            generate_arm(true_exec);
+            main_body_ << indentation << "} else" << (biased ? " [[unlikely]]" : "") << " {\n";
+            generate_arm(false_exec);
+        }
+        main_body_ << indentation << "}\n";
+    }
+
+    [[nodiscard]] auto counters_of(const core::Node& node) const -> NodeCounters {
+        const auto found = profile_->find(node.get_id());
+        return found != profile_->end() ? found->second : NodeCounters{};
+    }
+
+    [[nodiscard]] auto branch_bias(const core::Node& node) const -> BranchBias {
+        if (profile_ == nullptr) {
+            return BranchBias::None;
+        }
+        const auto counters = counters_of(node);
+        const auto& profile_guided = options_.profile_guided;
+        if (counters.executions == 0 || counters.executions < profile_guided.min_branch_samples) {
+            return BranchBias::None;
+        }
+        const auto taken = std::min(counters.taken, counters.executions);
+        const auto share = static_cast<double>(taken) / static_cast<double>(counters.executions);
+        if (share >= profile_guided.branch_bias) {
+            return BranchBias::True;
+        }
+        if (1.0 - share >= profile_guided.branch_bias) {
+            return BranchBias::False;
+        }
+        return BranchBias::None;
+    }
+
+    // Холодный код не удаляется — профиль мог не покрыть редкий, но корректный путь; узел
+    // попадает в предупреждения один раз, даже если развёртка цикла повторяет его тело.
+    void report_cold_code(const core::Node& node, const std::string& indentation) {
+        if (reported_cold_.insert(node.get_id()).second) {
+            warnings_.push_back(core::Error{
+                .message = core::compat::format("Node '", node.get_display_name(),
+                                                "' never ran in the profile; its code is kept"),
+                .code = core::error_codes::codegen::ColdCodeKept});
+        }
+        main_body_ << indentation << "// Холодный код: не исполнялся в профиле\n";
+    }
+
+    // Вход/выход: ветви then-N исполняются в отдельных std::jthread внутри блока; потоки
+    // присоединяются при выходе из блока, после чего генерируется ветвь completed.
+    // Edge cases: ветвь без подключённых узлов пропускается, единственная ветвь исполняется без
+    // потока, но тоже в лямбде (вызываемой на месте); End внутри ветви завершает только её
+    // (return из лямбды), после чего исполняется completed.
+    // Почему так: jthread гарантирует join даже при раннем выходе и не требует пула в рантайме.
+    void generate_parallel_sequence(const core::Node& node, int indent) {
+        const auto indentation = std::string(static_cast<std::size_t>(indent * 4), ' ');
+
+        auto exec_ports = node.get_exec_output_ports();
+        std::sort(
+            exec_ports.begin(), exec_ports.end(), [](const core::Port* a, const core::Port* b) {
+                return a->get_name() < b->get_name();
+            });
+
+        std::vector<const core::Node*> branch_roots;
+        for (const auto* port : exec_ports) {
+            if (port->get_name() == "completed") {
+                continue;
+            }
+            if (const auto* root = get_connected_node(graph_, *port); root != nullptr) {
+                branch_roots.push_back(root);
+            }
+        }
+
+        if (branch_roots.size() == 1) {
+            main_body_ << indentation << "[&] {\n";
+            ++parallel_depth_;
+            generate_exec_flow(branch_roots.front(), indent + 1);
+            --parallel_depth_;
+            main_body_ << indentation << "}();\n";
+        } else if (!branch_roots.empty()) {
+            report_parallel_conflicts(node, branch_roots, indentation);
+            require_include("<thread>");
+
+            main_body_ << indentation << "{\n";
+            for (std::size_t index = 0; index < branch_roots.size(); ++index) {
+                main_body_ << indentation << "    std::jthread branch_" << node.get_id().value
+                           << "_" << index << "([&] {\n";
+                ++parallel_depth_;
+                generate_exec_flow(branch_roots[index], indent + 2);
+                --parallel_depth_;
+                main_body_ << indentation << "    });\n";
             }
             main_body_ << indentation << "}\n";
-        } else if (type.name == core::NodeTypes::ForLoop.name) {
-            const auto* first_idx_port =
-                find_port_by_names(*current_node, {"first", "first_index"});
-            const auto* last_idx_port = find_port_by_names(*current_node, {"last", "last_index"});
-            const auto* index_out_port = find_port_by_name(*current_node, "index");
+        }
+
+        if (const auto* completed = find_port_by_name(node, "completed")) {
+            generate_exec_flow(get_connected_node(graph_, *completed), indent);
+        }
+    }
+
+    // Вход/выход: сравнивает наборы переменных ветвей и добавляет предупреждения генератора и
+    // комментарии в код для каждой переменной, доступ к которой не синхронизирован.
+    void report_parallel_conflicts(const core::Node& node,
+                                   const std::vector<const core::Node*>& branch_roots,
+                                   const std::string& indentation) {
+        std::vector<VariableAccess> accesses;
+        accesses.reserve(branch_roots.size());
+        for (const auto* root : branch_roots) {
+            VariableAccess access;
+            collect_exec_accesses(*root, access);
+            accesses.push_back(std::move(access));
+        }
+
+        std::set<std::string> write_conflicts;
+        std::set<std::string> read_write_conflicts;
+        for (std::size_t i = 0; i < accesses.size(); ++i) {
+            for (std::size_t j = 0; j < accesses.size(); ++j) {
+                if (i == j) {
+                    continue;
+                }
+                for (const auto& name : accesses[i].writes) {
+                    if (i < j && accesses[j].writes.contains(name)) {
+                        write_conflicts.insert(name);
+                    } else if (accesses[j].reads.contains(name)) {
+                        read_write_conflicts.insert(name);
+                    }
+                }
+            }
+        }
+
+        const auto node_name = std::string(node.get_display_name());
+        for (const auto& name : write_conflicts) {
+            warnings_.push_back(core::Error{
+                .message = core::compat::format(
+                    "Parallel Sequence '", node_name, "': variable '", name,
+                    "' is written by several branches"),
+                .code = core::error_codes::codegen::ParallelWriteConflict});
+            main_body_ << indentation << "// ВНИМАНИЕ: переменная '" << name
+                       << "' записывается в нескольких параллельных ветвях\n";
+        }
+        for (const auto& name : read_write_conflicts) {
+            if (write_conflicts.contains(name)) {
+                continue;
+            }
+            warnings_.push_back(core::Error{
+                .message = core::compat::format(
+                    "Parallel Sequence '", node_name, "': variable '", name,
+                    "' is written by one branch and read by another"),
+                .code = core::error_codes::codegen::ParallelReadWriteConflict});
+            main_body_ << indentation << "// ВНИМАНИЕ: переменная '" << name
+                       << "' записывается и читается в разных параллельных ветвях\n";
+        }
+    }
 
+    // Вход/выход: записи SetVariable во всей exec-цепочке ветви и чтения GetVariable в данных,
+    // которые эти узлы потребляют.
+    // Edge cases: обход данных останавливается на узлах с потоком исполнения (например, индекс
+    // ForLoop вне ветви) — их переменные относятся к другой части графа.
+    void collect_exec_accesses(const core::Node& root, VariableAccess& access) {
+        namespace algorithms = core::algorithms;
+        algorithms::depth_first<algorithms::ExecEdges>(
+            graph_, root.get_id(),
+            [&](const core::Node& node, std::uint32_t /*depth*/) {
+                if (node.get_type().name == core::NodeTypes::SetVariable.name) {
+                    if (auto name = node.get_property<std::string>("variable_name");
+                        name && !name->empty()) {
+                        access.writes.insert(*name);
+                    }
+                }
+                collect_data_reads(node, access);
+            },
+            exec_scratch_);
+    }
+
+    void collect_data_reads(const core::Node& consumer, VariableAccess& access) {
+        namespace algorithms = core::algorithms;
+        algorithms::breadth_first<algorithms::DataEdges, algorithms::Direction::Reverse>(
+            graph_, consumer.get_id(),
+            [&](const core::Node& node, std::uint32_t depth) {
+                if (depth > 0 && node.has_execution_flow()) {
+                    return algorithms::VisitAction::SkipChildren;
+                }
+                if (node.get_type().name == core::NodeTypes::GetVariable.name) {
+                    if (auto name = node.get_property<std::string>("variable_name");
+                        name && !name->empty()) {
+                        access.reads.insert(*name);
+                    }
+                }
+                return algorithms::VisitAction::Continue;
+            },
+            data_scratch_);
+    }
+
+    void generate_for_loop(const core::Node& loop_node, int indent) {
+        const auto indentation = std::string(static_cast<std::size_t>(indent * 4), ' ');
+        const auto* first_idx_port = find_port_by_names(loop_node, {"first", "first_index"});
+        const auto* last_idx_port = find_port_by_names(loop_node, {"last", "last_index"});
+        const auto* index_out_port = find_port_by_name(loop_node, "index");
+        const auto* loop_body = find_port_by_names(loop_node, {"loop-body", "loop_body"});
+
+        const auto loop_var = "i_" + std::to_string(loop_node.get_id().value);
+        std::optional<std::uint32_t> index_value;
+        if (index_out_port != nullptr) {
+            index_value = value_number(*index_out_port);
+            generated_expressions_[*index_value] = loop_var;
+        }
+
+        const auto* body_node =
+            loop_body != nullptr ? get_connected_node(graph_, *loop_body) : nullptr;
+
+        const auto first_const =
+            first_idx_port ? constant_int_value(*first_idx_port) : std::optional<std::int64_t>{0};
+        const auto last_const =
+            last_idx_port ? constant_int_value(*last_idx_port) : std::optional<std::int64_t>{10};
+
+        const auto loops = loop_options(loop_node, first_const, last_const);
+        if (loops.specialize_constant_bounds && first_const && last_const) {
+            generate_constant_for_loop(
+                *first_const, *last_const, loop_var, index_value, body_node, loops, indent);
+        } else {
             const auto first_idx_expr =
                 first_idx_port ? generate_data_expression(*first_idx_port) : "0";
             const auto last_idx_expr =
                 last_idx_port ? generate_data_expression(*last_idx_port) : "10";
 
-            const auto loop_var = "i_" + std::to_string(current_node->get_id().value);
+            main_body_ << indentation << "for (int " << loop_var << " = " << first_idx_expr
+                       << "; " << loop_var << " < " << last_idx_expr << "; ++" << loop_var
+                       << ") {\n";
+            generate_loop_body(index_value, body_node, indent + 1);
+            main_body_ << indentation << "}\n";
+        }
 
-            if (index_out_port != nullptr) {
-                generated_expressions_[index_out_port->get_id()] = loop_var;
-            }
+        if (const auto* completed = find_port_by_name(loop_node, "completed")) {
+            generate_exec_flow(get_connected_node(graph_, *completed), indent);
+        }
+    }
 
-            main_body_ << indentation << "for (int " << loop_var << " = " << first_idx_expr << "; "
-                       << loop_var << " < " << last_idx_expr << "; ++" << loop_var << ") {\n";
+    // Вход/выход: настройки развёртки конкретного цикла. Без профиля — общие options_.loops;
+    // цикл, не исполнявшийся в профиле, не развёртывается (важен размер кода), а цикл
+    // с константными границами, набравший hot_loop_iterations итераций, специализируется
+    // и развёртывается не слабее порогов profile_guided.
+    // Edge cases: циклы с вычисляемыми границами не меняются — их развёртка требовала бы
+    // доказать, что граница не зависит от тела.
+    [[nodiscard]] auto loop_options(const core::Node& loop_node,
+                                    std::optional<std::int64_t> first,
+                                    std::optional<std::int64_t> last) const
+        -> LoopUnrollOptions {
+        auto loops = options_.loops;
+        if (profile_ == nullptr || !first || !last) {
+            return loops;
+        }
+        const auto executions = counters_of(loop_node).executions;
+        if (executions == 0) {
+            loops.full_unroll_limit = 0;
+            loops.partial_unroll_factor = 1;
+            return loops;
+        }
+
+        const auto trip_count = *last > *first ? static_cast<std::uint64_t>(*last - *first) : 0;
+        constexpr auto kMaxIterations = std::numeric_limits<std::uint64_t>::max();
+        const auto iterations = trip_count != 0 && executions > kMaxIterations / trip_count
+                                    ? kMaxIterations
+                                    : executions * trip_count;
+        const auto& profile_guided = options_.profile_guided;
+        if (iterations >= profile_guided.hot_loop_iterations) {
+            loops.specialize_constant_bounds = true;
+            loops.full_unroll_limit =
+                std::max(loops.full_unroll_limit, profile_guided.hot_full_unroll_limit);
+            loops.partial_unroll_factor =
+                std::max(loops.partial_unroll_factor, profile_guided.hot_unroll_factor);
+        }
+        return loops;
+    }
 
-            if (const auto* loop_body =
-                    find_port_by_names(*current_node, {"loop-body", "loop_body"})) {
-                generate_exec_flow(get_connected_node(graph_, *loop_body), indent + 1);
+    // Вход/выход: генерирует цикл [first, last) с известными границами без пересчёта выражений.
+    // Edge cases: пустой диапазон удаляется целиком; малое число итераций развёртывается
+    // полностью; иначе тело повторяется partial_unroll_factor раз, остаток — отдельными блоками.
+    // Почему так: каждая итерация получает собственный блок с константным индексом, поэтому тело
+    // генерируется тем же generate_exec_flow без знания о развёртке.
+    void generate_constant_for_loop(std::int64_t first,
+                                    std::int64_t last,
+                                    const std::string& loop_var,
+                                    std::optional<std::uint32_t> index_value,
+                                    const core::Node* body_node,
+                                    const LoopUnrollOptions& loops,
+                                    int indent) {
+        const auto indentation = std::string(static_cast<std::size_t>(indent * 4), ' ');
+        const auto trip_count = last > first ? last - first : 0;
+
+        if (trip_count == 0 || body_node == nullptr) {
+            return;
+        }
+
+        const auto emit_iteration = [&](std::int64_t index) {
+            main_body_ << indentation << "{\n";
+            main_body_ << indentation << "    constexpr int " << loop_var << " = " << index
+                       << ";\n";
+            generate_loop_body(index_value, body_node, indent + 1);
+            main_body_ << indentation << "}\n";
+        };
+
+        if (trip_count <= loops.full_unroll_limit) {
+            for (auto index = first; index < last; ++index) {
+                emit_iteration(index);
             }
+            return;
+        }
 
+        const auto factor = loops.partial_unroll_factor;
+        if (factor <= 1) {
+            main_body_ << indentation << "for (int " << loop_var << " = " << first << "; "
+                       << loop_var << " < " << last << "; ++" << loop_var << ") {\n";
+            generate_loop_body(index_value, body_node, indent + 1);
             main_body_ << indentation << "}\n";
+            return;
+        }
 
-            if (const auto* completed = find_port_by_name(*current_node, "completed")) {
-                generate_exec_flow(get_connected_node(graph_, *completed), indent);
+        const auto unrolled_end = first + (trip_count / factor) * factor;
+        const auto block_var = loop_var + "_block";
+        main_body_ << indentation << "for (int " << block_var << " = " << first << "; "
+                   << block_var << " < " << unrolled_end << "; " << block_var << " += " << factor
+                   << ") {\n";
+        {
+            const auto inner_indentation = indentation + "    ";
+            for (std::int64_t offset = 0; offset < factor; ++offset) {
+                main_body_ << inner_indentation << "{\n";
+                main_body_ << inner_indentation << "    const int " << loop_var << " = "
+                           << block_var << " + " << offset << ";\n";
+                generate_loop_body(index_value, body_node, indent + 2);
+                main_body_ << inner_indentation << "}\n";
             }
-        } else {
-            generate_exec_flow(get_next_exec_node(*current_node), indent);
         }
+        main_body_ << indentation << "}\n";
 
-        recursion_depth_--;
+        for (auto index = unrolled_end; index < last; ++index) {
+            emit_iteration(index);
+        }
+    }
+
+    // Вход/выход: тело цикла в текущем блоке. Значения, которые зависят только от индексов
+    // открытых циклов и литералов и нужны больше одного раза, объявляются временными в начале
+    // блока и видны всему телу.
+    // Edge cases: при развёртке каждая копия тела — свой блок со своими временными; временные
+    // и выражения, ссылающиеся на них, забываются на выходе из блока.
+    // Почему так: тело не присваивает индекс, поэтому такие значения не меняются внутри
+    // итерации, где бы в теле (в т.ч. во вложенном if) их ни использовали.
+    void generate_loop_body(std::optional<std::uint32_t> index_value,
+                            const core::Node* body_node,
+                            int indent) {
+        const auto scope = scoped_values_.size();
+        if (index_value) {
+            active_loop_indices_.push_back(*index_value);
+        }
+        hoist_loop_values(body_node, indent);
+        generate_exec_flow(body_node, indent);
+        if (index_value) {
+            active_loop_indices_.pop_back();
+        }
+        close_value_scope(scope);
+    }
+
+    void hoist_loop_values(const core::Node* body_node, int indent) {
+        if (body_node == nullptr || active_loop_indices_.empty()) {
+            return;
+        }
+        std::vector<const core::Port*> pending;
+        core::algorithms::depth_first<core::algorithms::ExecEdges>(
+            graph_, body_node->get_id(),
+            [&](const core::Node& node, std::uint32_t /*depth*/) {
+                append_data_inputs(node, pending);
+            },
+            exec_scratch_);
+
+        // Обход DAG значений от входов узлов тела; порт запоминается, чтобы сгенерировать
+        // значение через него
+        std::vector<const core::Port*> hoisted;
+        std::unordered_set<std::uint32_t> seen;
+        for (std::size_t next = 0; next < pending.size(); ++next) {
+            const auto* input = pending[next];
+            const auto* source = get_connected_port(graph_, *input);
+            if (source == nullptr) {
+                continue;
+            }
+            const auto value = value_number(*source);
+            if (!seen.insert(value).second || values_[value].pure ||
+                values_[value].operands.empty()) {
+                continue;
+            }
+            if (is_loop_hoistable(value)) {
+                hoisted.push_back(input);
+            }
+            if (const auto* node = find_node_with_port(graph_, source->get_id())) {
+                append_data_inputs(*node, pending);
+            }
+        }
+
+        statement_indentation_ = std::string(static_cast<std::size_t>(indent * 4), ' ');
+        hoisting_loop_values_ = true;
+        for (const auto* input : hoisted) {
+            (void)generate_data_expression(*input);
+        }
+        hoisting_loop_values_ = false;
     }
 
+    static void append_data_inputs(const core::Node& node,
+                                   std::vector<const core::Port*>& inputs) {
+        for (const auto& port : node.get_ports()) {
+            if (port.get_direction() == core::PortDirection::Input && !port.is_execution()) {
+                inputs.push_back(&port);
+            }
+        }
+    }
+
+    // Вход/выход: значение вычисляется в теле открытого цикла, используется больше одного раза
+    // и зависит только от литералов и индексов открытых циклов.
+    [[nodiscard]] auto is_loop_hoistable(std::uint32_t value) -> bool {
+        const auto& info = values_[value];
+        if (info.pure || info.reads_variables || info.operands.empty() || info.uses < 2) {
+            return false;
+        }
+        return std::ranges::all_of(leaf_values(value), [&](std::uint32_t leaf) {
+            return std::ranges::find(active_loop_indices_, leaf) != active_loop_indices_.end();
+        });
+    }
+
+    // Вход/выход: нечистые листья DAG под значением (индексы циклов, выходы Start, переменные),
+    // по возрастанию номеров; для чистого значения пусто.
+    auto leaf_values(std::uint32_t value) -> const std::vector<std::uint32_t>& {
+        if (const auto known = leaf_values_.find(value); known != leaf_values_.end()) {
+            return known->second;
+        }
+        std::vector<std::uint32_t> leaves;
+        if (!values_[value].pure) {
+            if (values_[value].operands.empty()) {
+                leaves.push_back(value);
+            }
+            for (const auto operand : values_[value].operands) {
+                const auto& nested = leaf_values(operand);
+                leaves.insert(leaves.end(), nested.begin(), nested.end());
+            }
+            std::ranges::sort(leaves);
+            leaves.erase(std::unique(leaves.begin(), leaves.end()), leaves.end());
+        }
+        return leaf_values_.emplace(value, std::move(leaves)).first->second;
+    }
+
+    // Забыть выражения нечистых значений, сгенерированные после отметки scope: они могут
+    // ссылаться на временные из закрывающегося блока или на устаревшие значения переменных.
+    void close_value_scope(std::size_t scope) {
+        for (auto index = scope; index < scoped_values_.size(); ++index) {
+            generated_expressions_.erase(scoped_values_[index]);
+        }
+        scoped_values_.resize(scope);
+    }
+
+    void count_statement_uses(std::uint32_t value) {
+        if (statement_uses_[value]++ > 0) {
+            return;
+        }
+        for (const auto operand : values_[value].operands) {
+            count_statement_uses(operand);
+        }
+    }
+
+    // Вход/выход: значение входного Int-порта, если оно известно на этапе генерации.
+    // Edge cases: неподключённый порт равен значению по умолчанию (0), как и в обычной генерации;
+    // значения вне диапазона int не считаются константами.
+    [[nodiscard]] auto constant_int_value(const core::Port& input_port, int depth = 0) const
+        -> std::optional<std::int64_t> {
+        const auto* source_port = get_connected_port(graph_, input_port);
+        if (source_port == nullptr) {
+            return input_port.get_data_type() == core::DataType::Int32
+                       ? std::optional<std::int64_t>{0}
+                       : std::nullopt;
+        }
+
+        const auto* source_node = find_node_with_port(graph_, source_port->get_id());
+        if (source_node == nullptr) {
+            return std::nullopt;
+        }
+        return fold_int_constant(*source_node, depth + 1);
+    }
+
+    // Вход/выход: значение Int-узла, вычисленное на этапе генерации (IntLiteral или Add над
+    // константными операндами).
+    // Edge cases: результат вне диапазона int (в т.ч. переполнение при сложении) не сворачивается —
+    // в constexpr-контексте такое выражение не скомпилировалось бы; циклы данных обрываются
+    // ограничением глубины.
+    // Почему так: результат кешируется по узлу — выход, питающий несколько входов, иначе
+    // сворачивался бы заново на каждом пути, экспоненциально от глубины графа.
+    [[nodiscard]] auto fold_int_constant(const core::Node& node, int depth = 0) const
+        -> std::optional<std::int64_t> {
+        if (depth > kMaxFoldDepth) {
+            return std::nullopt;
+        }
+        if (const auto cached = folded_.find(node.get_id()); cached != folded_.end()) {
+            return cached->second;
+        }
+
+        std::optional<std::int64_t> value;
+        if (node.get_type().name == core::NodeTypes::IntLiteral.name) {
+            value = node.get_property<std::int64_t>("value").value_or(0);
+        } else if (node.get_type().name == core::NodeTypes::Add.name) {
+            const auto* port_a = find_port_by_name(node, "a");
+            const auto* port_b = find_port_by_name(node, "b");
+            if (port_a == nullptr || port_b == nullptr) {
+                return std::nullopt;
+            }
+            const auto lhs = constant_int_value(*port_a, depth);
+            const auto rhs = lhs ? constant_int_value(*port_b, depth) : std::nullopt;
+            if (lhs && rhs) {
+                value = *lhs + *rhs;
+            }
+        }
+
+        if (value && (*value < std::numeric_limits<int>::min() ||
+                      *value > std::numeric_limits<int>::max())) {
+            value.reset();
+        }
+        folded_.emplace(node.get_id(), value);
+        return value;
+    }
+
+    // Вход/выход: выражение для входного порта данных. Вызов верхнего уровня — одна инструкция
+    // узла исполнения: значения, нужные в ней больше одного раза, уходят во временные перед
+    // инструкцией, включая зависящие от переменных графа.
+    // Edge cases: внутри одной инструкции SetVariable не исполняется, поэтому переменная
+    // не меняется между использованиями; после инструкции выражения от переменных забываются.
     std::string generate_data_expression(const core::Port& input_port) {
+        if (expression_depth_ > 0 || hoisting_loop_values_) {
+            return build_data_expression(input_port);
+        }
+        const auto scope = scoped_values_.size();
+        if (const auto* source = get_connected_port(graph_, input_port); source != nullptr) {
+            count_statement_uses(value_number(*source));
+        }
+        ++expression_depth_;
+        auto expression = build_data_expression(input_port);
+        --expression_depth_;
+        statement_uses_.clear();
+        close_value_scope(scope);
+        return expression;
+    }
+
+    std::string build_data_expression(const core::Port& input_port) {
         if (input_port.get_direction() != core::PortDirection::Input) {
             return "/* invalid port direction */";
         }
 
         const auto* source_port = get_connected_port(graph_, input_port);
         if (source_port == nullptr) {
-            return get_default_value(input_port.get_data_type());
+            auto expression = get_default_value(input_port.get_data_type());
+            require_includes_for(expression);
+            return expression;
         }
 
         const auto* source_node = find_node_with_port(graph_, source_port->get_id());
@@ -225,9 +1028,10 @@ private:
             return "/* source node not found */";
         }
 
-        const auto cache_key = source_port->get_id();
-        if (generated_expressions_.contains(cache_key)) {
-            return generated_expressions_[cache_key];
+        const auto value_id = value_number(*source_port);
+        if (const auto cached = generated_expressions_.find(value_id);
+            cached != generated_expressions_.end()) {
+            return cached->second;
         }
 
         const auto type = source_node->get_type();
@@ -239,18 +1043,36 @@ private:
         } else if (type.name == core::NodeTypes::StringLiteral.name) {
             const auto value = source_node->get_property<std::string>("value").value_or("");
             const auto var_name = "var_" + std::to_string(source_node->get_id().value);
-            preamble_ << "    const std::string " << var_name << " = \"" << value << "\";\n";
+            if ((is_throughput() || options_.fold_constants) &&
+                std::ranges::all_of(values_[value_id].sources, [&](const core::Port* port) {
+                    return consumers_accept_string_view(*port);
+                })) {
+                require_include("<string_view>");
+                preamble_ << "    constexpr std::string_view " << var_name << " = \"" << value
+                          << "\";\n";
+            } else {
+                require_include("<string>");
+                preamble_ << "    const std::string " << var_name << " = \"" << value << "\";\n";
+            }
             expression = var_name;
         } else if (type.name == core::NodeTypes::BoolLiteral.name) {
             const auto value = source_node->get_property<bool>("value").value_or(false);
             const auto var_name = "var_" + std::to_string(source_node->get_id().value);
-            preamble_ << "    const bool " << var_name << " = " << (value ? "true" : "false")
-                      << ";\n";
+            preamble_ << "    " << literal_qualifier() << " bool " << var_name << " = "
+                      << (value ? "true" : "false") << ";\n";
             expression = var_name;
         } else if (type.name == core::NodeTypes::IntLiteral.name) {
             const auto value = source_node->get_property<std::int64_t>("value").value_or(0);
             const auto var_name = "var_" + std::to_string(source_node->get_id().value);
-            preamble_ << "    const int " << var_name << " = " << value << ";\n";
+            preamble_ << "    " << literal_qualifier() << " int " << var_name << " = " << value
+                      << ";\n";
+            expression = var_name;
+        } else if (const auto folded = type.name == core::NodeTypes::Add.name &&
+                                               options_.fold_constants
+                                           ? fold_int_constant(*source_node)
+                                           : std::nullopt) {
+            const auto var_name = "var_" + std::to_string(source_node->get_id().value);
+            preamble_ << "    constexpr int " << var_name << " = " << *folded << ";\n";
             expression = var_name;
         } else if (type.name == core::NodeTypes::Add.name) {
             const auto* port_a = find_port_by_name(*source_node, "a");
@@ -262,6 +1084,53 @@ private:
             } else {
                 expression = get_default_value(core::DataType::Int32);
             }
+        } else if (type.name == core::NodeTypes::IntArrayLiteral.name) {
+            const auto text = source_node->get_property<std::string>("values").value_or("");
+            const auto var_name = "var_" + std::to_string(source_node->get_id().value);
+            require_include("<vector>");
+            preamble_ << "    const std::vector<int> " << var_name << "{";
+            const auto values = parse_int_list(text);
+            for (std::size_t index = 0; index < values.size(); ++index) {
+                preamble_ << (index == 0 ? "" : ", ") << values[index];
+            }
+            preamble_ << "};\n";
+            expression = var_name;
+        } else if (const auto operation = array_operation_for(type.name); !operation.empty()) {
+            const auto* port_a = find_port_by_name(*source_node, "a");
+            const auto* port_b = find_port_by_name(*source_node, "b");
+            const auto element_expr = array_element_expression(operation, "a[i]", "b[i]");
+            if (port_a != nullptr && port_b != nullptr && element_expr) {
+                const auto function_name = "mc_array_" + std::string(operation);
+                require_array_helper(function_name,
+                                     make_elementwise_helper(function_name, *element_expr));
+                expression = function_name + "(" + generate_data_expression(*port_a) + ", " +
+                             generate_data_expression(*port_b) + ")";
+            } else {
+                expression = get_default_value(core::DataType::Vector);
+            }
+        } else if (type.name == core::NodeTypes::ArrayMapScalar.name) {
+            const auto scalar_operation =
+                source_node->get_property<std::string>("operation").value_or("mul");
+            const auto* array_port = find_port_by_name(*source_node, "array");
+            const auto* scalar_port = find_port_by_name(*source_node, "scalar");
+            const auto element_expr =
+                array_element_expression(scalar_operation, "a[i]", "scalar");
+            if (array_port != nullptr && scalar_port != nullptr && element_expr) {
+                const auto function_name = "mc_array_" + scalar_operation + "_scalar";
+                require_array_helper(function_name,
+                                     make_scalar_map_helper(function_name, *element_expr));
+                expression = function_name + "(" + generate_data_expression(*array_port) + ", " +
+                             generate_data_expression(*scalar_port) + ")";
+            } else {
+                expression = get_default_value(core::DataType::Vector);
+            }
+        } else if (type.name == core::NodeTypes::ArrayReduceSum.name) {
+            if (const auto* array_port = find_port_by_name(*source_node, "array")) {
+                require_array_helper("mc_array_sum", make_reduce_sum_helper());
+                expression = "mc_array_sum(" + generate_data_expression(*array_port) + ")";
+            } else {
+                expression = get_default_value(core::DataType::Int32);
+            }
         } else if (const auto* start_node = find_start_node();
                    start_node != nullptr && source_node->get_id() == start_node->get_id()) {
             expression = get_default_value(source_port->get_data_type());
@@ -269,10 +1138,251 @@ private:
             expression = get_default_value(input_port.get_data_type());
         }
 
-        generated_expressions_[cache_key] = expression;
+        require_includes_for(expression);
+        // Общее чистое вычисление попадает во временную переменную один раз; зависящее от
+        // индексов — в начало тела цикла, от переменных графа — перед инструкцией
+        const auto& info = values_[value_id];
+        const auto statement_uses = statement_uses_.find(value_id);
+        if (!info.operands.empty() && info.pure && info.uses > 1) {
+            const auto temporary = "cse_" + std::to_string(source_node->get_id().value);
+            preamble_ << "    const " << to_cpp_type(source_port->get_data_type()) << " "
+                      << temporary << " = " << expression << ";\n";
+            expression = temporary;
+        } else if (!info.operands.empty() && !info.pure &&
+                   (is_loop_hoistable(value_id) ||
+                    (statement_uses != statement_uses_.end() && statement_uses->second > 1))) {
+            const auto temporary = "cse_" + std::to_string(source_node->get_id().value) + "_" +
+                                   std::to_string(++scoped_temporaries_);
+            main_body_ << statement_indentation_ << "const "
+                       << to_cpp_type(source_port->get_data_type()) << " " << temporary << " = "
+                       << expression << ";\n";
+            expression = temporary;
+        }
+        if (!values_[value_id].pure) {
+            scoped_values_.push_back(value_id);
+        }
+        generated_expressions_[value_id] = expression;
         return expression;
     }
 
+    // Вход/выход: номер значения выходного порта данных. Порты, вычисляющие одну и ту же
+    // операцию над одинаковыми номерами операндов, получают один номер (hash-consing), поэтому
+    // скопированные подграфы сводятся к одному узлу DAG.
+    // Edge cases: равные литералы сливаются по значению; переменные графа — по имени (их значение
+    // меняется во времени, поэтому такие значения не «чистые»); индекс цикла, выходы Start и
+    // прочие порты — уникальные листья. Повторный вход (цикл в данных) даёт уникальный лист.
+    // Почему так: ключ строится так же, как generate_data_expression выбирает ветвь генерации,
+    // поэтому одинаковый номер гарантирует одинаковый код.
+    auto value_number(const core::Port& output_port) -> std::uint32_t {
+        const auto port_id = output_port.get_id();
+        if (const auto known = port_values_.find(port_id); known != port_values_.end()) {
+            return known->second;
+        }
+        const auto leaf = ValueKey{.operation = "port:" + std::to_string(port_id.value),
+                                   .operands = {}};
+        const auto* node = find_node_with_port(graph_, port_id);
+        if (node == nullptr || !numbering_.insert(port_id).second) {
+            return intern_value(leaf, false);
+        }
+
+        auto key = leaf;
+        bool pure = false;
+        bool reads_variables = false;
+        const auto type = node->get_type().name;
+        const auto operand = [&](const core::Port* input) -> std::optional<std::uint32_t> {
+            if (input == nullptr) {
+                return std::nullopt;
+            }
+            if (const auto* source = get_connected_port(graph_, *input); source != nullptr) {
+                return value_number(*source);
+            }
+            return intern_value(
+                ValueKey{.operation = "default:" + get_default_value(input->get_data_type()),
+                         .operands = {}},
+                true);
+        };
+        const auto operation = [&](std::string name,
+                                   std::initializer_list<const core::Port*> inputs,
+                                   bool commutative) {
+            std::vector<std::uint32_t> operands;
+            for (const auto* input : inputs) {
+                const auto value = operand(input);
+                if (!value) {
+                    return;
+                }
+                operands.push_back(*value);
+            }
+            if (commutative) {
+                std::ranges::sort(operands);
+            }
+            pure = std::ranges::all_of(operands, [&](auto value) { return values_[value].pure; });
+            reads_variables = std::ranges::any_of(
+                operands, [&](auto value) { return values_[value].reads_variables; });
+            key = ValueKey{.operation = std::move(name), .operands = std::move(operands)};
+        };
+
+        if (type == core::NodeTypes::GetVariable.name) {
+            key.operation = "get:" + node->get_property<std::string>("variable_name").value_or("");
+            reads_variables = true;
+        } else if (type == core::NodeTypes::StringLiteral.name) {
+            key.operation = "string:" + node->get_property<std::string>("value").value_or("");
+            pure = true;
+        } else if (type == core::NodeTypes::BoolLiteral.name) {
+            key.operation = node->get_property<bool>("value").value_or(false) ? "bool:1" : "bool:0";
+            pure = true;
+        } else if (type == core::NodeTypes::IntLiteral.name) {
+            key.operation =
+                "int:" + std::to_string(node->get_property<std::int64_t>("value").value_or(0));
+            pure = true;
+        } else if (const auto folded = type == core::NodeTypes::Add.name && options_.fold_constants
+                                           ? fold_int_constant(*node)
+                                           : std::nullopt) {
+            key.operation = "int:" + std::to_string(*folded);
+            pure = true;
+        } else if (type == core::NodeTypes::Add.name) {
+            const auto* port_a = find_port_by_name(*node, "a");
+            const auto* port_b = find_port_by_name(*node, "b");
+            if (port_a != nullptr && port_b != nullptr) {
+                operation("add", {port_a, port_b}, true);
+            }
+        } else if (type == core::NodeTypes::IntArrayLiteral.name) {
+            key.operation = "ints:";
+            for (const auto value :
+                 parse_int_list(node->get_property<std::string>("values").value_or(""))) {
+                key.operation += std::to_string(value) + ",";
+            }
+            pure = true;
+        } else if (const auto array_op = array_operation_for(type); !array_op.empty()) {
+            operation("array_" + std::string(array_op),
+                      {find_port_by_name(*node, "a"), find_port_by_name(*node, "b")}, true);
+        } else if (type == core::NodeTypes::ArrayMapScalar.name) {
+            operation("map_" + node->get_property<std::string>("operation").value_or("mul"),
+                      {find_port_by_name(*node, "array"), find_port_by_name(*node, "scalar")},
+                      false);
+        } else if (type == core::NodeTypes::ArrayReduceSum.name) {
+            operation("sum", {find_port_by_name(*node, "array")}, false);
+        }
+
+        numbering_.erase(port_id);
+        const auto value = intern_value(key, pure, reads_variables);
+        values_[value].sources.push_back(&output_port);
+        port_values_.emplace(port_id, value);
+        return value;
+    }
+
+    auto intern_value(const ValueKey& key, bool pure, bool reads_variables = false)
+        -> std::uint32_t {
+        const auto [entry, inserted] =
+            value_numbers_.try_emplace(key, static_cast<std::uint32_t>(values_.size()));
+        if (inserted) {
+            values_.push_back(ValueInfo{.operands = key.operands, .sources = {}, .uses = 0,
+                                        .pure = pure, .reads_variables = reads_variables});
+        }
+        return entry->second;
+    }
+
+    // Вход/выход: число потребителей каждого значения среди узлов, достижимых от Start по
+    // потоку исполнения; операнды значения учитываются один раз, сколько бы копий его ни было.
+    // Edge cases: границы константного цикла тоже считаются использованием, даже если цикл
+    // будет развёрнут, — в худшем случае появится лишняя временная переменная.
+    void count_value_uses(const core::Node& start) {
+        core::algorithms::depth_first<core::algorithms::ExecEdges>(
+            graph_, start.get_id(),
+            [&](const core::Node& node, std::uint32_t /*depth*/) {
+                for (const auto& port : node.get_ports()) {
+                    if (port.get_direction() != core::PortDirection::Input ||
+                        port.is_execution()) {
+                        continue;
+                    }
+                    if (const auto* source = get_connected_port(graph_, port)) {
+                        add_value_use(value_number(*source));
+                    }
+                }
+            },
+            exec_scratch_);
+    }
+
+    void add_value_use(std::uint32_t value) {
+        if (values_[value].uses++ > 0) {
+            return;
+        }
+        for (const auto operand : values_[value].operands) {
+            add_value_use(operand);
+        }
+    }
+
+    [[nodiscard]] auto is_throughput() const noexcept -> bool {
+        return options_.output_profile == OutputProfile::Throughput;
+    }
+
+    [[nodiscard]] auto literal_qualifier() const noexcept -> std::string_view {
+        return is_throughput() || options_.fold_constants ? "constexpr" : "const";
+    }
+
+    void require_include(std::string_view header) {
+        includes_.emplace(header);
+    }
+
+    void require_includes_for(std::string_view expression) {
+        if (expression.starts_with("std::string(")) {
+            require_include("<string>");
+        } else if (expression.starts_with("std::vector")) {
+            require_include("<vector>");
+        }
+    }
+
+    void require_array_helper(const std::string& name, std::string source) {
+        require_include("<cstddef>");
+        require_include("<vector>");
+        helpers_.try_emplace(name, std::move(source));
+    }
+
+    // Вход/выход: true, если каждый потребитель выхода строкового литерала может работать
+    // с std::string_view (вывод в консоль или присваивание строковой переменной).
+    // Edge cases: литерал без потребителей считается безопасным — он всё равно не используется.
+    // Почему так: string_view не владеет данными, поэтому разрешаем его только там, где значение
+    // сразу копируется или выводится.
+    [[nodiscard]] auto consumers_accept_string_view(const core::Port& output_port) const -> bool {
+        for (const auto& connection : graph_.get_connections()) {
+            if (connection.from_port != output_port.get_id()) {
+                continue;
+            }
+
+            const auto* consumer = graph_.get_node(connection.to_node);
+            if (consumer == nullptr) {
+                return false;
+            }
+
+            const auto consumer_type = consumer->get_type().name;
+            if (consumer_type == core::NodeTypes::PrintString.name) {
+                continue;
+            }
+
+            if (consumer_type == core::NodeTypes::SetVariable.name) {
+                const auto var_name =
+                    consumer->get_property<std::string>("variable_name").value_or("");
+                const auto* variable = graph_.get_variable(var_name);
+                if (variable != nullptr && variable->type == core::DataType::String) {
+                    continue;
+                }
+            }
+
+            return false;
+        }
+        return true;
+    }
+
+    void emit_return(const std::string& indentation) {
+        if (parallel_depth_ > 0 || options_.harness.enabled) {
+            main_body_ << indentation << "return;\n";
+            return;
+        }
+        if (is_throughput() && writes_console_) {
+            main_body_ << indentation << "std::cout.flush();\n";
+        }
+        main_body_ << indentation << "return 0;\n";
+    }
+
     [[nodiscard]] const core::Node* find_start_node() const {
         for (const auto& node : graph_.get_nodes()) {
             if (node->get_type().name == core::NodeTypes::Start.name) {
@@ -297,6 +1407,9 @@ private:
         if (type == core::DataType::Int32) {
             return "0";
         }
+        if (type == core::DataType::Vector || type == core::DataType::Array) {
+            return "std::vector<int>{}";
+        }
         if (type == core::DataType::Any) {
             return "\"(unconnected)\"";
         }
@@ -306,30 +1419,320 @@ private:
     [[nodiscard]] std::string assemble_final_code() const {
         std::stringstream ss;
         ss << "// Generated by MultiCode C++ Code Generator\n";
-        ss << "#include <iostream>\n";
-        ss << "#include <string>\n\n";
+        if (!prelude_header_.empty()) {
+            ss << "#include \"" << prelude_header_ << "\"\n\n";
+        } else {
+            for (const auto& header : required_includes()) {
+                ss << "#include " << header << "\n";
+            }
+            ss << "\n";
+            for (const auto& [name, source] : helpers_) {
+                ss << source << "\n";
+            }
+        }
+        if (options_.harness.enabled) {
+            ss << "void run_graph() {\n";
+            ss << preamble_.str();
+            ss << main_body_.str();
+            ss << "}\n\n";
+            ss << make_harness_main();
+            return ss.str();
+        }
+
         ss << "int main() {\n";
+        // Без синхронизации с stdio одновременная запись в std::cout из потоков — гонка данных.
+        if (is_throughput() && writes_console_ && !has_parallel_branches_) {
+            ss << "    std::ios::sync_with_stdio(false);\n";
+        }
         ss << preamble_.str();
         ss << main_body_.str();
         if (main_body_.str().find("return 0;") == std::string::npos) {
+            if (is_throughput() && writes_console_) {
+                ss << "    std::cout.flush();\n";
+            }
             ss << "    return 0;\n";
         }
         ss << "}\n";
         return ss.str();
     }
 
+    // Вход/выход: после объявлений переменных run_graph() — наблюдатель, который при любом
+    // выходе из функции (в том числе через End) передаёт их значения в mc_harness_sink.
+    // Edge cases: граф без переменных наблюдателя не получает — его видимый эффект только вывод.
+    // Почему так: одна запись в сток на прогон не искажает замер, в отличие от записи на каждый
+    // SetVariable, и не гоняется с потоками ParallelSequence, которые к выходу уже завершены.
+    void emit_harness_observer() {
+        std::string consumers;
+        for (const auto& var : graph_.get_variables()) {
+            if (to_cpp_type(var.type) != "auto") {
+                consumers += " mc_harness_consume(" + var.name + ");";
+            }
+        }
+        if (consumers.empty()) {
+            return;
+        }
+        helpers_.try_emplace("mc_harness_consume", make_harness_sink_helper());
+        preamble_ << "    const mc_harness_observer observe_results{[&] {" << consumers
+                  << " }};\n";
+    }
+
+    // Вход/выход: main стенда — прогрев, N замеров run_graph() по steady_clock и одна строка JSON
+    // (min/median/p99 в наносекундах и число итераций в секунду) последней строкой stdout.
+    // Edge cases: число итераций из argv[1] < 1 заменяется на 1; p99 при малом N — максимум.
+    // Почему так: переменные графа объявлены внутри run_graph(), поэтому каждая итерация
+    // начинается с одинакового состояния и замеры сопоставимы.
+    [[nodiscard]] std::string make_harness_main() const {
+        const auto warmup = std::max(options_.harness.warmup_iterations, 0);
+        const auto iterations = std::max(options_.harness.measured_iterations, 1);
+
+        std::stringstream ss;
+        ss << "int main(int argc, char** argv) {\n";
+        if (is_throughput() && writes_console_ && !has_parallel_branches_) {
+            ss << "    std::ios::sync_with_stdio(false);\n";
+        }
+        ss << "    const int iterations = std::max(argc > 1 ? std::atoi(argv[1]) : " << iterations
+           << ", 1);\n";
+        ss << "    for (int warmup = 0; warmup < " << warmup << "; ++warmup) {\n";
+        ss << "        run_graph();\n";
+        ss << "    }\n\n";
+        ss << "    std::vector<double> samples;\n";
+        ss << "    samples.reserve(static_cast<std::size_t>(iterations));\n";
+        ss << "    for (int iteration = 0; iteration < iterations; ++iteration) {\n";
+        ss << "        const auto begin = std::chrono::steady_clock::now();\n";
+        ss << "        run_graph();\n";
+        ss << "        const auto elapsed = std::chrono::steady_clock::now() - begin;\n";
+        ss << "        samples.push_back(\n";
+        ss << "            std::chrono::duration<double, std::nano>(elapsed).count());\n";
+        ss << "    }\n\n";
+        ss << "    double total_ns = 0.0;\n";
+        ss << "    for (const double sample : samples) {\n";
+        ss << "        total_ns += sample;\n";
+        ss << "    }\n";
+        ss << "    std::sort(samples.begin(), samples.end());\n";
+        ss << "    const std::size_t count = samples.size();\n";
+        // p99 по методу ближайшего ранга: ceil(0.99 * count) - 1
+        ss << "    const std::size_t p99_index =\n";
+        ss << "        std::min(count - 1, (count * 99 + 99) / 100 - 1);\n";
+        ss << "    const double per_second =\n";
+        ss << "        total_ns > 0.0 ? static_cast<double>(count) * 1e9 / total_ns : 0.0;\n\n";
+        ss << "    std::cout << \"{\\\"graph\\\":\\\"" << json_escaped_graph_name() << "\\\"\"\n";
+        ss << "              << \",\\\"warmup\\\":" << warmup << "\"\n";
+        ss << "              << \",\\\"iterations\\\":\" << count\n";
+        ss << "              << \",\\\"min_ns\\\":\" << samples.front()\n";
+        ss << "              << \",\\\"median_ns\\\":\" << samples[count / 2]\n";
+        ss << "              << \",\\\"p99_ns\\\":\" << samples[p99_index]\n";
+        ss << "              << \",\\\"iterations_per_second\\\":\" << per_second << \"}\"\n";
+        ss << "              << std::endl;\n";
+        ss << "    return 0;\n";
+        ss << "}\n";
+        return ss.str();
+    }
+
+    /// @brief Имя графа для строкового литерала внутри JSON: экранирует кавычки и обратные слеши
+    /// на обоих уровнях, управляющие символы отбрасывает.
+    [[nodiscard]] std::string json_escaped_graph_name() const {
+        std::string escaped;
+        for (const char symbol : graph_.get_name()) {
+            if (symbol == '"' || symbol == '\\') {
+                escaped += "\\\\\\";
+                escaped += symbol;
+            } else if (static_cast<unsigned char>(symbol) >= 0x20) {
+                escaped += symbol;
+            }
+        }
+        return escaped;
+    }
+
     const core::Graph& graph_;
+    const CppGeneratorOptions& options_;
+    std::vector<core::Error>& warnings_;
     std::stringstream preamble_;
     std::stringstream main_body_;
-    std::unordered_map<core::PortId, std::string> generated_expressions_;
+    std::set<std::string> includes_;
+    std::map<std::string, std::string> helpers_;
+    std::unordered_map<std::uint32_t, std::string> generated_expressions_;
+    std::unordered_map<ValueKey, std::uint32_t, ValueKeyHash> value_numbers_;
+    std::unordered_map<core::PortId, std::uint32_t> port_values_;
+    std::unordered_set<core::PortId> numbering_;
+    std::vector<ValueInfo> values_;
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> leaf_values_;
+    std::vector<std::uint32_t> scoped_values_;  ///< Нечистые значения в generated_expressions_
+    std::vector<std::uint32_t> active_loop_indices_;  ///< Индексы циклов, чьё тело генерируется
+    std::unordered_map<std::uint32_t, std::uint32_t> statement_uses_;
+    std::string statement_indentation_;
+    std::uint32_t scoped_temporaries_{0};
+    int expression_depth_{0};
+    bool hoisting_loop_values_{false};
+    mutable std::unordered_map<core::NodeId, std::optional<std::int64_t>> folded_;
+    core::algorithms::TraversalScratch exec_scratch_;
+    core::algorithms::TraversalScratch data_scratch_;
+    std::string prelude_header_;
+    const ExecutionProfile* profile_{nullptr};
+    std::unordered_set<core::NodeId> reported_cold_;
     int recursion_depth_{0};
+    int parallel_depth_{0};
+    bool writes_console_{false};
+    bool has_parallel_branches_{false};
+    bool in_cold_code_{false};
 };
 
+/// @brief Имена целей, которые CMake резервирует за собой (CMP0037), — в любом регистре.
+constexpr std::array<std::string_view, 17> kReservedTargetNames{
+    "all",         "clean",          "help",          "install",      "test",
+    "package",     "package_source", "edit_cache",    "rebuild_cache", "depend",
+    "preinstall",  "all_build",      "zero_check",    "run_tests",    "continuous",
+    "experimental", "nightly"};
+
+[[nodiscard]] auto is_reserved_target_name(std::string_view name) -> bool {
+    return std::ranges::any_of(kReservedTargetNames, [&](std::string_view reserved) {
+        return std::ranges::equal(name, reserved, [](char lhs, char rhs) {
+            return std::tolower(static_cast<unsigned char>(lhs)) == rhs;
+        });
+    });
+}
+
+/// @brief Имя файла/цели CMake из имени графа: [A-Za-z0-9_], не начинается с цифры и не
+/// совпадает с зарезервированными CMake целями.
+[[nodiscard]] auto make_unit_name(std::string_view graph_name) -> std::string {
+    std::string name;
+    name.reserve(graph_name.size());
+    for (const char symbol : graph_name) {
+        const auto byte = static_cast<unsigned char>(symbol);
+        name.push_back(std::isalnum(byte) != 0 && byte < 0x80 ? symbol : '_');
+    }
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front())) != 0 ||
+        is_reserved_target_name(name)) {
+        name.insert(0, "graph_");
+    }
+    return name;
+}
+
+[[nodiscard]] auto make_prelude(const std::set<std::string>& includes,
+                                const std::map<std::string, std::string>& helpers)
+    -> std::string {
+    std::stringstream ss;
+    ss << "// Generated by MultiCode C++ Code Generator\n";
+    ss << "// Shared prelude: included first by every generated translation unit.\n";
+    ss << "#pragma once\n\n";
+    for (const auto& header : includes) {
+        ss << "#include " << header << "\n";
+    }
+    for (const auto& [name, source] : helpers) {
+        ss << "\n" << source;
+    }
+    return ss.str();
+}
+
+// Вход/выход: CMakeLists.txt с одной целью на граф; прелюдия собирается как PCH один раз,
+// остальные цели переиспользуют её через REUSE_FROM.
+// Почему так: REUSE_FROM требует одинаковых флагов компиляции — все цели получают одни и те же
+// настройки стандарта и Threads, поэтому это условие выполняется.
+[[nodiscard]] auto make_project_cmake(const ProjectOptions& project,
+                                      const std::vector<std::string>& units,
+                                      bool needs_threads) -> std::string {
+    std::stringstream ss;
+    ss << "# Generated by MultiCode C++ Code Generator\n";
+    ss << "cmake_minimum_required(VERSION 3.16)\n";
+    ss << "project(" << make_unit_name(project.project_name) << " LANGUAGES CXX)\n\n";
+    ss << "set(CMAKE_CXX_STANDARD 20)\n";
+    ss << "set(CMAKE_CXX_STANDARD_REQUIRED ON)\n\n";
+    ss << "option(MULTICODE_USE_PCH \"Build " << project.prelude_header
+       << " as a precompiled header\" " << (project.precompile_prelude ? "ON" : "OFF")
+       << ")\n\n";
+    if (needs_threads) {
+        ss << "find_package(Threads REQUIRED)\n\n";
+    }
+    for (const auto& unit : units) {
+        ss << "add_executable(" << unit << " " << unit << ".cpp)\n";
+        if (needs_threads) {
+            ss << "target_link_libraries(" << unit << " PRIVATE Threads::Threads)\n";
+        }
+    }
+    ss << "\nif(MULTICODE_USE_PCH)\n";
+    for (std::size_t index = 0; index < units.size(); ++index) {
+        if (index == 0) {
+            ss << "    target_precompile_headers(" << units[index] << " PRIVATE \""
+               << project.prelude_header << "\")\n";
+        } else {
+            ss << "    target_precompile_headers(" << units[index] << " REUSE_FROM "
+               << units.front() << ")\n";
+        }
+    }
+    ss << "endif()\n";
+    return ss.str();
+}
+
 }  // namespace
 
+CppCodeGenerator::CppCodeGenerator(CppGeneratorOptions options) noexcept : options_(options) {}
+
 auto CppCodeGenerator::generate(const core::Graph& graph) -> core::Result<std::string> {
-    GraphCodeBuilder builder(graph);
+    warnings_.clear();
+    GraphCodeBuilder builder(graph, options_, warnings_);
+    if (!profile_.empty()) {
+        builder.use_profile(profile_);
+    }
     return builder.build();
 }
 
+auto CppCodeGenerator::generate_project(std::span<const core::Graph* const> graphs,
+                                        const ProjectOptions& project)
+    -> core::Result<std::vector<GeneratedFile>> {
+    using ProjectResult = core::Result<std::vector<GeneratedFile>>;
+
+    warnings_.clear();
+    if (graphs.empty()) {
+        return ProjectResult{core::Error{"Project must contain at least one graph."}};
+    }
+
+    std::vector<GeneratedFile> files;
+    files.reserve(graphs.size() + 2);
+    files.push_back(GeneratedFile{.path = project.prelude_header, .content = {}});
+
+    std::set<std::string> includes;
+    std::map<std::string, std::string> helpers;
+    std::vector<std::string> units;
+    std::unordered_set<std::string> used_names;
+    units.reserve(graphs.size());
+
+    for (std::size_t index = 0; index < graphs.size(); ++index) {
+        const auto* graph = graphs[index];
+        if (graph == nullptr) {
+            return ProjectResult{
+                core::Error{core::compat::format("Project graph #", index, " is null.")}};
+        }
+
+        GraphCodeBuilder builder(*graph, options_, warnings_);
+        builder.use_prelude(project.prelude_header);
+        if (!profile_.empty()) {
+            builder.use_profile(profile_);
+        }
+        auto code = builder.build();
+        if (!code) {
+            return ProjectResult{core::Error{
+                core::compat::format("Graph '", graph->get_name(), "': ", code.error().message),
+                code.error().code}};
+        }
+
+        // Суффикс растёт, пока имя не станет свободным: "a_2", "a", "a" дают a_2, a, a_3
+        const auto base_name = make_unit_name(graph->get_name());
+        auto unit = base_name;
+        for (auto suffix = index; !used_names.insert(unit).second; ++suffix) {
+            unit = base_name + "_" + std::to_string(suffix);
+        }
+
+        const auto unit_includes = builder.required_includes();
+        includes.insert(unit_includes.begin(), unit_includes.end());
+        helpers.insert(builder.helpers().begin(), builder.helpers().end());
+        files.push_back(GeneratedFile{.path = unit + ".cpp", .content = std::move(code.value())});
+        units.push_back(std::move(unit));
+    }
+
+    files.front().content = make_prelude(includes, helpers);
+    files.push_back(GeneratedFile{
+        .path = "CMakeLists.txt",
+        .content = make_project_cmake(project, units, includes.contains("<thread>"))});
+    return ProjectResult{std::move(files)};
+}
+
 }  // namespace visprog::generators
@@ -0,0 +1,71 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#pragma once
+
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "visprog/core/Graph.hpp"
+#include "visprog/core/NodeFactory.hpp"
+
+/// @file TestGraphHelpers.hpp
+/// @brief Общие помощники тестов ядра: поиск портов по имени и сборка графов.
+
+namespace visprog::test {
+
+/// @brief Порт узла по имени; PortId{0}, если его нет (connect() такой порт отклонит).
+inline auto find_port_id(const core::Node& node, std::string_view name) -> core::PortId {
+    for (const auto& port : node.get_ports()) {
+        if (port.get_name() == name) {
+            return port.get_id();
+        }
+    }
+    return core::PortId{0};
+}
+
+/// @brief Соединить порты по именам; тест останавливается, если граф отклонил связь.
+inline auto require_connect(core::Graph& graph,
+                            core::NodeId from_node,
+                            std::string_view from_port_name,
+                            core::NodeId to_node,
+                            std::string_view to_port_name) -> core::ConnectionId {
+    const auto from_port = find_port_id(*graph.get_node(from_node), from_port_name);
+    const auto to_port = find_port_id(*graph.get_node(to_node), to_port_name);
+    auto result = graph.connect(from_node, from_port, to_node, to_port);
+    REQUIRE(result.has_value());
+    return result.value();
+}
+
+/// @brief Добавить узел типа type с одним заданным свойством.
+template <typename T>
+auto add_with_property(core::Graph& graph,
+                       const core::NodeType& type,
+                       const std::string& key,
+                       T value) -> core::NodeId {
+    const auto id = graph.add_node(core::NodeFactory::create(type));
+    graph.get_node_mut(id)->set_property(key, std::move(value));
+    return id;
+}
+
+/// @brief Цепочка depth узлов Add(x, x) над выходом source_port узла source: каждый выход питает
+/// оба входа следующего узла, поэтому обход без кеша проходит 2^depth путей. Возвращает
+/// последний Add.
+inline auto add_doubling_chain(core::Graph& graph,
+                               core::NodeId source,
+                               std::string_view source_port,
+                               int depth) -> core::NodeId {
+    auto current = source;
+    auto port = source_port;
+    for (int i = 0; i < depth; ++i) {
+        const auto add = graph.add_node(core::NodeFactory::create(core::NodeTypes::Add));
+        require_connect(graph, current, port, add, "a");
+        require_connect(graph, current, port, add, "b");
+        current = add;
+        port = "result";
+    }
+    return current;
+}
+
+}  // namespace visprog::test
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "visprog/core/ColumnarEvaluator.hpp"
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/NodeFactory.hpp"
+
+#include "TestGraphHelpers.hpp"
+
+using namespace visprog::core;
+using namespace visprog::test;
+
+namespace {
+
+auto add_sum(Graph& graph, NodeId lhs, std::string_view lhs_port, NodeId rhs,
+             std::string_view rhs_port) -> NodeId {
+    const auto id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    require_connect(graph, lhs, lhs_port, id, "a");
+    require_connect(graph, rhs, rhs_port, id, "b");
+    return id;
+}
+
+}  // namespace
+
+TEST_CASE("ColumnarEvaluator: evaluates a pure subgraph over whole columns", "[columnar]") {
+    Graph graph;
+    REQUIRE(graph.add_variable("price", DataType::Int32).has_value());
+    REQUIRE(graph.add_variable("tax", DataType::Int32).has_value());
+    const auto price = add_with_property(graph, NodeTypes::GetVariable, "variable_name",
+                                         std::string("price"));
+    const auto price_copy = add_with_property(graph, NodeTypes::GetVariable, "variable_name",
+                                              std::string("price"));
+    const auto tax = add_with_property(graph, NodeTypes::GetVariable, "variable_name",
+                                       std::string("tax"));
+    const auto ten = add_with_property(graph, NodeTypes::IntLiteral, "value", std::int64_t{10});
+    const auto two = add_with_property(graph, NodeTypes::IntLiteral, "value", std::int64_t{2});
+
+    // total = (price + tax) + 10; constant = 2 + 10; twice = price + price
+    const auto gross = add_sum(graph, price, "value-out", tax, "value-out");
+    const auto total = add_sum(graph, gross, "result", ten, "result");
+    const auto constant = add_sum(graph, two, "result", ten, "result");
+    const auto twice = add_sum(graph, price, "value-out", price_copy, "value-out");
+
+    const std::vector<NodeId> outputs{total, constant, twice, tax};
+    auto evaluator = ColumnarEvaluator::compile(graph, outputs);
+    REQUIRE(evaluator.has_value());
+    REQUIRE(evaluator.value().input_names().size() == 2);
+
+    // Длина пакета не кратна размеру блока, последний блок неполный
+    constexpr std::size_t kRecords = 5000;
+    std::vector<std::int64_t> prices(kRecords);
+    std::vector<std::int64_t> taxes(kRecords);
+    for (std::size_t i = 0; i < kRecords; ++i) {
+        prices[i] = static_cast<std::int64_t>(i) * 3 - 700;
+        taxes[i] = static_cast<std::int64_t>(i % 17);
+    }
+    prices.back() = std::numeric_limits<std::int64_t>::max();
+    taxes.back() = 1;
+
+    const std::vector<ColumnInput> inputs{{.variable = "tax", .values = taxes},
+                                          {.variable = "price", .values = prices}};
+    auto result = evaluator.value().evaluate(inputs);
+    REQUIRE(result.has_value());
+    const auto& batch = result.value();
+    REQUIRE(batch.records == kRecords);
+    REQUIRE(batch.columns.size() == outputs.size());
+    CHECK(batch.records_per_second() >= 0.0);
+
+    bool matches = true;
+    for (std::size_t i = 0; i + 1 < kRecords; ++i) {
+        matches = matches && batch.columns[0][i] == prices[i] + taxes[i] + 10 &&
+                  batch.columns[1][i] == 12 && batch.columns[2][i] == 2 * prices[i] &&
+                  batch.columns[3][i] == taxes[i];
+    }
+    CHECK(matches);
+    // Переполнение — по модулю 2^64, как в сгенерированном коде на двух дополнениях
+    CHECK(batch.columns[0].back() == std::numeric_limits<std::int64_t>::min() + 10);
+}
+
+TEST_CASE("ColumnarEvaluator: reports unsupported graphs and bad input", "[columnar]") {
+    Graph graph;
+    const auto value = add_with_property(graph, NodeTypes::GetVariable, "variable_name",
+                                         std::string("value"));
+    const auto text = add_with_property(graph, NodeTypes::StringLiteral, "value",
+                                        std::string("x"));
+    const auto next = add_with_property(graph, NodeTypes::IntLiteral, "value", std::int64_t{1});
+    const auto increment = add_sum(graph, value, "value-out", next, "result");
+    const auto print = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    const std::vector<NodeId> unsupported{text};
+    CHECK(ColumnarEvaluator::compile(graph, unsupported).error().code ==
+          error_codes::columnar::UnsupportedNode);
+    const std::vector<NodeId> exec_node{print};
+    CHECK(ColumnarEvaluator::compile(graph, exec_node).error().code ==
+          error_codes::columnar::UnsupportedNode);
+    const std::vector<NodeId> missing_node{NodeId{9999}};
+    CHECK(ColumnarEvaluator::compile(graph, missing_node).error().code ==
+          error_codes::columnar::InvalidOutput);
+
+    const std::vector<NodeId> outputs{increment};
+    auto evaluator = ColumnarEvaluator::compile(graph, outputs);
+    REQUIRE(evaluator.has_value());
+    const std::vector<std::int64_t> column{1, 2, 3};
+    const std::vector<ColumnInput> wrong_name{{.variable = "other", .values = column}};
+    CHECK(evaluator.value().evaluate(wrong_name).error().code ==
+          error_codes::columnar::MissingInput);
+
+    const std::vector<ColumnInput> empty{{.variable = "value", .values = {}}};
+    auto none = evaluator.value().evaluate(empty);
+    REQUIRE(none.has_value());
+    CHECK(none.value().records == 0);
+    CHECK(none.value().columns.front().empty());
+
+    const auto other = add_with_property(graph, NodeTypes::GetVariable, "variable_name",
+                                         std::string("other"));
+    const std::vector<NodeId> pair{add_sum(graph, value, "value-out", other, "value-out")};
+    auto two_inputs = ColumnarEvaluator::compile(graph, pair);
+    REQUIRE(two_inputs.has_value());
+    const std::vector<std::int64_t> shorter{1, 2};
+    const std::vector<ColumnInput> uneven{{.variable = "value", .values = column},
+                                          {.variable = "other", .values = shorter}};
+    CHECK(two_inputs.value().evaluate(uneven).error().code ==
+          error_codes::columnar::ColumnLengthMismatch);
+}
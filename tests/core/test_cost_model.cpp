@@ -0,0 +1,191 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include "visprog/core/CostModel.hpp"
+#include "visprog/core/NodeFactory.hpp"
+
+#include "TestGraphHelpers.hpp"
+
+using namespace visprog::core;
+using namespace visprog::test;
+
+namespace {
+
+auto add_int_literal(Graph& graph, std::int64_t value) -> NodeId {
+    const auto id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    graph.get_node_mut(id)->set_property("value", value);
+    return id;
+}
+
+auto add_loop(Graph& graph, std::int64_t first, std::int64_t last) -> NodeId {
+    const auto loop_id = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+    require_connect(graph, add_int_literal(graph, first), "result", loop_id, "first");
+    require_connect(graph, add_int_literal(graph, last), "result", loop_id, "last");
+    return loop_id;
+}
+
+}  // namespace
+
+TEST_CASE("CostModel: trip counts propagate through nested loops", "[cost_model]") {
+    Graph graph;
+    const auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto outer_id = add_loop(graph, 0, 1000);
+    const auto inner_id = add_loop(graph, 0, 100);
+    const auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto end_id = graph.add_node(NodeFactory::create(NodeTypes::End));
+
+    require_connect(graph, start_id, "exec-out", outer_id, "exec-in");
+    require_connect(graph, outer_id, "loop-body", inner_id, "exec-in");
+    require_connect(graph, inner_id, "loop-body", print_id, "exec-in");
+    require_connect(graph, inner_id, "index", print_id, "string");
+    require_connect(graph, outer_id, "completed", end_id, "exec-in");
+
+    const auto estimate = CostModel::estimate(graph);
+
+    const auto* outer = estimate.find(outer_id);
+    const auto* inner = estimate.find(inner_id);
+    const auto* print = estimate.find(print_id);
+    const auto* end = estimate.find(end_id);
+    REQUIRE(outer != nullptr);
+    REQUIRE(inner != nullptr);
+    REQUIRE(print != nullptr);
+    REQUIRE(end != nullptr);
+
+    CHECK(outer->execution_count == 1.0);
+    CHECK(inner->execution_count == 1000.0);
+    CHECK(print->execution_count == 100'000.0);
+    CHECK(end->execution_count == 1.0);
+    CHECK(print->loop_depth == 2);
+
+    CHECK(outer->hot_spot == HotSpotKind::None);
+    CHECK(inner->hot_spot == HotSpotKind::NestedLoop);
+    CHECK(print->hot_spot == HotSpotKind::ExpensiveInLoop);
+    CHECK(print->total_cost == print->execution_count * print->cost_weight);
+
+    const auto hot_spots = estimate.hot_spots();
+    REQUIRE(hot_spots.size() == 2);
+    CHECK(hot_spots.front()->node == print_id);
+}
+
+TEST_CASE("CostModel: string copies inside loops are flagged", "[cost_model]") {
+    Graph graph;
+    REQUIRE(graph.add_variable("message", DataType::String));
+
+    const auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto loop_id = add_loop(graph, 0, 10);
+    const auto text_id = graph.add_node(NodeFactory::create(NodeTypes::StringLiteral));
+    const auto set_id = graph.add_node(NodeFactory::create(NodeTypes::SetVariable));
+    graph.get_node_mut(set_id)->set_property("variable_name", std::string("message"));
+
+    require_connect(graph, start_id, "exec-out", loop_id, "exec-in");
+    require_connect(graph, loop_id, "loop-body", set_id, "exec-in");
+    require_connect(graph, text_id, "result", set_id, "value-in");
+
+    const auto estimate = CostModel::estimate(graph);
+
+    const auto* set = estimate.find(set_id);
+    REQUIRE(set != nullptr);
+    CHECK(set->execution_count == 10.0);
+    CHECK(set->hot_spot == HotSpotKind::StringInLoop);
+    // Литерал вынесен в преамбулу и вычисляется один раз
+    CHECK(estimate.find(text_id)->execution_count == 1.0);
+    CHECK(estimate.find(loop_id)->hot_spot == HotSpotKind::None);
+}
+
+TEST_CASE("CostModel: branches and unknown bounds use configured estimates", "[cost_model]") {
+    Graph graph;
+    const auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto loop_id = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+    const auto bound_id = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+    const auto branch_id = graph.add_node(NodeFactory::create(NodeTypes::Branch));
+    const auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto orphan_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    require_connect(graph, start_id, "exec-out", loop_id, "exec-in");
+    require_connect(graph, bound_id, "value-out", loop_id, "last");
+    require_connect(graph, loop_id, "loop-body", branch_id, "exec-in");
+    require_connect(graph, branch_id, "true", print_id, "exec-in");
+
+    const auto estimate =
+        CostModel::estimate(graph, CostModelOptions{.unknown_trip_count = 40.0,
+                                                    .branch_probability = 0.25});
+
+    CHECK(estimate.find(branch_id)->execution_count == 40.0);
+    CHECK(estimate.find(print_id)->execution_count == 10.0);
+    CHECK(estimate.find(bound_id)->execution_count == 1.0);
+    CHECK(estimate.find(orphan_id)->execution_count == 0.0);
+
+    const auto json = CostModel::to_json(estimate);
+    REQUIRE(json["nodes"].size() == graph.node_count());
+    CHECK(json["totalCost"].get<double>() == estimate.total_cost);
+    CHECK(json["nodes"][0]["id"].get<std::uint64_t>() == start_id.value);
+    CHECK_FALSE(json["nodes"][0].contains("hotSpot"));
+}
+
+TEST_CASE("CostModel: out-of-range constant bounds are treated as unknown", "[cost_model]") {
+    Graph graph;
+    const auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto extreme_id = add_loop(graph, std::numeric_limits<std::int64_t>::min(),
+                                     std::numeric_limits<std::int64_t>::max());
+    // Add(INT_MAX, INT_MAX) переполняет int, Add(INT64_MAX, 1) — int64
+    const auto overflow_id = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+    const auto int_sum_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    const auto int_max_id = add_int_literal(graph, std::numeric_limits<int>::max());
+    require_connect(graph, int_max_id, "result", int_sum_id, "a");
+    require_connect(graph, int_max_id, "result", int_sum_id, "b");
+    require_connect(graph, int_sum_id, "result", overflow_id, "last");
+    const auto wide_id = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+    const auto wide_sum_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    require_connect(graph, add_int_literal(graph, std::numeric_limits<std::int64_t>::max()),
+                    "result", wide_sum_id, "a");
+    require_connect(graph, add_int_literal(graph, 1), "result", wide_sum_id, "b");
+    require_connect(graph, wide_sum_id, "result", wide_id, "last");
+    const auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    require_connect(graph, start_id, "exec-out", extreme_id, "exec-in");
+    require_connect(graph, extreme_id, "loop-body", overflow_id, "exec-in");
+    require_connect(graph, overflow_id, "loop-body", wide_id, "exec-in");
+    require_connect(graph, wide_id, "loop-body", print_id, "exec-in");
+
+    const auto estimate =
+        CostModel::estimate(graph, CostModelOptions{.unknown_trip_count = 4.0});
+    CHECK(estimate.find(overflow_id)->execution_count == 4.0);
+    CHECK(estimate.find(wide_id)->execution_count == 16.0);
+    CHECK(estimate.find(print_id)->execution_count == 64.0);
+}
+
+TEST_CASE("CostModel: shared paths are counted in linear time", "[cost_model]") {
+    // 2^24 exec-путей через цепочку Sequence и 2^24 путей данных через цепочку Add:
+    // перебор путей не закончился бы, а ответ известен в замкнутой форме
+    constexpr int kDepth = 24;
+    Graph graph;
+    const auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto loop_id = add_loop(graph, 0, 10);
+    require_connect(graph, start_id, "exec-out", loop_id, "exec-in");
+
+    auto previous = graph.add_node(NodeFactory::create(NodeTypes::Sequence));
+    require_connect(graph, loop_id, "loop-body", previous, "exec-in");
+    for (int i = 0; i < kDepth; ++i) {
+        const auto sequence = graph.add_node(NodeFactory::create(NodeTypes::Sequence));
+        require_connect(graph, previous, "then-0", sequence, "exec-in");
+        require_connect(graph, previous, "then-1", sequence, "exec-in");
+        previous = sequence;
+    }
+    const auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    require_connect(graph, previous, "then-0", print_id, "exec-in");
+    const auto sum_id = add_doubling_chain(graph, loop_id, "index", kDepth);
+    require_connect(graph, sum_id, "result", print_id, "string");
+
+    const auto estimate = CostModel::estimate(graph);
+    constexpr double kPaths = 1 << kDepth;
+    CHECK(estimate.find(previous)->execution_count == 10.0 * kPaths);
+    CHECK(estimate.find(print_id)->execution_count == 10.0 * kPaths);
+    // Одно выполнение Print вычисляет каждый Add цепочки один раз
+    CHECK(estimate.find(sum_id)->execution_count == 10.0 * kPaths);
+    CHECK(estimate.find(sum_id)->loop_depth == 1);
+}
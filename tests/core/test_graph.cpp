@@ -185,3 +185,50 @@ TEST_CASE("Graph: validate ловит повреждённые связи и и
         }));
     }
 }
+
+TEST_CASE("Graph: компоненты связности объединяются при connect и пересобираются лениво",
+          "[graph][components]") {
+    Graph graph("components");
+    const auto start = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto first = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto second = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto island = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    CHECK(graph.component_count() == 4);
+
+    const auto* start_node = graph.get_node(start);
+    const auto* first_node = graph.get_node(first);
+    const auto* second_node = graph.get_node(second);
+    REQUIRE(graph.connect(start, first_exec_out(*start_node), first, first_exec_in(*first_node)));
+    const auto bridge = graph.connect(
+        first, first_exec_out(*first_node), second, first_exec_in(*second_node));
+    REQUIRE(bridge.has_value());
+
+    // connect поддерживает разбиение без пересборки
+    CHECK_FALSE(graph.components_dirty_);
+    CHECK(graph.component_count() == 2);
+    CHECK(graph.same_component(start, second));
+    CHECK_FALSE(graph.same_component(start, island));
+    CHECK(graph.component_of(NodeId{999'999}) == NodeId{0});
+
+    const auto groups = graph.components();
+    REQUIRE(groups.size() == 2);
+    CHECK(groups[0] == std::vector<NodeId>{start, first, second});
+    CHECK(groups[1] == std::vector<NodeId>{island});
+
+    REQUIRE(graph.disconnect(bridge.value()));
+    CHECK(graph.components_dirty_);
+    CHECK(graph.component_count() == 3);
+    CHECK_FALSE(graph.components_dirty_);
+    CHECK_FALSE(graph.same_component(first, second));
+
+    REQUIRE(graph.remove_node(first));
+    CHECK(graph.component_count() == 3);
+    REQUIRE(graph.remove_node(island));
+    CHECK_FALSE(graph.components_dirty_);
+    CHECK(graph.component_count() == 2);
+
+    REQUIRE(graph.undo());  // island возвращается одиночной компонентой
+    REQUIRE(graph.undo());  // first возвращается вместе со связью start → first
+    CHECK(graph.component_count() == 3);
+    CHECK(graph.same_component(start, first));
+}
@@ -0,0 +1,191 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <string_view>
+#include <vector>
+
+#include "visprog/core/GraphAlgorithms.hpp"
+#include "visprog/core/NodeFactory.hpp"
+
+#include "TestGraphHelpers.hpp"
+
+using namespace visprog::core;
+using namespace visprog::test;
+namespace algorithms = visprog::core::algorithms;
+
+namespace {
+
+/// Start → Sequence(then-0 → PrintA, then-1 → PrintB); литерал → PrintA, Add → PrintB.
+struct SampleGraph {
+    Graph graph;
+    NodeId start;
+    NodeId sequence;
+    NodeId print_a;
+    NodeId print_b;
+    NodeId literal;
+    NodeId add;
+};
+
+auto build_sample() -> SampleGraph {
+    SampleGraph sample;
+    auto& graph = sample.graph;
+    sample.start = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    sample.sequence = graph.add_node(NodeFactory::create(NodeTypes::Sequence));
+    sample.print_a = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    sample.print_b = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    sample.literal = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    sample.add = graph.add_node(NodeFactory::create(NodeTypes::Add));
+
+    require_connect(graph, sample.start, "exec-out", sample.sequence, "exec-in");
+    require_connect(graph, sample.sequence, "then-0", sample.print_a, "exec-in");
+    require_connect(graph, sample.sequence, "then-1", sample.print_b, "exec-in");
+    require_connect(graph, sample.literal, "result", sample.print_a, "string");
+    require_connect(graph, sample.literal, "result", sample.add, "a");
+    require_connect(graph, sample.add, "result", sample.print_b, "string");
+    return sample;
+}
+
+}  // namespace
+
+TEST_CASE("GraphAlgorithms: BFS and DFS follow filtered edges", "[algorithms]") {
+    auto sample = build_sample();
+    algorithms::TraversalScratch scratch;
+
+    std::vector<NodeId> order;
+    std::vector<std::uint32_t> depths;
+    const auto bfs_count = algorithms::breadth_first<algorithms::ExecEdges>(
+        sample.graph, sample.start,
+        [&](const Node& node, std::uint32_t depth) {
+            order.push_back(node.get_id());
+            depths.push_back(depth);
+        },
+        scratch);
+    CHECK(bfs_count == 4);
+    CHECK(order == std::vector<NodeId>{sample.start, sample.sequence, sample.print_a,
+                                       sample.print_b});
+    CHECK(depths == std::vector<std::uint32_t>{0, 1, 2, 2});
+
+    order.clear();
+    const auto dfs_count = algorithms::depth_first<algorithms::AllEdges>(
+        sample.graph, sample.sequence,
+        [&](const Node& node, std::uint32_t /*depth*/) { order.push_back(node.get_id()); },
+        scratch);
+    CHECK(dfs_count == 3);
+    CHECK(order == std::vector<NodeId>{sample.sequence, sample.print_a, sample.print_b});
+}
+
+TEST_CASE("GraphAlgorithms: reverse traversal and visitor actions", "[algorithms]") {
+    auto sample = build_sample();
+    algorithms::TraversalScratch scratch;
+
+    std::vector<NodeId> upstream;
+    algorithms::breadth_first<algorithms::DataEdges, algorithms::Direction::Reverse>(
+        sample.graph, sample.print_b,
+        [&](const Node& node, std::uint32_t /*depth*/) { upstream.push_back(node.get_id()); },
+        scratch);
+    CHECK(upstream == std::vector<NodeId>{sample.print_b, sample.add, sample.literal});
+
+    std::vector<NodeId> skipped;
+    algorithms::depth_first<algorithms::ExecEdges>(
+        sample.graph, sample.start,
+        [&](const Node& node, std::uint32_t /*depth*/) {
+            skipped.push_back(node.get_id());
+            return node.get_id() == sample.sequence ? algorithms::VisitAction::SkipChildren
+                                                    : algorithms::VisitAction::Continue;
+        },
+        scratch);
+    CHECK(skipped == std::vector<NodeId>{sample.start, sample.sequence});
+
+    std::size_t visits = 0;
+    const auto stopped = algorithms::breadth_first(
+        sample.graph, sample.start,
+        [&](const Node& /*node*/, std::uint32_t /*depth*/) {
+            ++visits;
+            return algorithms::VisitAction::Stop;
+        },
+        scratch);
+    CHECK(stopped == 1);
+    CHECK(visits == 1);
+}
+
+TEST_CASE("GraphAlgorithms: topological visit reports levels and cycles", "[algorithms]") {
+    auto sample = build_sample();
+    algorithms::TraversalScratch scratch;
+
+    std::vector<NodeId> order;
+    std::uint32_t max_level = 0;
+    const bool acyclic = algorithms::topological_visit<algorithms::DataEdges>(
+        sample.graph,
+        [&](const Node& node, std::uint32_t level) {
+            order.push_back(node.get_id());
+            max_level = std::max(max_level, level);
+        },
+        scratch);
+    CHECK(acyclic);
+    CHECK(order.size() == sample.graph.node_count());
+    CHECK(max_level == 2);  // literal → add → print_b
+
+    const auto position = [&](NodeId id) { return std::ranges::find(order, id) - order.begin(); };
+    CHECK(position(sample.literal) < position(sample.add));
+    CHECK(position(sample.add) < position(sample.print_b));
+
+    // Цикл по exec-связям: print_a → print_b → print_a
+    require_connect(sample.graph, sample.print_a, "exec-out", sample.print_b, "exec-in");
+    require_connect(sample.graph, sample.print_b, "exec-out", sample.print_a, "exec-in");
+    std::size_t visited = 0;
+    CHECK_FALSE(algorithms::topological_visit<algorithms::ExecEdges>(
+        sample.graph, [&](const Node& /*node*/, std::uint32_t /*level*/) { ++visited; },
+        scratch));
+    // Посещены все узлы, кроме двух узлов цикла, у которых входящая степень не обнуляется
+    CHECK(visited == sample.graph.node_count() - 2);
+}
+
+TEST_CASE("GraphAlgorithms: repeated traversals reuse scratch buffers", "[algorithms]") {
+    auto sample = build_sample();
+    algorithms::TraversalScratch scratch;
+    const auto noop = [](const Node& /*node*/, std::uint32_t /*depth*/) {};
+
+    algorithms::breadth_first(sample.graph, sample.start, noop, scratch);
+    algorithms::topological_visit(sample.graph, noop, scratch);
+    const auto warmed_up = scratch.footprint();
+    REQUIRE(warmed_up > 0);
+
+    for (int round = 0; round < 10; ++round) {
+        algorithms::breadth_first(sample.graph, sample.start, noop, scratch);
+        algorithms::depth_first<algorithms::AllEdges, algorithms::Direction::Reverse>(
+            sample.graph, sample.print_b, noop, scratch);
+        algorithms::topological_visit(sample.graph, noop, scratch);
+    }
+    CHECK(scratch.footprint() == warmed_up);
+}
+
+TEST_CASE("GraphAlgorithms: scratch index follows graph edits", "[algorithms]") {
+    auto sample = build_sample();
+    for (int i = 0; i < 150; ++i) {
+        (void)sample.graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    }
+    algorithms::TraversalScratch scratch;
+    std::vector<NodeId> seen;
+    const auto collect = [&](const Node& node, std::uint32_t /*depth*/) {
+        seen.push_back(node.get_id());
+    };
+
+    // Повторные обходы того же графа не перестраивают индекс, но видят чистые отметки
+    CHECK(algorithms::breadth_first(sample.graph, sample.start, collect, scratch) == 4);
+    CHECK(algorithms::breadth_first(sample.graph, sample.literal, collect, scratch) == 4);
+    CHECK(algorithms::breadth_first(sample.graph, sample.start, collect, scratch) == 4);
+
+    // Новый узел и связь меняют revision() — индекс перестраивается
+    const auto tail = sample.graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    require_connect(sample.graph, sample.print_b, "exec-out", tail, "exec-in");
+    seen.clear();
+    CHECK(algorithms::breadth_first(sample.graph, sample.start, collect, scratch) == 5);
+    CHECK(seen.back() == tail);
+
+    // Другой граф получает свой индекс
+    auto other = build_sample();
+    seen.clear();
+    CHECK(algorithms::breadth_first(other.graph, other.start, collect, scratch) == 4);
+    CHECK(seen.front() == other.start);
+}
@@ -0,0 +1,156 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "visprog/core/GraphClustering.hpp"
+#include "visprog/core/NodeFactory.hpp"
+
+#include "TestGraphHelpers.hpp"
+
+using namespace visprog::core;
+using namespace visprog::test;
+
+namespace {
+
+/// Плотная группа: литерал питает цепочку Add, каждый Add берёт два предыдущих значения.
+auto add_dense_group(Graph& graph) -> std::vector<NodeId> {
+    std::vector<NodeId> group{graph.add_node(NodeFactory::create(NodeTypes::IntLiteral))};
+    for (int i = 0; i < 5; ++i) {
+        const auto add = graph.add_node(NodeFactory::create(NodeTypes::Add));
+        const auto lhs = group.size() >= 2 ? group[group.size() - 2] : group.back();
+        require_connect(graph, lhs, "result", add, "a");
+        require_connect(graph, group.back(), "result", add, "b");
+        group.push_back(add);
+    }
+    return group;
+}
+
+}  // namespace
+
+TEST_CASE("GraphClustering: dense groups become clusters with an aggregate edge",
+          "[clustering]") {
+    Graph graph;
+    const auto first = add_dense_group(graph);
+    const auto second = add_dense_group(graph);
+    // Мост — Add, читающий по одному значению из середины каждой группы
+    const auto bridge = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    require_connect(graph, first[2], "result", bridge, "a");
+    require_connect(graph, second[2], "result", bridge, "b");
+
+    GraphClustering clustering(ClusteringOptions{.target_clusters = 4});
+    CHECK(clustering.update(graph).rebuilt);
+    REQUIRE(clustering.levels().size() == 1);
+    const auto& level = clustering.levels()[0];
+    REQUIRE(level.clusters.size() == 2);
+    CHECK(clustering.modularity() > 0.3);
+
+    const auto first_cluster = clustering.cluster_of(first.front(), 0);
+    const auto second_cluster = clustering.cluster_of(second.front(), 0);
+    REQUIRE(first_cluster.has_value());
+    REQUIRE(second_cluster.has_value());
+    CHECK(*first_cluster != *second_cluster);
+    for (const auto id : first) {
+        CHECK(clustering.cluster_of(id, 0) == first_cluster);
+    }
+    CHECK(clustering.cluster_of(bridge, 0) == first_cluster);
+    for (const auto id : second) {
+        CHECK(clustering.cluster_of(id, 0) == second_cluster);
+    }
+    CHECK(level.clusters[0].node_count + level.clusters[1].node_count == graph.node_count());
+
+    REQUIRE(level.edges.size() == 1);
+    CHECK(level.edges[0].exec_links == 0);
+    CHECK(level.edges[0].data_links == 1);
+    CHECK(level.edges[0].from == *second_cluster);
+    CHECK(level.edges[0].to == *first_cluster);
+    CHECK(clustering.level_for(10) == &level);
+}
+
+TEST_CASE("GraphClustering: local edits move only the touched nodes", "[clustering]") {
+    Graph graph;
+    const auto first = add_dense_group(graph);
+    const auto second = add_dense_group(graph);
+    require_connect(graph, first.back(), "result",
+                    graph.add_node(NodeFactory::create(NodeTypes::Add)), "a");
+
+    GraphClustering clustering(ClusteringOptions{.target_clusters = 4});
+    clustering.rebuild(graph);
+    const auto key_of = [&](NodeId node) {
+        return clustering.levels()[0].clusters[*clustering.cluster_of(node, 0)].key;
+    };
+    const auto first_key = key_of(first[1]);
+    const auto second_key = key_of(second[1]);
+
+    const auto unchanged = clustering.update(graph);
+    CHECK_FALSE(unchanged.rebuilt);
+    CHECK(unchanged.changed_nodes == 0);
+
+    // Новый узел, читающий два значения второй группы, присоединяется к ней
+    const auto consumer = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    require_connect(graph, second[3], "result", consumer, "a");
+    require_connect(graph, second[4], "result", consumer, "b");
+    const auto added = clustering.update(graph);
+    CHECK_FALSE(added.rebuilt);
+    CHECK(added.changed_nodes == 3);
+    CHECK(added.moved_nodes >= 1);
+    CHECK(clustering.cluster_of(consumer, 0) == clustering.cluster_of(second[1], 0));
+
+    CHECK(key_of(first[1]) == first_key);
+    CHECK(key_of(second[1]) == second_key);
+
+    REQUIRE(graph.remove_node(consumer).has_value());
+    const auto removed = clustering.update(graph);
+    CHECK_FALSE(removed.rebuilt);
+    CHECK_FALSE(clustering.cluster_of(consumer, 0).has_value());
+    std::size_t total = 0;
+    for (const auto& cluster : clustering.levels()[0].clusters) {
+        total += cluster.node_count;
+    }
+    CHECK(total == graph.node_count());
+
+    // Правка, задевшая больше rebuild_fraction узлов, перестраивает иерархию целиком
+    for (int i = 0; i < 10; ++i) {
+        (void)graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    }
+    CHECK(clustering.update(graph).rebuilt);
+}
+
+TEST_CASE("GraphClustering: builds levels until the view budget is met", "[clustering]") {
+    Graph graph;
+    std::vector<NodeId> literals;
+    for (int i = 0; i < 200; ++i) {
+        const auto literal = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+        const auto add = graph.add_node(NodeFactory::create(NodeTypes::Add));
+        require_connect(graph, literal, "result", add, "a");
+        literals.push_back(literal);
+    }
+
+    GraphClustering clustering(ClusteringOptions{.target_clusters = 60});
+    clustering.rebuild(graph);
+    const auto levels = clustering.levels();
+    REQUIRE(levels.size() > 1);
+    CHECK(levels[0].clusters.size() == 200);
+    CHECK(levels.back().clusters.size() <= 60);
+    CHECK(clustering.level_for(60) == &levels.back());
+    CHECK(clustering.level_for(1000) == &levels[0]);
+
+    for (std::size_t level = 1; level < levels.size(); ++level) {
+        CHECK(levels[level].clusters.size() < levels[level - 1].clusters.size());
+        std::size_t total = 0;
+        for (const auto& cluster : levels[level].clusters) {
+            total += cluster.node_count;
+        }
+        CHECK(total == graph.node_count());
+    }
+
+    const auto top = levels.size() - 1;
+    const auto cluster = clustering.cluster_of(literals[7], top);
+    REQUIRE(cluster.has_value());
+    const auto members = clustering.nodes_of(top, *cluster);
+    CHECK(members.size() == levels[top].clusters[*cluster].node_count);
+    CHECK(std::ranges::find(members, literals[7]) != members.end());
+}
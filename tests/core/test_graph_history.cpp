@@ -0,0 +1,157 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/Graph.hpp"
+#include "visprog/core/NodeFactory.hpp"
+
+#include "TestGraphHelpers.hpp"
+
+using namespace visprog::core;
+using namespace visprog::test;
+
+TEST_CASE("GraphHistory: node and connection edits round-trip", "[graph_history]") {
+    Graph graph;
+    const auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto end_id = graph.add_node(NodeFactory::create(NodeTypes::End));
+    const auto first = require_connect(graph, start_id, "exec-out", print_id, "exec-in");
+    const auto second = require_connect(graph, print_id, "exec-out", end_id, "exec-in");
+    REQUIRE(graph.history().undo_depth() == 5);
+
+    REQUIRE(graph.remove_node(print_id).has_value());
+    CHECK(graph.node_count() == 2);
+    CHECK(graph.connection_count() == 0);
+    CHECK(graph.history().top_step_size() == 1);
+
+    REQUIRE(graph.undo().has_value());
+    CHECK(graph.node_count() == 3);
+    CHECK(graph.get_nodes()[1]->get_id() == print_id);
+    CHECK(graph.has_connection(first));
+    CHECK(graph.has_connection(second));
+    CHECK(graph.validate().is_valid);
+
+    REQUIRE(graph.redo().has_value());
+    CHECK(graph.get_node(print_id) == nullptr);
+    CHECK(graph.connection_count() == 0);
+
+    REQUIRE(graph.undo().has_value());
+    REQUIRE(graph.undo().has_value());  // connect print → end
+    CHECK_FALSE(graph.has_connection(second));
+    REQUIRE(graph.redo().has_value());
+    CHECK(graph.has_connection(second));
+    CHECK(graph.validate().is_valid);
+
+    while (graph.history().can_undo()) {
+        REQUIRE(graph.undo().has_value());
+    }
+    CHECK(graph.node_count() == 0);
+    CHECK(graph.undo().error().code == error_codes::graph_history::NothingToUndo);
+
+    while (graph.history().can_redo()) {
+        REQUIRE(graph.redo().has_value());
+    }
+    // Повтор доходит до удаления print, которое осталось в стеке повтора
+    CHECK(graph.node_count() == 2);
+    REQUIRE(graph.undo().has_value());
+    CHECK(graph.node_count() == 3);
+    CHECK(graph.connection_count() == 2);
+    CHECK(graph.validate().is_valid);
+}
+
+TEST_CASE("GraphHistory: property and metadata edits", "[graph_history]") {
+    Graph graph("before");
+    const auto literal_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    REQUIRE(graph.set_node_property(literal_id, "value", std::int64_t{7}).has_value());
+    REQUIRE(graph.set_node_property(literal_id, "value", std::int64_t{9}).has_value());
+    REQUIRE(graph.set_node_property(literal_id, "note", std::string("x")).has_value());
+    REQUIRE(graph.add_variable("counter", DataType::Int32).has_value());
+    graph.set_name("after");
+
+    CHECK_FALSE(graph.set_node_property(NodeId{999}, "value", true).has_value());
+
+    REQUIRE(graph.undo().has_value());
+    CHECK(graph.get_name() == "before");
+    REQUIRE(graph.undo().has_value());
+    CHECK(graph.get_variables().empty());
+    REQUIRE(graph.undo().has_value());
+    CHECK_FALSE(graph.get_node(literal_id)->get_property<std::string>("note").has_value());
+    REQUIRE(graph.undo().has_value());
+    CHECK(graph.get_node(literal_id)->get_property<std::int64_t>("value") == 7);
+
+    REQUIRE(graph.redo().has_value());
+    CHECK(graph.get_node(literal_id)->get_property<std::int64_t>("value") == 9);
+}
+
+TEST_CASE("GraphHistory: batch property update is one coalesced edit", "[graph_history]") {
+    Graph graph;
+    std::vector<NodeId> literals;
+    for (int i = 0; i < 4; ++i) {
+        literals.push_back(graph.add_node(NodeFactory::create(NodeTypes::StringLiteral)));
+    }
+    REQUIRE(graph.set_node_property(literals[0], "value", std::string("first")).has_value());
+    graph.clear_history();
+    const auto revision = graph.revision();
+    const auto property_revision = graph.property_revision();
+
+    REQUIRE(graph.set_property_batch(literals, "value", std::string("batch")).has_value());
+    for (const auto id : literals) {
+        CHECK(graph.get_node(id)->get_property<std::string>("value") == "batch");
+    }
+    CHECK(graph.property_revision() == property_revision + 1);
+    CHECK(graph.revision() == revision);
+    CHECK(graph.history().undo_depth() == 1);
+    CHECK(graph.history().top_step_size() == 1);
+
+    // Несуществующий узел в пачке — ничего не меняется
+    const std::vector<NodeId> invalid{literals[1], NodeId{999}};
+    CHECK(graph.set_property_batch(invalid, "value", std::string("x")).error().code ==
+          error_codes::graph_connection::NodeNotFound);
+    CHECK(graph.get_node(literals[1])->get_property<std::string>("value") == "batch");
+
+    REQUIRE(graph.undo().has_value());
+    CHECK(graph.get_node(literals[0])->get_property<std::string>("value") == "first");
+    CHECK(graph.get_node(literals[3])->get_property<std::string>("value") == "default string");
+    REQUIRE(graph.redo().has_value());
+    CHECK(graph.get_node(literals[3])->get_property<std::string>("value") == "batch");
+}
+
+TEST_CASE("GraphHistory: groups, redo invalidation and depth limit", "[graph_history]") {
+    Graph graph;
+
+    graph.begin_edit_group();
+    const auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    graph.begin_edit_group();  // вложенная группа сливается с внешней
+    const auto end_id = graph.add_node(NodeFactory::create(NodeTypes::End));
+    graph.end_edit_group();
+    require_connect(graph, start_id, "exec-out", end_id, "exec-in");
+    graph.end_edit_group();
+
+    REQUIRE(graph.history().undo_depth() == 1);
+    CHECK(graph.history().top_step_size() == 3);
+    REQUIRE(graph.undo().has_value());
+    CHECK(graph.node_count() == 0);
+    CHECK(graph.history().can_redo());
+
+    // Новая правка после отмены делает стек повтора недействительным
+    [[maybe_unused]] auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    CHECK_FALSE(graph.history().can_redo());
+    CHECK(graph.redo().error().code == error_codes::graph_history::NothingToRedo);
+
+    graph.set_history_limit(3);
+    for (int index = 0; index < 10; ++index) {
+        graph.set_name(std::to_string(index));
+    }
+    CHECK(graph.history().undo_depth() == 3);
+    while (graph.history().can_undo()) {
+        REQUIRE(graph.undo().has_value());
+    }
+    CHECK(graph.get_name() == "6");
+
+    graph.clear_history();
+    CHECK_FALSE(graph.history().can_redo());
+}
@@ -0,0 +1,259 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/GraphInterpreter.hpp"
+#include "visprog/core/NodeFactory.hpp"
+
+#include "TestGraphHelpers.hpp"
+
+using namespace visprog::core;
+using namespace visprog::test;
+
+namespace {
+
+/// Start → ForLoop [0, 3) { sum = sum + index } → completed → Print("done") → End
+struct LoopProgram {
+    Graph graph;
+    NodeId loop;
+    NodeId set_sum;
+    NodeId add;
+    ConnectionId completed_link;
+
+    LoopProgram() {
+        REQUIRE(graph.add_variable("sum", DataType::Int32).has_value());
+        const auto start = graph.add_node(NodeFactory::create(NodeTypes::Start));
+        loop = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+        const auto first =
+            add_with_property(graph, NodeTypes::IntLiteral, "value", std::int64_t{0});
+        const auto last =
+            add_with_property(graph, NodeTypes::IntLiteral, "value", std::int64_t{3});
+        const auto get_sum =
+            add_with_property(graph, NodeTypes::GetVariable, "variable_name", std::string("sum"));
+        add = graph.add_node(NodeFactory::create(NodeTypes::Add));
+        set_sum =
+            add_with_property(graph, NodeTypes::SetVariable, "variable_name", std::string("sum"));
+        const auto text =
+            add_with_property(graph, NodeTypes::StringLiteral, "value", std::string("done"));
+        const auto print = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+        const auto end = graph.add_node(NodeFactory::create(NodeTypes::End));
+
+        require_connect(graph, start, "exec-out", loop, "exec-in");
+        require_connect(graph, first, "result", loop, "first");
+        require_connect(graph, last, "result", loop, "last");
+        require_connect(graph, loop, "loop-body", set_sum, "exec-in");
+        require_connect(graph, get_sum, "value-out", add, "a");
+        require_connect(graph, loop, "index", add, "b");
+        require_connect(graph, add, "result", set_sum, "value-in");
+        completed_link = require_connect(graph, loop, "completed", print, "exec-in");
+        require_connect(graph, text, "result", print, "string");
+        require_connect(graph, print, "exec-out", end, "exec-in");
+    }
+};
+
+auto as_int(const InterpreterValue* value) -> std::int64_t {
+    REQUIRE(value != nullptr);
+    REQUIRE(std::holds_alternative<std::int64_t>(*value));
+    return std::get<std::int64_t>(*value);
+}
+
+}  // namespace
+
+TEST_CASE("GraphInterpreter: executes loops, variables and branches", "[interpreter]") {
+    LoopProgram program;
+    std::ostringstream output;
+    auto compiled = GraphInterpreter::compile(program.graph, {.output = &output});
+    REQUIRE(compiled.has_value());
+    auto& interpreter = compiled.value();
+
+    CHECK(interpreter.run() == StopReason::Finished);
+    CHECK(interpreter.is_finished());
+    CHECK(output.str() == "done\n");
+    CHECK(as_int(interpreter.variable("sum")) == 3);
+    CHECK(interpreter.watch(program.loop, "index") == InterpreterValue{std::int64_t{2}});
+
+    // Повторный запуск с нуля даёт тот же результат
+    interpreter.reset();
+    CHECK(interpreter.run() == StopReason::Finished);
+    CHECK(as_int(interpreter.variable("sum")) == 3);
+
+    Graph branching;
+    const auto start = branching.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto branch = branching.add_node(NodeFactory::create(NodeTypes::Branch));
+    const auto condition = add_with_property(branching, NodeTypes::BoolLiteral, "value", false);
+    const auto& text_type = NodeTypes::StringLiteral;
+    const auto yes = add_with_property(branching, text_type, "value", std::string("y"));
+    const auto no = add_with_property(branching, text_type, "value", std::string("n"));
+    const auto print_yes = branching.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto print_no = branching.add_node(NodeFactory::create(NodeTypes::PrintString));
+    require_connect(branching, start, "exec-out", branch, "exec-in");
+    require_connect(branching, condition, "result", branch, "condition");
+    require_connect(branching, branch, "true", print_yes, "exec-in");
+    require_connect(branching, branch, "false", print_no, "exec-in");
+    require_connect(branching, yes, "result", print_yes, "string");
+    require_connect(branching, no, "result", print_no, "string");
+
+    std::ostringstream branch_output;
+    auto branch_program = GraphInterpreter::compile(branching, {.output = &branch_output});
+    REQUIRE(branch_program.has_value());
+    CHECK(branch_program.value().run() == StopReason::Finished);
+    CHECK(branch_output.str() == "n\n");
+
+    Graph empty;
+    [[maybe_unused]] auto orphan = empty.add_node(NodeFactory::create(NodeTypes::PrintString));
+    CHECK(GraphInterpreter::compile(empty).error().code == error_codes::interpreter::MissingStart);
+}
+
+TEST_CASE("GraphInterpreter: node, conditional and edge breakpoints", "[interpreter]") {
+    LoopProgram program;
+    std::ostringstream output;
+    auto compiled = GraphInterpreter::compile(program.graph, {.output = &output});
+    REQUIRE(compiled.has_value());
+    auto& interpreter = compiled.value();
+
+    const auto loop = program.loop;
+    REQUIRE(interpreter
+                .set_breakpoint(program.set_sum,
+                                [loop](const GraphInterpreter& self) {
+                                    return self.watch(loop, "index") ==
+                                           InterpreterValue{std::int64_t{1}};
+                                })
+                .has_value());
+    CHECK(interpreter.set_breakpoint(program.add).error().code ==
+          error_codes::interpreter::NotExecutable);
+
+    // Останов перед SetVariable на второй итерации: первая уже прибавила index 0
+    CHECK(interpreter.run() == StopReason::Breakpoint);
+    CHECK(interpreter.current_node() == program.set_sum);
+    CHECK(as_int(interpreter.variable("sum")) == 0);
+    CHECK(interpreter.watch(program.set_sum, "value-in") == InterpreterValue{std::int64_t{0}});
+
+    CHECK(interpreter.run() == StopReason::Finished);
+    CHECK(as_int(interpreter.variable("sum")) == 3);
+
+    interpreter.clear_breakpoints();
+    REQUIRE(interpreter.set_edge_breakpoint(program.completed_link).has_value());
+    interpreter.reset();
+    output.str("");
+    CHECK(interpreter.run() == StopReason::EdgeBreakpoint);
+    CHECK(interpreter.current_edge() == program.completed_link);
+    CHECK(output.str().empty());
+    CHECK(interpreter.run() == StopReason::Finished);
+    CHECK(output.str() == "done\n");
+
+    // Снятая точка останова больше не срабатывает
+    interpreter.clear_edge_breakpoint(program.completed_link);
+    interpreter.reset();
+    CHECK(interpreter.run() == StopReason::Finished);
+}
+
+TEST_CASE("GraphInterpreter: single-stepping walks exec nodes in order", "[interpreter]") {
+    LoopProgram program;
+    std::ostringstream output;
+    auto compiled = GraphInterpreter::compile(program.graph, {.output = &output});
+    REQUIRE(compiled.has_value());
+    auto& interpreter = compiled.value();
+
+    // Start, затем ForLoop, затем три итерации SetVariable, затем PrintString и End
+    CHECK(interpreter.step() == StopReason::Step);
+    CHECK(interpreter.current_node() == program.loop);
+    CHECK(interpreter.step() == StopReason::Step);
+    CHECK(interpreter.current_node() == program.set_sum);
+
+    std::size_t steps = 2;
+    while (interpreter.step() == StopReason::Step) {
+        ++steps;
+    }
+    CHECK(steps == 6);
+    CHECK(interpreter.is_finished());
+    CHECK(output.str() == "done\n");
+    CHECK(as_int(interpreter.variable("sum")) == 3);
+}
+
+TEST_CASE("GraphInterpreter: hot patching keeps state of a paused run", "[interpreter]") {
+    LoopProgram program;
+    std::ostringstream output;
+    auto compiled = GraphInterpreter::compile(program.graph, {.output = &output});
+    REQUIRE(compiled.has_value());
+    auto& interpreter = compiled.value();
+
+    const auto loop = program.loop;
+    REQUIRE(interpreter
+                .set_breakpoint(program.set_sum,
+                                [loop](const GraphInterpreter& self) {
+                                    return self.watch(loop, "index") ==
+                                           InterpreterValue{std::int64_t{2}};
+                                })
+                .has_value());
+    CHECK(interpreter.run() == StopReason::Breakpoint);
+    CHECK(as_int(interpreter.variable("sum")) == 1);
+
+    // Нельзя удалить узел, перед которым стоит исполнение; интерпретатор при этом не меняется
+    auto& graph = program.graph;
+    const auto print = graph.get_connection(program.completed_link)->to_node;
+    REQUIRE(graph.remove_node(program.set_sum).has_value());
+    CHECK(interpreter.hot_patch().error().code ==
+          error_codes::interpreter::PatchTouchesActivePath);
+    REQUIRE(graph.undo().has_value());
+    auto unchanged = interpreter.hot_patch();
+    REQUIRE(unchanged.has_value());
+
+    // Вставить Print("patched") перед завершающим Print вне текущего пути
+    REQUIRE(graph.disconnect(program.completed_link).has_value());
+    const auto patched = add_with_property(graph, NodeTypes::StringLiteral, "value",
+                                           std::string("patched"));
+    const auto extra = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    require_connect(graph, loop, "completed", extra, "exec-in");
+    require_connect(graph, patched, "result", extra, "string");
+    require_connect(graph, extra, "exec-out", print, "exec-in");
+
+    auto summary = interpreter.hot_patch();
+    REQUIRE(summary.has_value());
+    CHECK(summary.value().added == 1);
+    CHECK(summary.value().removed == 0);
+    CHECK(summary.value().relinked == 1);
+
+    CHECK(interpreter.run() == StopReason::Finished);
+    CHECK(output.str() == "patched\ndone\n");
+    CHECK(as_int(interpreter.variable("sum")) == 3);
+}
+
+TEST_CASE("GraphInterpreter: shared operands are evaluated once per exec node",
+          "[interpreter]") {
+    // Без кеша на шаг исполнения цепочка из N Add, читающих предыдущий выход дважды,
+    // вычислялась бы за 2^N
+    Graph graph;
+    REQUIRE(graph.add_variable("sum", DataType::Int32).has_value());
+    const auto start = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto loop = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+    const auto first = add_with_property(graph, NodeTypes::IntLiteral, "value", std::int64_t{0});
+    const auto last = add_with_property(graph, NodeTypes::IntLiteral, "value", std::int64_t{3});
+    const auto set_sum =
+        add_with_property(graph, NodeTypes::SetVariable, "variable_name", std::string("sum"));
+    const auto one = add_with_property(graph, NodeTypes::IntLiteral, "value", std::int64_t{1});
+    const auto print = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    require_connect(graph, start, "exec-out", loop, "exec-in");
+    require_connect(graph, first, "result", loop, "first");
+    require_connect(graph, last, "result", loop, "last");
+    require_connect(graph, loop, "loop-body", set_sum, "exec-in");
+    require_connect(graph, add_doubling_chain(graph, loop, "index", 40), "result", set_sum,
+                    "value-in");
+    require_connect(graph, loop, "completed", print, "exec-in");
+    // 2^63 не помещается в int64: сложение идёт по модулю 2^64, как в ColumnarEvaluator
+    require_connect(graph, add_doubling_chain(graph, one, "result", 63), "result", print,
+                    "string");
+
+    std::ostringstream output;
+    auto compiled = GraphInterpreter::compile(graph, {.output = &output});
+    REQUIRE(compiled.has_value());
+    CHECK(compiled.value().run() == StopReason::Finished);
+    // Индекс меняется между шагами, поэтому каждая итерация видит свежее значение
+    CHECK(as_int(compiled.value().variable("sum")) == std::int64_t{2} << 40);
+    CHECK(output.str() == "-9223372036854775808\n");
+}
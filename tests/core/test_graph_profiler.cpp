@@ -0,0 +1,197 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/GraphProfiler.hpp"
+#include "visprog/core/NodeFactory.hpp"
+
+#include "TestGraphHelpers.hpp"
+
+using namespace visprog::core;
+using namespace visprog::test;
+
+namespace {
+
+/// Поток, снимающий выборку на каждом конце строки — то есть внутри узла Print String.
+class SamplingBuffer : public std::streambuf {
+public:
+    explicit SamplingBuffer(GraphProfiler& profiler) : profiler_(profiler) {}
+
+protected:
+    auto overflow(int_type symbol) -> int_type override {
+        if (symbol == '\n') {
+            profiler_.sample_now();
+        }
+        return traits_type::not_eof(symbol);
+    }
+
+private:
+    GraphProfiler& profiler_;
+};
+
+/// Start → Sequence { ForLoop [0, last) { sum = sum + index }, Print("done") }
+struct ProfiledProgram {
+    Graph graph{"profiled"};
+    NodeId sequence;
+    NodeId loop;
+    NodeId set_sum;
+    NodeId add;
+    NodeId print;
+
+    explicit ProfiledProgram(std::int64_t iterations) {
+        REQUIRE(graph.add_variable("sum", DataType::Int32).has_value());
+        const auto start = graph.add_node(NodeFactory::create(NodeTypes::Start));
+        sequence = graph.add_node(NodeFactory::create(NodeTypes::Sequence));
+        loop = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+        const auto last = add_with_property(graph, NodeTypes::IntLiteral, "value", iterations);
+        const auto get_sum =
+            add_with_property(graph, NodeTypes::GetVariable, "variable_name", std::string("sum"));
+        add = graph.add_node(NodeFactory::create(NodeTypes::Add));
+        set_sum =
+            add_with_property(graph, NodeTypes::SetVariable, "variable_name", std::string("sum"));
+        const auto text =
+            add_with_property(graph, NodeTypes::StringLiteral, "value", std::string("done"));
+        print = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+        require_connect(graph, start, "exec-out", sequence, "exec-in");
+        require_connect(graph, sequence, "then-0", loop, "exec-in");
+        require_connect(graph, sequence, "then-1", print, "exec-in");
+        require_connect(graph, last, "result", loop, "last");
+        require_connect(graph, loop, "loop-body", set_sum, "exec-in");
+        require_connect(graph, get_sum, "value-out", add, "a");
+        require_connect(graph, loop, "index", add, "b");
+        require_connect(graph, add, "result", set_sum, "value-in");
+        require_connect(graph, text, "result", print, "string");
+    }
+
+    [[nodiscard]] auto name_of(NodeId id) const -> std::string {
+        return std::string(graph.get_node(id)->get_display_name());
+    }
+};
+
+}  // namespace
+
+TEST_CASE("GraphProfiler: aggregates samples by exec path", "[profiler]") {
+    ProfiledProgram program(3);
+    GraphProfiler profiler(ProfilerOptions{.interval = std::chrono::microseconds{0},
+                                           .max_samples = 2});
+    SamplingBuffer buffer(profiler);
+    std::ostream output(&buffer);
+    auto compiled = GraphInterpreter::compile(program.graph, {.output = &output});
+    REQUIRE(compiled.has_value());
+    auto& interpreter = compiled.value();
+
+    // Вне исполнения графа выборки не снимаются
+    REQUIRE(profiler.start(interpreter).has_value());
+    profiler.sample_now();
+    CHECK(profiler.sample_count() == 0);
+
+    // Второй профилировщик не перехватывает стек интерпретатора, даже без таймера
+    GraphProfiler second(ProfilerOptions{.interval = std::chrono::microseconds{0}});
+    CHECK(second.start(interpreter).error().code == error_codes::profiler::AlreadyRunning);
+    CHECK_FALSE(second.is_running());
+
+    for (int run = 0; run < 3; ++run) {
+        interpreter.reset();
+        CHECK(interpreter.run() == StopReason::Finished);
+    }
+    profiler.stop();
+    CHECK_FALSE(profiler.is_running());
+    CHECK(profiler.sample_count() == 2);
+    CHECK(profiler.dropped_samples() == 1);
+
+    const auto expected = "profiled;" + program.name_of(program.sequence) + ";" +
+                          program.name_of(program.print) + " 2\n";
+    CHECK(profiler.collapsed_stacks() == expected);
+
+    const auto profiles = profiler.node_profiles();
+    REQUIRE(profiles.size() == 2);
+    CHECK(profiles[0].node == program.print);
+    CHECK(profiles[0].self_samples == 2);
+    CHECK(profiles[0].total_samples == 2);
+    CHECK(profiles[1].node == program.sequence);
+    CHECK(profiles[1].self_samples == 0);
+    CHECK(profiles[1].total_samples == 2);
+
+    // После stop() интерпретатор исполняет граф без публикации пути
+    interpreter.reset();
+    CHECK(interpreter.run() == StopReason::Finished);
+    CHECK(profiler.sample_count() == 2);
+}
+
+#if defined(__linux__)
+
+TEST_CASE("GraphProfiler: samples a running interpreter on a timer", "[profiler]") {
+    ProfiledProgram program(20000);
+    std::ostringstream output;
+    auto compiled = GraphInterpreter::compile(program.graph, {.output = &output});
+    REQUIRE(compiled.has_value());
+    auto& interpreter = compiled.value();
+
+    GraphProfiler profiler(ProfilerOptions{.interval = std::chrono::microseconds{200},
+                                           .max_samples = 10000});
+    REQUIRE(profiler.start(interpreter).has_value());
+    GraphProfiler second;
+    CHECK(second.start(interpreter).error().code == error_codes::profiler::AlreadyRunning);
+
+    // Таймер считает процессорное время с шагом тика ядра: крутим граф, пока не наберутся выборки
+    for (int run = 0; run < 500 && profiler.sample_count() < 20; ++run) {
+        interpreter.reset();
+        REQUIRE(interpreter.run() == StopReason::Finished);
+    }
+    profiler.stop();
+    REQUIRE(profiler.sample_count() >= 20);
+
+    const auto stacks = profiler.collapsed_stacks();
+    const auto loop_path = "profiled;" + program.name_of(program.sequence) + ";" +
+                           program.name_of(program.loop) + ";";
+    CHECK(stacks.find(loop_path + program.name_of(program.set_sum)) != std::string::npos);
+
+    std::size_t total = 0;
+    for (const auto& profile : profiler.node_profiles()) {
+        total += profile.self_samples;
+        CHECK(profile.total_samples >= profile.self_samples);
+        CHECK(profile.self_time == std::chrono::microseconds{200} *
+                                       static_cast<std::int64_t>(profile.self_samples));
+        if (profile.node == program.sequence) {
+            CHECK(profile.total_samples == profiler.sample_count());
+        }
+    }
+    CHECK(total == profiler.sample_count());
+
+    // Таймер освобождён: другой профилировщик может стартовать
+    REQUIRE(second.start(interpreter).has_value());
+    second.stop();
+}
+
+TEST_CASE("GraphProfiler: the timer counts only the thread that started it", "[profiler]") {
+    ProfiledProgram program(20000);
+    std::ostringstream output;
+    auto compiled = GraphInterpreter::compile(program.graph, {.output = &output});
+    REQUIRE(compiled.has_value());
+    auto& interpreter = compiled.value();
+
+    GraphProfiler profiler(ProfilerOptions{.interval = std::chrono::microseconds{200}});
+    REQUIRE(profiler.start(interpreter).has_value());
+    // Граф исполняет другой поток, а поток таймера ждёт его без процессорного времени
+    std::thread worker([&] {
+        for (int run = 0; run < 5; ++run) {
+            interpreter.reset();
+            (void)interpreter.run();
+        }
+    });
+    worker.join();
+    profiler.stop();
+    CHECK(profiler.sample_count() == 0);
+    CHECK(profiler.dropped_samples() == 0);
+}
+
+#endif
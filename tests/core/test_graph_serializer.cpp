@@ -145,6 +145,42 @@ TEST_CASE("GraphSerializer: Round-trip с несколькими связями"
     REQUIRE(restored_edges == expected_edges);
 }
 
+TEST_CASE("GraphSerializer: Round-trip узлов Array Math", "[graph][serialization]") {
+    Graph graph("ArrayGraph");
+
+    auto literal_node = NodeFactory::create(NodeTypes::IntArrayLiteral, "Массив");
+    auto sum_node = NodeFactory::create(NodeTypes::ArrayReduceSum, "Сумма");
+    literal_node->set_property("values", std::string("1, 2, 3"));
+
+    const auto literal_id = literal_node->get_id();
+    const auto sum_id = sum_node->get_id();
+    const auto literal_out = literal_node->get_output_ports().at(0)->get_id();
+    const auto sum_in = sum_node->get_input_ports().at(0)->get_id();
+
+    REQUIRE(graph.add_node(std::move(literal_node)) == literal_id);
+    REQUIRE(graph.add_node(std::move(sum_node)) == sum_id);
+    REQUIRE(graph.connect(literal_id, literal_out, sum_id, sum_in).has_value());
+
+    const nlohmann::json json_doc = GraphSerializer::to_json(graph);
+    auto restored_result = GraphSerializer::from_json(json_doc);
+    REQUIRE(restored_result.has_value());
+    Graph restored_graph = std::move(restored_result).value();
+
+    const auto* restored_literal = restored_graph.get_node(literal_id);
+    const auto* restored_sum = restored_graph.get_node(sum_id);
+    REQUIRE(restored_literal != nullptr);
+    REQUIRE(restored_sum != nullptr);
+    REQUIRE(restored_literal->get_type().name == NodeTypes::IntArrayLiteral.name);
+    REQUIRE(restored_sum->get_type().name == NodeTypes::ArrayReduceSum.name);
+    REQUIRE(restored_literal->get_property<std::string>("values") == "1, 2, 3");
+
+    const auto* restored_port = restored_sum->find_port(sum_in);
+    REQUIRE(restored_port != nullptr);
+    REQUIRE(restored_port->get_data_type() == DataType::Vector);
+    REQUIRE(restored_port->get_type_name() == "int32");
+    REQUIRE(restored_graph.connection_count() == 1);
+}
+
 TEST_CASE("GraphSerializer: Ошибка если connection с битым nodeId",
           "[graph][serialization][negative]") {
     Graph graph("ConnectedGraph");
@@ -453,3 +489,73 @@ TEST_CASE("GraphSerializer: Fuzz-десериализация connections не 
         }
     }
 }
+
+TEST_CASE("GraphSerializer: compact save renumbers ids densely", "[graph][serialization]") {
+    // Раздуваем счётчики фабрики, как в долгой сессии редактирования
+    for (int i = 0; i < 50; ++i) {
+        [[maybe_unused]] auto discarded = NodeFactory::create(NodeTypes::Sequence);
+    }
+
+    Graph graph("Compact");
+    // Печать добавлена первой, но корнями обхода становятся узлы без входящих связей
+    const auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString, "Печать"));
+    const auto add_id = graph.add_node(NodeFactory::create(NodeTypes::Add, "Сумма"));
+    const auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start, "Старт"));
+    const auto literal_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral, "Число"));
+    graph.get_node_mut(literal_id)->set_property("value", std::int64_t{7});
+
+    const auto* print = graph.get_node(print_id);
+    const auto* add = graph.get_node(add_id);
+    const auto* start = graph.get_node(start_id);
+    const auto* literal = graph.get_node(literal_id);
+    const auto exec_conn = graph.connect(start_id, start->get_exec_output_ports().at(0)->get_id(),
+                                         print_id, print->get_exec_input_ports().at(0)->get_id());
+    const auto data_conn = graph.connect(literal_id, literal->get_output_ports().at(0)->get_id(),
+                                         add_id, add->get_input_ports().back()->get_id());
+    REQUIRE(exec_conn.has_value());
+    REQUIRE(data_conn.has_value());
+
+    const auto plain = GraphSerializer::save(graph);
+    CHECK(plain.remap.empty());
+    CHECK(plain.document == GraphSerializer::to_json(graph));
+
+    const auto saved = GraphSerializer::save(graph, SaveOptions{.compact_ids = true});
+    const auto& doc = saved.document;
+    REQUIRE(doc["nodes"].size() == 4);
+    CHECK(saved.remap.nodes.at(start_id) == NodeId{1});
+    CHECK(saved.remap.nodes.at(print_id) == NodeId{2});
+    CHECK(saved.remap.nodes.at(literal_id) == NodeId{3});
+    CHECK(saved.remap.nodes.at(add_id) == NodeId{4});
+    CHECK(doc["nodes"][0]["instanceName"].get<std::string>() == "Старт");
+    CHECK(doc["nodes"][0]["firstPortId"].get<std::uint64_t>() == 1);
+    CHECK(saved.remap.connections.at(exec_conn.value()) == ConnectionId{1});
+    CHECK(saved.remap.connections.at(data_conn.value()) == ConnectionId{2});
+
+    std::uint64_t total_ports = 0;
+    for (const auto& node : graph.get_nodes()) {
+        total_ports += node->get_ports().size();
+    }
+    CHECK(saved.remap.ports.size() == total_ports);
+    for (const auto& [from, to] : saved.remap.ports) {
+        CHECK(to.value >= 1);
+        CHECK(to.value <= total_ports);
+    }
+
+    const auto remap_json = GraphSerializer::remap_to_json(saved.remap);
+    CHECK(remap_json["nodes"][0] == nlohmann::json::array({start_id.value, 1}));
+    CHECK(remap_json["ports"].size() == total_ports);
+
+    // Документ загружается, и связи указывают на те же по смыслу порты
+    auto restored = GraphSerializer::from_json(doc);
+    REQUIRE(restored.has_value());
+    const auto& loaded = restored.value();
+    CHECK(loaded.validate().is_valid);
+    REQUIRE(loaded.connection_count() == 2);
+    const auto* loaded_add = loaded.get_node(NodeId{4});
+    REQUIRE(loaded_add != nullptr);
+    CHECK(loaded_add->get_type().name == NodeTypes::Add.name);
+    const auto* loaded_data = loaded.get_connection(ConnectionId{2});
+    REQUIRE(loaded_data != nullptr);
+    CHECK(loaded_data->to_port == loaded_add->get_input_ports().back()->get_id());
+    CHECK(loaded.get_node(NodeId{3})->get_property<std::int64_t>("value") == 7);
+}
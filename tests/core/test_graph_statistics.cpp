@@ -0,0 +1,87 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <catch2/catch_all.hpp>
+#include <string_view>
+
+#include "visprog/core/Graph.hpp"
+#include "visprog/core/NodeFactory.hpp"
+
+#include "TestGraphHelpers.hpp"
+
+using namespace visprog::core;
+using namespace visprog::test;
+
+TEST_CASE("GraphStatistics: shape summary of a small graph", "[statistics]") {
+    Graph graph;
+    CHECK(graph.statistics().node_count == 0);
+    CHECK(graph.statistics().connected_components == 0);
+
+    // Start → Sequence → (PrintA, PrintB); literal → Add → PrintB; orphan — отдельный узел
+    const auto start = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    const auto sequence = graph.add_node(NodeFactory::create(NodeTypes::Sequence));
+    const auto print_a = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto print_b = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto literal = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    const auto add = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    [[maybe_unused]] const auto orphan = graph.add_node(NodeFactory::create(NodeTypes::End));
+
+    require_connect(graph, start, "exec-out", sequence, "exec-in");
+    require_connect(graph, sequence, "then-0", print_a, "exec-in");
+    require_connect(graph, sequence, "then-1", print_b, "exec-in");
+    require_connect(graph, literal, "result", add, "a");
+    require_connect(graph, literal, "result", add, "b");
+    require_connect(graph, add, "result", print_b, "string");
+
+    const auto& stats = graph.statistics();
+    CHECK(stats.revision == graph.revision());
+    CHECK(stats.node_count == 7);
+    CHECK(stats.exec_connection_count == 3);
+    CHECK(stats.data_connection_count == 3);
+    CHECK(stats.connection_count() == graph.connection_count());
+    CHECK(stats.nodes_by_type.at(std::string(NodeTypes::PrintString.name)) == 2);
+    CHECK(stats.nodes_by_type.size() == 6);
+
+    CHECK(stats.out_degree.max == 2);
+    CHECK(stats.in_degree.max == 2);
+    CHECK(stats.out_degree.histogram[0] == 3);  // print_a, print_b, orphan
+    CHECK(stats.in_degree.histogram[0] == 3);   // start, literal, orphan
+    CHECK(stats.out_degree.mean * 7.0 == 6.0);
+    CHECK((stats.largest_fan_out_node == sequence || stats.largest_fan_out_node == literal));
+
+    CHECK(stats.exec_depth == 2);
+    CHECK(stats.data_depth == 2);
+    CHECK_FALSE(stats.exec_has_cycle);
+    CHECK_FALSE(stats.data_has_cycle);
+    CHECK(stats.connected_components == 2);
+    CHECK(stats.isolated_nodes == 1);
+}
+
+TEST_CASE("GraphStatistics: cache follows structural revisions", "[statistics]") {
+    Graph graph;
+    const auto print_a = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    const auto print_b = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    const auto* first = &graph.statistics();
+    const auto revision = graph.revision();
+    CHECK(first->connected_components == 2);
+
+    // Свойства и переменные не меняют форму графа — сводка берётся из кеша
+    REQUIRE(graph.set_node_property(print_a, "label", std::string("x")).has_value());
+    REQUIRE(graph.add_variable("counter", DataType::Int32).has_value());
+    CHECK(graph.revision() == revision);
+    CHECK(&graph.statistics() == first);
+    CHECK(graph.statistics().revision == revision);
+
+    const auto loop_ab = require_connect(graph, print_a, "exec-out", print_b, "exec-in");
+    require_connect(graph, print_b, "exec-out", print_a, "exec-in");
+    CHECK(graph.revision() > revision);
+    CHECK(graph.statistics().connected_components == 1);
+    CHECK(graph.statistics().exec_has_cycle);
+
+    REQUIRE(graph.disconnect(loop_ab).has_value());
+    CHECK_FALSE(graph.statistics().exec_has_cycle);
+    CHECK(graph.statistics().exec_depth == 1);
+
+    REQUIRE(graph.undo().has_value());
+    CHECK(graph.statistics().exec_has_cycle);
+}
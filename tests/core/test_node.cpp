@@ -117,6 +117,37 @@ TEST_CASE("NodeFactory: Create Core Nodes", "[factory]") {
         REQUIRE((*it)->get_data_type() == DataType::StringView);
     }
 
+    SECTION("Create Array Math nodes") {
+        auto node = NodeFactory::create(NodeTypes::ArrayMapScalar);
+        REQUIRE(node != nullptr);
+        REQUIRE(node->get_input_ports().size() == 2);
+        REQUIRE(node->get_output_ports().size() == 1);
+
+        const auto* array_in = node->get_input_ports()[0];
+        REQUIRE(array_in->get_name() == "array");
+        REQUIRE(array_in->get_data_type() == DataType::Vector);
+        REQUIRE(array_in->get_type_name() == "int32");
+        REQUIRE(node->get_input_ports()[1]->get_data_type() == DataType::Int32);
+        REQUIRE(node->get_property<std::string>("operation") == "mul");
+
+        auto sum = NodeFactory::create(NodeTypes::ArrayReduceSum);
+        REQUIRE(sum->get_output_ports()[0]->get_data_type() == DataType::Int32);
+        REQUIRE(node->get_output_ports()[0]->can_connect_to(*sum->get_input_ports()[0]));
+    }
+
+    SECTION("Create Parallel Sequence node") {
+        auto node = NodeFactory::create(NodeTypes::ParallelSequence);
+        REQUIRE(node != nullptr);
+        REQUIRE(node->has_execution_flow());
+        REQUIRE(node->get_exec_input_ports().size() == 1);
+
+        const auto exec_outputs = node->get_exec_output_ports();
+        REQUIRE(exec_outputs.size() == 3);
+        REQUIRE(exec_outputs[0]->get_name() == "then-0");
+        REQUIRE(exec_outputs[1]->get_name() == "then-1");
+        REQUIRE(exec_outputs[2]->get_name() == "completed");
+    }
+
     SECTION("Unique IDs") {
         auto node1 = NodeFactory::create(NodeTypes::Start);
         auto node2 = NodeFactory::create(NodeTypes::Start);
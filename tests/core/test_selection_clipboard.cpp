@@ -0,0 +1,145 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/NodeFactory.hpp"
+#include "visprog/core/SelectionClipboard.hpp"
+
+#include "TestGraphHelpers.hpp"
+
+using namespace visprog::core;
+using namespace visprog::test;
+
+namespace {
+
+/// Start → Set(counter = literal) → Print(Get(counter)); литерал хранит отрицательное число.
+struct SampleGraph {
+    Graph graph;
+    NodeId start;
+    NodeId literal;
+    NodeId set;
+    NodeId get;
+    NodeId print;
+};
+
+auto build_sample() -> SampleGraph {
+    SampleGraph sample;
+    auto& graph = sample.graph;
+    REQUIRE(graph.add_variable("counter", DataType::Int32).has_value());
+    REQUIRE(graph.add_variable("unused", DataType::String).has_value());
+
+    sample.start = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    sample.literal = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral, "seed"));
+    sample.set = graph.add_node(NodeFactory::create(NodeTypes::SetVariable));
+    sample.get = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+    sample.print = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    graph.get_node_mut(sample.literal)->set_property("value", std::int64_t{-42});
+    graph.get_node_mut(sample.literal)->set_property("scale", 0.5);
+    graph.get_node_mut(sample.set)->set_property("variable_name", std::string("counter"));
+    graph.get_node_mut(sample.get)->set_property("variable_name", std::string("counter"));
+    graph.get_node_mut(sample.print)->set_property("enabled", true);
+
+    require_connect(graph, sample.start, "exec-out", sample.set, "exec-in");
+    require_connect(graph, sample.set, "exec-out", sample.print, "exec-in");
+    require_connect(graph, sample.get, "value-out", sample.print, "string");
+    return sample;
+}
+
+}  // namespace
+
+TEST_CASE("SelectionClipboard: paste remaps ids and keeps internal links", "[clipboard]") {
+    auto sample = build_sample();
+    const std::vector<NodeId> selection{sample.print, sample.set, sample.get, sample.literal,
+                                        sample.set};
+    const auto blob = SelectionClipboard::copy(sample.graph, selection);
+    REQUIRE(blob.has_value());
+
+    Graph target;
+    const auto pasted = SelectionClipboard::paste(target, blob.value());
+    REQUIRE(pasted.has_value());
+
+    // Узлы в порядке исходного графа; связь от Start за пределами выделения отброшена
+    REQUIRE(pasted.value().nodes.size() == 4);
+    CHECK(pasted.value().connections.size() == 2);
+    CHECK(target.node_count() == 4);
+    CHECK(target.validate().is_valid);
+    for (const auto id : pasted.value().nodes) {
+        CHECK_FALSE(sample.graph.has_node(id));
+    }
+
+    const auto* literal = target.get_node(pasted.value().nodes[0]);
+    REQUIRE(literal != nullptr);
+    CHECK(literal->get_type().name == NodeTypes::IntLiteral.name);
+    CHECK(literal->get_instance_name() == "seed");
+    CHECK(literal->get_property<std::int64_t>("value") == -42);
+    CHECK(literal->get_property<double>("scale") == 0.5);
+    CHECK(target.get_node(pasted.value().nodes[3])->get_property<bool>("enabled") == true);
+
+    // Переносится только переменная, на которую ссылаются узлы выделения
+    REQUIRE(target.get_variables().size() == 1);
+    CHECK(target.get_variables()[0].name == "counter");
+    CHECK(target.get_variables()[0].type == DataType::Int32);
+
+    // Повторная вставка в исходный граф переиспользует переменную и не задевает оригинал
+    const auto before = sample.graph.connection_count();
+    REQUIRE(SelectionClipboard::paste(sample.graph, blob.value()).has_value());
+    CHECK(sample.graph.node_count() == 9);
+    CHECK(sample.graph.connection_count() == before + 2);
+    CHECK(sample.graph.get_variables().size() == 2);
+    CHECK(sample.graph.validate().is_valid);
+}
+
+TEST_CASE("SelectionClipboard: paste is a single undo step", "[clipboard]") {
+    auto sample = build_sample();
+    const std::vector<NodeId> selection{sample.start, sample.set, sample.print};
+    const auto blob = SelectionClipboard::copy(sample.graph, selection);
+    REQUIRE(blob.has_value());
+
+    Graph target;
+    REQUIRE(SelectionClipboard::paste(target, blob.value()).has_value());
+    CHECK(target.history().undo_depth() == 1);
+    CHECK(target.history().top_step_size() == 1 + 3 + 2);  // переменная, узлы, связи
+
+    REQUIRE(target.undo().has_value());
+    CHECK(target.node_count() == 0);
+    CHECK(target.connection_count() == 0);
+    CHECK(target.get_variables().empty());
+
+    REQUIRE(target.redo().has_value());
+    CHECK(target.node_count() == 3);
+    CHECK(target.connection_count() == 2);
+    CHECK(target.validate().is_valid);
+}
+
+TEST_CASE("SelectionClipboard: rejects bad selections and corrupted blobs", "[clipboard]") {
+    auto sample = build_sample();
+    const std::vector<NodeId> missing{NodeId{999'999}};
+    CHECK(SelectionClipboard::copy(sample.graph, missing).error().code ==
+          error_codes::clipboard::InvalidSelection);
+
+    const std::vector<NodeId> selection{sample.set, sample.print};
+    const auto blob = SelectionClipboard::copy(sample.graph, selection);
+    REQUIRE(blob.has_value());
+
+    Graph target;
+    REQUIRE(target.add_variable("counter", DataType::String).has_value());
+    CHECK(SelectionClipboard::paste(target, blob.value()).error().code ==
+          error_codes::clipboard::VariableTypeConflict);
+    CHECK(target.node_count() == 0);
+
+    for (std::size_t size = 0; size < blob.value().size(); ++size) {
+        const auto truncated = std::span(blob.value()).first(size);
+        CHECK_FALSE(SelectionClipboard::paste(target, truncated).has_value());
+    }
+    CHECK(target.node_count() == 0);
+    CHECK(target.history().undo_depth() == 1);  // только add_variable
+
+    auto wrong_version = blob.value();
+    wrong_version[4] = std::byte{99};
+    CHECK(SelectionClipboard::paste(target, wrong_version).error().code ==
+          error_codes::clipboard::UnsupportedVersion);
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <catch2/catch_all.hpp>
+
+#if defined(__linux__)
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/SharedMemoryTransport.hpp"
+
+using namespace visprog::core;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto segment_name(const std::string& suffix) -> std::string {
+    return "/multicode-test-" + std::to_string(getpid()) + "-" + suffix;
+}
+
+auto bytes(const std::string& text) -> std::vector<std::byte> {
+    std::vector<std::byte> result(text.size());
+    std::memcpy(result.data(), text.data(), text.size());
+    return result;
+}
+
+auto text(std::span<const std::byte> payload) -> std::string {
+    return {reinterpret_cast<const char*>(payload.data()), payload.size()};
+}
+
+}  // namespace
+
+TEST_CASE("SharedMemoryTransport: host and core exchange messages", "[transport]") {
+    const auto name = segment_name("exchange");
+    auto host = SharedMemoryTransport::create(name, 4096);
+    REQUIRE(host.has_value());
+    CHECK(SharedMemoryTransport::create(name, 4096).error().code ==
+          error_codes::transport::SharedMemoryFailed);
+    auto core = SharedMemoryTransport::open(name);
+    REQUIRE(core.has_value());
+    CHECK(core.value().to_core().capacity() == 4096);
+
+    REQUIRE(host.value().to_core().write(TransportMessageKind::EditCommand, bytes("add-node")));
+    auto command = core.value().to_core().peek();
+    REQUIRE(command.has_value());
+    CHECK(command->kind == TransportMessageKind::EditCommand);
+    CHECK(text(command->payload) == "add-node");
+    core.value().to_core().release();
+    CHECK_FALSE(core.value().to_core().peek().has_value());
+
+    // Код пишется прямо в окно кольца и читается хостом без промежуточного буфера
+    const std::string code = "int main() { return 0; }";
+    auto window = core.value().to_host().reserve(TransportMessageKind::GeneratedCode, code.size());
+    REQUIRE(window.has_value());
+    std::memcpy(window->data(), code.data(), code.size());
+    core.value().to_host().commit();
+    auto chunk = host.value().to_host().peek();
+    REQUIRE(chunk.has_value());
+    CHECK(chunk->kind == TransportMessageKind::GeneratedCode);
+    CHECK(text(chunk->payload) == code);
+    host.value().to_host().release();
+
+    // Много сообщений разного размера: кольцо несколько раз переходит через конец буфера
+    auto& writer = host.value().to_core();
+    auto& reader = core.value().to_core();
+    CHECK_FALSE(writer.reserve(TransportMessageKind::EditCommand, writer.max_message_size() + 1));
+    std::size_t sent = 0;
+    std::size_t received = 0;
+    while (received < 200) {
+        const auto message = std::string(37 * (sent % 29) + 1, static_cast<char>('a' + sent % 26));
+        if (sent < 200 && writer.write(TransportMessageKind::Diagnostics, bytes(message))) {
+            ++sent;
+            continue;
+        }
+        auto next = reader.peek();
+        REQUIRE(next.has_value());
+        const auto expected =
+            std::string(37 * (received % 29) + 1, static_cast<char>('a' + received % 26));
+        REQUIRE(text(next->payload) == expected);
+        reader.release();
+        ++received;
+    }
+    CHECK_FALSE(reader.peek().has_value());
+}
+
+TEST_CASE("SharedMemoryTransport: readers block until a message arrives", "[transport]") {
+    const auto name = segment_name("wait");
+    auto host = SharedMemoryTransport::create(name, 8192);
+    REQUIRE(host.has_value());
+    auto core = SharedMemoryTransport::open(name);
+    REQUIRE(core.has_value());
+    CHECK_FALSE(core.value().to_core().wait_readable(1ms));
+
+    std::string received;
+    std::jthread reader([&] {
+        auto& ring = core.value().to_core();
+        if (ring.wait_readable(5s)) {
+            received = text(ring.peek()->payload);
+            ring.release();
+        }
+    });
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(host.value().to_core().write(TransportMessageKind::EditCommand, bytes("wake")));
+    reader.join();
+    CHECK(received == "wake");
+    CHECK(host.value().to_core().wait_writable(1000, 1ms));
+
+    CHECK(SharedMemoryTransport::open(segment_name("missing")).error().code ==
+          error_codes::transport::SharedMemoryFailed);
+}
+
+TEST_CASE("SharedMemoryTransport: malformed frames mark the ring corrupted", "[transport]") {
+    // Заголовок кадра — 8 байт перед payload: uint32 size, uint16 kind, uint16 reserved
+    const auto corrupt_frame = [](std::size_t field_offset, auto value) {
+        const auto name = segment_name("corrupt-" + std::to_string(field_offset));
+        auto host = SharedMemoryTransport::create(name, 4096);
+        REQUIRE(host.has_value());
+        auto core = SharedMemoryTransport::open(name);
+        REQUIRE(core.has_value());
+
+        auto window = host.value().to_core().reserve(TransportMessageKind::EditCommand, 16);
+        REQUIRE(window.has_value());
+        std::memcpy(window->data() - 8 + field_offset, &value, sizeof(value));
+        host.value().to_core().commit();
+        REQUIRE(host.value().to_core().write(TransportMessageKind::EditCommand, bytes("next")));
+
+        auto& reader = core.value().to_core();
+        CHECK_FALSE(reader.peek().has_value());
+        CHECK(reader.corrupted());
+        // Следующее сообщение за повреждённым кадром тоже не читается
+        CHECK_FALSE(reader.peek().has_value());
+    };
+    // size за концом буфера и за опубликованным head
+    corrupt_frame(0, std::uint32_t{1} << 30);
+    corrupt_frame(0, std::uint32_t{64});
+    // неизвестный вид сообщения
+    corrupt_frame(4, std::uint16_t{77});
+}
+
+#endif
@@ -0,0 +1,122 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <catch2/catch_all.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/TextDiff.hpp"
+
+using namespace visprog::core;
+
+namespace {
+
+auto lines_of(const std::vector<char>& letters) -> std::string {
+    std::string text;
+    for (const auto letter : letters) {
+        text += letter;
+        text += '\n';
+    }
+    return text;
+}
+
+auto changed_lines(const std::vector<LineEdit>& edits) -> std::size_t {
+    std::size_t total = 0;
+    for (const auto& edit : edits) {
+        total += edit.old_count + edit.new_count;
+    }
+    return total;
+}
+
+/// Длина редакционного предписания (вставки + удаления) через НОП — эталон для малых входов.
+auto edit_distance(const std::vector<char>& a, const std::vector<char>& b) -> std::size_t {
+    std::vector<std::vector<std::size_t>> lcs(a.size() + 1, std::vector<std::size_t>(b.size() + 1));
+    for (std::size_t i = 1; i <= a.size(); ++i) {
+        for (std::size_t j = 1; j <= b.size(); ++j) {
+            lcs[i][j] = a[i - 1] == b[j - 1] ? lcs[i - 1][j - 1] + 1
+                                             : std::max(lcs[i - 1][j], lcs[i][j - 1]);
+        }
+    }
+    return a.size() + b.size() - 2 * lcs[a.size()][b.size()];
+}
+
+}  // namespace
+
+TEST_CASE("TextDiff: hunks for a localized change", "[text_diff]") {
+    const std::string before = "#include <iostream>\nint main() {\n    f();\n    return 0;\n}\n";
+    const std::string after =
+        "#include <iostream>\nint main() {\n    g();\n    h();\n    return 0;\n}\n";
+
+    const auto edits = diff_lines(before, after);
+    REQUIRE(edits.size() == 1);
+    CHECK(edits[0] == LineEdit{.old_start = 2,
+                               .old_count = 1,
+                               .new_start = 2,
+                               .new_count = 2,
+                               .text = "    g();\n    h();\n"});
+    CHECK(apply_line_edits(before, edits).value() == after);
+
+    CHECK(diff_lines(before, before).empty());
+    CHECK(apply_line_edits("", diff_lines("", "a\nb")).value() == "a\nb");
+    CHECK(apply_line_edits("a\nb\n", diff_lines("a\nb\n", "")).value().empty());
+
+    // Правки должны идти по порядку и не выходить за текст
+    const std::vector<LineEdit> invalid{
+        {.old_start = 7, .old_count = 1, .new_start = 7, .new_count = 0, .text = {}}};
+    CHECK(apply_line_edits(before, invalid).error().code == error_codes::text_diff::InvalidEdit);
+}
+
+TEST_CASE("TextDiff: minimal edits on random inputs", "[text_diff]") {
+    // Классический пример Майерса: ABCABBA → CBABAC, расстояние 5
+    const std::vector<char> a{'A', 'B', 'C', 'A', 'B', 'B', 'A'};
+    const std::vector<char> b{'C', 'B', 'A', 'B', 'A', 'C'};
+    CHECK(changed_lines(diff_lines(lines_of(a), lines_of(b))) == 5);
+
+    std::mt19937 random(12345);
+    std::uniform_int_distribution<int> length(0, 40);
+    std::uniform_int_distribution<int> letter(0, 3);
+    for (int round = 0; round < 300; ++round) {
+        std::vector<char> before(static_cast<std::size_t>(length(random)));
+        std::vector<char> after(static_cast<std::size_t>(length(random)));
+        for (auto& c : before) {
+            c = static_cast<char>('a' + letter(random));
+        }
+        for (auto& c : after) {
+            c = static_cast<char>('a' + letter(random));
+        }
+        const auto old_text = lines_of(before);
+        const auto new_text = lines_of(after);
+        const auto edits = diff_lines(old_text, new_text);
+        REQUIRE(apply_line_edits(old_text, edits).value() == new_text);
+        REQUIRE(changed_lines(edits) == edit_distance(before, after));
+    }
+}
+
+TEST_CASE("TextDiff: heavily changed regions fall back to one replacement", "[text_diff]") {
+    // Каждая строка изменена (например, перенумерованы все временные): расстояние 2N
+    std::string before;
+    std::string after;
+    for (int line = 0; line < 20000; ++line) {
+        before += "const int cse_" + std::to_string(line) + " = x;\n";
+        after += "const int cse_" + std::to_string(line + 1) + "_1 = x;\n";
+    }
+    before += "return 0;\n";
+    after += "return 0;\n";
+
+    const auto edits = diff_lines(before, after);
+    REQUIRE(edits.size() == 1);
+    CHECK(edits[0].old_start == 0);
+    CHECK(edits[0].old_count == 20000);
+    CHECK(edits[0].new_count == 20000);
+    CHECK(apply_line_edits(before, edits).value() == after);
+
+    // С малым пределом замена остаётся корректной, но перестаёт быть минимальной
+    const std::vector<char> a{'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'};
+    const std::vector<char> b{'b', 'x', 'd', 'y', 'f', 'z', 'h', 'w'};
+    const auto bounded = diff_lines(lines_of(a), lines_of(b), 1);
+    CHECK(apply_line_edits(lines_of(a), bounded).value() == lines_of(b));
+    CHECK(changed_lines(bounded) > edit_distance(a, b));
+    CHECK(changed_lines(diff_lines(lines_of(a), lines_of(b))) == edit_distance(a, b));
+}
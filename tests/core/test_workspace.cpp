@@ -0,0 +1,163 @@
+// Copyright (c) 2025 МультиКод Team. MIT License.
+
+#include <catch2/catch_all.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "visprog/core/ErrorCodes.hpp"
+#include "visprog/core/NodeFactory.hpp"
+#include "visprog/core/Workspace.hpp"
+
+using namespace visprog::core;
+
+namespace {
+
+auto add_variable_node(Graph& graph, const NodeType& type, const std::string& variable) -> NodeId {
+    const auto id = graph.add_node(NodeFactory::create(type));
+    graph.get_node_mut(id)->set_property("variable_name", variable);
+    return id;
+}
+
+/// Временный каталог, удаляемый по выходу из теста.
+struct TempDirectory {
+    std::filesystem::path path;
+
+    explicit TempDirectory(const std::string& name)
+        : path(std::filesystem::temp_directory_path() / name) {
+        std::filesystem::remove_all(path);
+    }
+    ~TempDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Workspace: owns graphs and indexes cross-graph references", "[workspace]") {
+    Workspace workspace;
+    const auto first_id = workspace.create_graph("first");
+    const auto second_id = workspace.create_graph("second");
+    CHECK(first_id != second_id);
+    CHECK(workspace.graph_count() == 2);
+
+    Graph duplicate{first_id};
+    CHECK(workspace.add_graph(std::move(duplicate)).error().code ==
+          error_codes::workspace::DuplicateGraph);
+
+    auto& first = *workspace.find_graph(first_id);
+    auto& second = *workspace.find_graph(second_id);
+    const auto set_id = add_variable_node(first, NodeTypes::SetVariable, "score");
+    const auto get_id = add_variable_node(second, NodeTypes::GetVariable, "score");
+    [[maybe_unused]] auto other = add_variable_node(second, NodeTypes::GetVariable, "lives");
+
+    // Индекс обновляется явно после правок
+    CHECK(workspace.variable_references("score").empty());
+    REQUIRE(workspace.reindex(first_id).has_value());
+    REQUIRE(workspace.reindex(second_id).has_value());
+    const auto score = workspace.variable_references("score");
+    REQUIRE(score.size() == 2);
+    CHECK(score[0] == SymbolReference{.graph = first_id, .node = set_id});
+    CHECK(score[1] == SymbolReference{.graph = second_id, .node = get_id});
+    CHECK(workspace.type_usages(NodeTypes::GetVariable.name).size() == 2);
+
+    // Ключи индекса интернированы: имя хранится один раз на всю рабочую область
+    const auto interned = workspace.strings().find("score");
+    REQUIRE_FALSE(interned.empty());
+    CHECK(workspace.strings().intern(std::string("score")).data() == interned.data());
+
+    REQUIRE(workspace.remove_graph(second_id).has_value());
+    CHECK(workspace.variable_references("score").size() == 1);
+    CHECK(workspace.variable_references("lives").empty());
+    CHECK(workspace.find_graph(second_id) == nullptr);
+    CHECK(workspace.remove_graph(second_id).error().code ==
+          error_codes::workspace::GraphNotFound);
+}
+
+TEST_CASE("Workspace: node type registry shares core and custom types", "[workspace]") {
+    Workspace workspace;
+    CHECK(workspace.node_types().find(NodeTypes::Start.name) == &NodeTypes::Start);
+    CHECK(workspace.node_types().find("user.custom") == nullptr);
+
+    const std::string name = "user.custom";
+    const auto registered = workspace.node_types().register_type(name, "Custom");
+    REQUIRE(registered.has_value());
+    CHECK(registered.value()->name.data() != name.data());
+    CHECK(workspace.node_types().find("user.custom") == registered.value());
+    CHECK(workspace.node_types().register_type("user.custom", "Custom").value() ==
+          registered.value());
+    CHECK(workspace.node_types().register_type("user.custom", "Other").error().code ==
+          error_codes::workspace::TypeConflict);
+    CHECK(workspace.node_types().size() == NodeTypes::CoreRuntimeNodeTypes.size() + 1);
+}
+
+TEST_CASE("Workspace: bulk save and load round-trip in parallel", "[workspace]") {
+    TempDirectory directory("multicode_workspace_test");
+    std::vector<std::filesystem::path> files;
+    {
+        Workspace workspace;
+        for (int i = 0; i < 8; ++i) {
+            const auto id = workspace.create_graph("graph " + std::to_string(i));
+            auto& graph = *workspace.find_graph(id);
+            add_variable_node(graph, NodeTypes::GetVariable, "shared");
+            [[maybe_unused]] auto start = graph.add_node(NodeFactory::create(NodeTypes::Start));
+        }
+        const auto saved = workspace.save_all(directory.path, SaveOptions{.compact_ids = true}, 4);
+        REQUIRE(saved.has_value());
+        files = saved.value();
+    }
+    REQUIRE(files.size() == 8);
+
+    Workspace restored;
+    const auto loaded = restored.load_files(files, 4);
+    REQUIRE(loaded.has_value());
+    CHECK(loaded.value().size() == 8);
+    CHECK(restored.graph_count() == 8);
+    CHECK(restored.variable_references("shared").size() == 8);
+    CHECK(restored.find_graph(loaded.value()[3])->get_name() == "graph 3");
+
+    // Повторная загрузка и битый файл не меняют рабочую область
+    CHECK(restored.load_files(files).error().code == error_codes::workspace::DuplicateGraph);
+    const auto broken = directory.path / "broken.json";
+    std::ofstream(broken) << "{ not json";
+    Workspace other;
+    const std::vector<std::filesystem::path> mixed{files[0], broken};
+    CHECK(other.load_files(mixed).error().code == error_codes::workspace::ParseError);
+    CHECK(other.graph_count() == 0);
+    const std::vector<std::filesystem::path> missing{directory.path / "missing.json"};
+    CHECK(other.load_files(missing).error().code == error_codes::workspace::IoError);
+}
+
+TEST_CASE("Workspace: load resolves node types registered by the project", "[workspace]") {
+    TempDirectory directory("multicode_workspace_custom_types");
+    std::vector<std::filesystem::path> files;
+    {
+        Workspace workspace;
+        const auto* custom = workspace.node_types().register_type("user.custom", "Custom").value();
+        auto& graph = *workspace.find_graph(workspace.create_graph("custom"));
+        const auto node_id = graph.add_node(NodeFactory::create(*custom));
+        graph.get_node_mut(node_id)->set_property("gain", std::int64_t{7});
+        const auto saved = workspace.save_all(directory.path, SaveOptions{}, 1);
+        REQUIRE(saved.has_value());
+        files = saved.value();
+    }
+    REQUIRE(files.size() == 1);
+
+    // Без регистрации тип неизвестен, и рабочая область не меняется
+    Workspace unaware;
+    CHECK(unaware.load_files(files).error().code == error_codes::serializer::InvalidEnum);
+    CHECK(unaware.graph_count() == 0);
+
+    Workspace restored;
+    const auto* custom = restored.node_types().register_type("user.custom", "Custom").value();
+    const auto loaded = restored.load_files(files);
+    REQUIRE(loaded.has_value());
+    const auto usages = restored.type_usages("user.custom");
+    REQUIRE(usages.size() == 1);
+    const auto* node = restored.find_graph(loaded.value()[0])->get_node(usages[0].node);
+    REQUIRE(node != nullptr);
+    CHECK(node->get_type().label == custom->label);
+    CHECK(node->get_property<std::int64_t>("gain") == 7);
+}
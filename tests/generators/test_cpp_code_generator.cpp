@@ -3,14 +3,22 @@
 #include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <string_view>
 
+#include "visprog/core/ErrorCodes.hpp"
 #include "visprog/core/Graph.hpp"
 #include "visprog/core/NodeFactory.hpp"
 #include "visprog/generators/CppCodeGenerator.hpp"
 
+#include "TestGraphHelpers.hpp"
+
 using namespace visprog::core;
 using namespace visprog::generators;
 
@@ -50,6 +58,78 @@ auto require_connect(Graph& graph,
     REQUIRE(result.has_value());
 }
 
+// Компилирует сгенерированный код компилятором сборки и возвращает stdout программы.
+// Возвращает std::nullopt, если компилятор недоступен (тест тогда проверяет только текст).
+auto compile_and_run(const std::string& code, const std::string& name)
+    -> std::optional<std::string> {
+#ifdef MULTICODE_TEST_CXX_COMPILER
+#ifdef _WIN32
+    const std::string executable_suffix = ".exe";
+#else
+    const std::string executable_suffix;
+#endif
+    const auto work_dir = std::filesystem::temp_directory_path() / "multicode_codegen_tests";
+    std::filesystem::create_directories(work_dir);
+
+    const auto source = work_dir / (name + ".cpp");
+    const auto binary = work_dir / (name + executable_suffix);
+    const auto output = work_dir / (name + ".out");
+    std::ofstream(source) << code;
+
+    const auto compile_command = std::string(MULTICODE_TEST_CXX_COMPILER) +
+                                 " -std=c++20 -pthread \"" + source.string() + "\" -o \"" +
+                                 binary.string() + "\"";
+    REQUIRE(std::system(compile_command.c_str()) == 0);
+
+    const auto run_command = "\"" + binary.string() + "\" > \"" + output.string() + "\"";
+    REQUIRE(std::system(run_command.c_str()) == 0);
+
+    std::ifstream output_stream(output);
+    std::stringstream buffer;
+    buffer << output_stream.rdbuf();
+    return buffer.str();
+#else
+    (void)code;
+    (void)name;
+    return std::nullopt;
+#endif
+}
+
+struct IndexLoopGraph {
+    Graph graph;
+    NodeId loop_id;
+};
+
+// Start -> ForLoop[first, last) { Print(index) } -> Print("done") -> End
+auto build_index_loop_graph(std::int64_t first, std::int64_t last) -> IndexLoopGraph {
+    IndexLoopGraph result;
+    auto& graph = result.graph;
+
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto first_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto last_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    result.loop_id = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+    auto print_index_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto done_id = graph.add_node(NodeFactory::create(NodeTypes::StringLiteral));
+    auto print_done_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto end_id = graph.add_node(NodeFactory::create(NodeTypes::End));
+
+    graph.get_node_mut(first_id)->set_property("value", first);
+    graph.get_node_mut(last_id)->set_property("value", last);
+    graph.get_node_mut(done_id)->set_property("value", std::string("done"));
+
+    require_connect(graph, start_id, "exec-out", result.loop_id, "exec-in");
+    require_connect(graph, result.loop_id, "loop-body", print_index_id, "exec-in");
+    require_connect(graph, result.loop_id, "completed", print_done_id, "exec-in");
+    require_connect(graph, print_done_id, "exec-out", end_id, "exec-in");
+    require_connect(graph, first_id, "result", result.loop_id, "first");
+    require_connect(graph, last_id, "result", result.loop_id, "last");
+    require_connect(graph, result.loop_id, "index", print_index_id, "string");
+    require_connect(graph, done_id, "result", print_done_id, "string");
+
+    return result;
+}
+
 }  // namespace
 
 TEST_CASE("CppCodeGenerator: Sequence Node", "[generators]") {
@@ -333,3 +413,863 @@ TEST_CASE("CppCodeGenerator: No Start Node", "[generators]") {
     REQUIRE(result.has_error());
     CHECK(result.error().message == "Graph must have a Start node.");
 }
+
+TEST_CASE("CppCodeGenerator: Throughput profile buffers output", "[generators][profile]") {
+    Graph graph;
+    NodeFactory factory;
+    CppCodeGenerator generator(CppGeneratorOptions{.output_profile = OutputProfile::Throughput});
+
+    auto start_id = graph.add_node(factory.create(NodeTypes::Start));
+    auto literal_id = graph.add_node(factory.create(NodeTypes::StringLiteral));
+    auto print_id = graph.add_node(factory.create(NodeTypes::PrintString));
+    auto end_id = graph.add_node(factory.create(NodeTypes::End));
+
+    graph.get_node_mut(literal_id)->set_property("value", std::string("log line"));
+
+    require_connect(graph, start_id, "exec-out", print_id, "exec-in");
+    require_connect(graph, print_id, "exec-out", end_id, "exec-in");
+    require_connect(graph, literal_id, "result", print_id, "string");
+
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+    const auto var = "var_" + std::to_string(literal_id.value);
+
+    CHECK(code.find("std::endl") == std::string::npos);
+    CHECK(code.find("std::cout<<" + var + "<<'\\n';") != std::string::npos);
+    CHECK(code.find("std::ios::sync_with_stdio(false);") != std::string::npos);
+    CHECK(code.find("constexprstd::string_view" + var + "=\"logline\";") != std::string::npos);
+    CHECK(code.find("std::cout.flush();return0;") != std::string::npos);
+    CHECK(code.find("#include<iostream>") != std::string::npos);
+    CHECK(code.find("#include<string_view>") != std::string::npos);
+    CHECK(code.find("#include<string>") == std::string::npos);
+}
+
+TEST_CASE("CppCodeGenerator: Throughput profile keeps owning strings when required",
+          "[generators][profile]") {
+    Graph graph;
+    NodeFactory factory;
+    CppCodeGenerator generator(CppGeneratorOptions{.output_profile = OutputProfile::Throughput});
+
+    REQUIRE(graph.add_variable("label", DataType::Any));
+
+    auto start_id = graph.add_node(factory.create(NodeTypes::Start));
+    auto literal_id = graph.add_node(factory.create(NodeTypes::StringLiteral));
+    auto set_var_id = graph.add_node(factory.create(NodeTypes::SetVariable));
+    auto int_id = graph.add_node(factory.create(NodeTypes::IntLiteral));
+    auto branch_id = graph.add_node(factory.create(NodeTypes::Branch));
+
+    graph.get_node_mut(set_var_id)->set_property("variable_name", std::string("label"));
+    graph.get_node_mut(int_id)->set_property("value", 7);
+
+    require_connect(graph, start_id, "exec-out", set_var_id, "exec-in");
+    require_connect(graph, set_var_id, "exec-out", branch_id, "exec-in");
+    require_connect(graph, literal_id, "result", set_var_id, "value-in");
+    require_connect(graph, int_id, "result", branch_id, "condition");
+
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+
+    CHECK(code.find("conststd::stringvar_" + std::to_string(literal_id.value)) !=
+          std::string::npos);
+    CHECK(code.find("constexprintvar_" + std::to_string(int_id.value) + "=7;") !=
+          std::string::npos);
+    CHECK(code.find("#include<string>") != std::string::npos);
+    CHECK(code.find("#include<iostream>") == std::string::npos);
+    CHECK(code.find("sync_with_stdio") == std::string::npos);
+}
+
+TEST_CASE("CppCodeGenerator: Constant-bound For Loop is fully unrolled", "[generators][loops]") {
+    auto [graph, loop_id] = build_index_loop_graph(0, 3);
+    CppCodeGenerator generator(
+        CppGeneratorOptions{.loops = {.specialize_constant_bounds = true, .full_unroll_limit = 4}});
+
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+    const auto loop_var = "i_" + std::to_string(loop_id.value);
+
+    CHECK(code.find("for(") == std::string::npos);
+    CHECK(code.find("{constexprint" + loop_var + "=0;") != std::string::npos);
+    CHECK(code.find("{constexprint" + loop_var + "=2;") != std::string::npos);
+
+    if (const auto output = compile_and_run(result.value(), "loop_full_unroll")) {
+        CHECK(*output == "0\n1\n2\ndone\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Constant-bound For Loop is partially unrolled",
+          "[generators][loops]") {
+    auto [graph, loop_id] = build_index_loop_graph(3, 13);
+    CppCodeGenerator generator(CppGeneratorOptions{.loops = {.specialize_constant_bounds = true,
+                                                             .full_unroll_limit = 2,
+                                                             .partial_unroll_factor = 4}});
+
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+    const auto block_var = "i_" + std::to_string(loop_id.value) + "_block";
+
+    CHECK(code.find("for(int" + block_var + "=3;" + block_var + "<11;" + block_var + "+=4)") !=
+          std::string::npos);
+    CHECK(code.find("constexprinti_" + std::to_string(loop_id.value) + "=12;") !=
+          std::string::npos);
+
+    CppCodeGenerator reference_generator;
+    auto reference = reference_generator.generate(graph);
+    REQUIRE(reference.has_value());
+
+    const auto output = compile_and_run(result.value(), "loop_partial_unroll");
+    const auto reference_output = compile_and_run(reference.value(), "loop_partial_reference");
+    if (output && reference_output) {
+        CHECK(*output == *reference_output);
+        CHECK(*output == "3\n4\n5\n6\n7\n8\n9\n10\n11\n12\ndone\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Empty constant For Loop is removed", "[generators][loops]") {
+    auto [graph, loop_id] = build_index_loop_graph(5, 5);
+    CppCodeGenerator generator(CppGeneratorOptions{.loops = {.specialize_constant_bounds = true}});
+
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+
+    CHECK(code.find("i_" + std::to_string(loop_id.value)) == std::string::npos);
+    CHECK(code.find("for(") == std::string::npos);
+
+    if (const auto output = compile_and_run(result.value(), "loop_empty")) {
+        CHECK(*output == "done\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Array math emits vectorizable helpers", "[generators][arrays]") {
+    Graph graph;
+
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto values_id = graph.add_node(NodeFactory::create(NodeTypes::IntArrayLiteral));
+    auto offsets_id = graph.add_node(NodeFactory::create(NodeTypes::IntArrayLiteral));
+    auto add_id = graph.add_node(NodeFactory::create(NodeTypes::ArrayAdd));
+    auto scale_id = graph.add_node(NodeFactory::create(NodeTypes::ArrayMapScalar));
+    auto factor_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto sum_id = graph.add_node(NodeFactory::create(NodeTypes::ArrayReduceSum));
+    auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto end_id = graph.add_node(NodeFactory::create(NodeTypes::End));
+
+    graph.get_node_mut(values_id)->set_property("values", std::string("1, 2, 3, 4, 5"));
+    graph.get_node_mut(offsets_id)->set_property("values", std::string("10, 20, 30, 40, 50"));
+    graph.get_node_mut(factor_id)->set_property("value", 2);
+
+    require_connect(graph, start_id, "exec-out", print_id, "exec-in");
+    require_connect(graph, print_id, "exec-out", end_id, "exec-in");
+    require_connect(graph, values_id, "result", add_id, "a");
+    require_connect(graph, offsets_id, "result", add_id, "b");
+    require_connect(graph, add_id, "result", scale_id, "array");
+    require_connect(graph, factor_id, "result", scale_id, "scalar");
+    require_connect(graph, scale_id, "result", sum_id, "array");
+    require_connect(graph, sum_id, "result", print_id, "string");
+
+    CppCodeGenerator generator;
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+
+    CHECK(code.find("#include<vector>") != std::string::npos);
+    CHECK(code.find("int*__restrictout=result.data();") != std::string::npos);
+    CHECK(code.find("conststd::vector<int>var_" + std::to_string(values_id.value) +
+                    "{1,2,3,4,5};") != std::string::npos);
+    CHECK(code.find("mc_array_sum(mc_array_mul_scalar(mc_array_add(") != std::string::npos);
+
+    if (const auto output = compile_and_run(result.value(), "array_math")) {
+        CHECK(*output == "330\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Array min/max truncate to the shorter operand",
+          "[generators][arrays]") {
+    Graph graph;
+
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto lhs_id = graph.add_node(NodeFactory::create(NodeTypes::IntArrayLiteral));
+    auto rhs_id = graph.add_node(NodeFactory::create(NodeTypes::IntArrayLiteral));
+    auto min_id = graph.add_node(NodeFactory::create(NodeTypes::ArrayMin));
+    auto max_id = graph.add_node(NodeFactory::create(NodeTypes::ArrayMax));
+    auto min_sum_id = graph.add_node(NodeFactory::create(NodeTypes::ArrayReduceSum));
+    auto max_sum_id = graph.add_node(NodeFactory::create(NodeTypes::ArrayReduceSum));
+    auto print_min_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto print_max_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    graph.get_node_mut(lhs_id)->set_property("values", std::string("5, -1, 7, 100"));
+    graph.get_node_mut(rhs_id)->set_property("values", std::string("3, 4, 9"));
+
+    require_connect(graph, start_id, "exec-out", print_min_id, "exec-in");
+    require_connect(graph, print_min_id, "exec-out", print_max_id, "exec-in");
+    require_connect(graph, lhs_id, "result", min_id, "a");
+    require_connect(graph, rhs_id, "result", min_id, "b");
+    require_connect(graph, lhs_id, "result", max_id, "a");
+    require_connect(graph, rhs_id, "result", max_id, "b");
+    require_connect(graph, min_id, "result", min_sum_id, "array");
+    require_connect(graph, max_id, "result", max_sum_id, "array");
+    require_connect(graph, min_sum_id, "result", print_min_id, "string");
+    require_connect(graph, max_sum_id, "result", print_max_id, "string");
+
+    CppCodeGenerator generator;
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+
+    if (const auto output = compile_and_run(result.value(), "array_min_max")) {
+        CHECK(*output == "9\n18\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Parallel Sequence runs branches and joins before completed",
+          "[generators][parallel]") {
+    Graph graph;
+    REQUIRE(graph.add_variable("left", DataType::Int32));
+    REQUIRE(graph.add_variable("right", DataType::Int32));
+
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto parallel_id = graph.add_node(NodeFactory::create(NodeTypes::ParallelSequence));
+    auto set_left_id = graph.add_node(NodeFactory::create(NodeTypes::SetVariable));
+    auto set_right_id = graph.add_node(NodeFactory::create(NodeTypes::SetVariable));
+    auto left_value_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto right_value_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto get_left_id = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+    auto get_right_id = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+    auto print_left_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto print_right_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    graph.get_node_mut(set_left_id)->set_property("variable_name", std::string("left"));
+    graph.get_node_mut(set_right_id)->set_property("variable_name", std::string("right"));
+    graph.get_node_mut(get_left_id)->set_property("variable_name", std::string("left"));
+    graph.get_node_mut(get_right_id)->set_property("variable_name", std::string("right"));
+    graph.get_node_mut(left_value_id)->set_property("value", 11);
+    graph.get_node_mut(right_value_id)->set_property("value", 22);
+
+    require_connect(graph, start_id, "exec-out", parallel_id, "exec-in");
+    require_connect(graph, parallel_id, "then-0", set_left_id, "exec-in");
+    require_connect(graph, parallel_id, "then-1", set_right_id, "exec-in");
+    require_connect(graph, parallel_id, "completed", print_left_id, "exec-in");
+    require_connect(graph, print_left_id, "exec-out", print_right_id, "exec-in");
+    require_connect(graph, left_value_id, "result", set_left_id, "value-in");
+    require_connect(graph, right_value_id, "result", set_right_id, "value-in");
+    require_connect(graph, get_left_id, "value-out", print_left_id, "string");
+    require_connect(graph, get_right_id, "value-out", print_right_id, "string");
+
+    CppCodeGenerator generator;
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    CHECK(generator.warnings().empty());
+
+    const auto code = remove_whitespace(result.value());
+    CHECK(code.find("#include<thread>") != std::string::npos);
+    CHECK(code.find("std::jthreadbranch_" + std::to_string(parallel_id.value) + "_1([&]{") !=
+          std::string::npos);
+
+    if (const auto output = compile_and_run(result.value(), "parallel_sequence")) {
+        CHECK(*output == "11\n22\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: End in a single Parallel Sequence branch leaves only the branch",
+          "[generators][parallel]") {
+    Graph graph;
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto parallel_id = graph.add_node(NodeFactory::create(NodeTypes::ParallelSequence));
+    auto branch_text_id = graph.add_node(NodeFactory::create(NodeTypes::StringLiteral));
+    auto print_branch_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto end_id = graph.add_node(NodeFactory::create(NodeTypes::End));
+    auto done_text_id = graph.add_node(NodeFactory::create(NodeTypes::StringLiteral));
+    auto print_done_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    graph.get_node_mut(branch_text_id)->set_property("value", std::string("branch"));
+    graph.get_node_mut(done_text_id)->set_property("value", std::string("done"));
+
+    require_connect(graph, start_id, "exec-out", parallel_id, "exec-in");
+    require_connect(graph, parallel_id, "then-1", print_branch_id, "exec-in");
+    require_connect(graph, print_branch_id, "exec-out", end_id, "exec-in");
+    require_connect(graph, parallel_id, "completed", print_done_id, "exec-in");
+    require_connect(graph, branch_text_id, "result", print_branch_id, "string");
+    require_connect(graph, done_text_id, "result", print_done_id, "string");
+
+    CppCodeGenerator generator;
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+
+    const auto code = remove_whitespace(result.value());
+    CHECK(code.find("std::jthread") == std::string::npos);
+    CHECK(code.find("[&]{") != std::string::npos);
+    CHECK(code.find("return;}();") != std::string::npos);
+
+    if (const auto output = compile_and_run(result.value(), "parallel_single_branch_end")) {
+        CHECK(*output == "branch\ndone\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Parallel Sequence reports shared variable writes",
+          "[generators][parallel]") {
+    Graph graph;
+    REQUIRE(graph.add_variable("total", DataType::Int32));
+
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto parallel_id = graph.add_node(NodeFactory::create(NodeTypes::ParallelSequence));
+    auto set_first_id = graph.add_node(NodeFactory::create(NodeTypes::SetVariable));
+    auto set_second_id = graph.add_node(NodeFactory::create(NodeTypes::SetVariable));
+    auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto get_total_id = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+
+    graph.get_node_mut(set_first_id)->set_property("variable_name", std::string("total"));
+    graph.get_node_mut(set_second_id)->set_property("variable_name", std::string("total"));
+    graph.get_node_mut(get_total_id)->set_property("variable_name", std::string("total"));
+
+    require_connect(graph, start_id, "exec-out", parallel_id, "exec-in");
+    require_connect(graph, parallel_id, "then-0", set_first_id, "exec-in");
+    require_connect(graph, parallel_id, "then-1", print_id, "exec-in");
+    require_connect(graph, print_id, "exec-out", set_second_id, "exec-in");
+    require_connect(graph, get_total_id, "value-out", print_id, "string");
+
+    CppCodeGenerator generator;
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+
+    const auto warnings = generator.warnings();
+    REQUIRE(warnings.size() == 1);
+    CHECK(warnings.front().code == visprog::core::error_codes::codegen::ParallelWriteConflict);
+    CHECK(result.value().find("// ВНИМАНИЕ: переменная 'total'") != std::string::npos);
+
+    // Повторная генерация не накапливает предупреждения
+    REQUIRE(generator.generate(graph).has_value());
+    CHECK(generator.warnings().size() == 1);
+}
+
+TEST_CASE("CppCodeGenerator: Constant Add subgraphs are folded", "[generators][constants]") {
+    Graph graph;
+
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto two_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto three_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto four_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto inner_add_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto outer_add_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto label_id = graph.add_node(NodeFactory::create(NodeTypes::StringLiteral));
+    auto print_label_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto print_sum_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    graph.get_node_mut(two_id)->set_property("value", 2);
+    graph.get_node_mut(three_id)->set_property("value", 3);
+    graph.get_node_mut(four_id)->set_property("value", 4);
+    graph.get_node_mut(label_id)->set_property("value", std::string("sum"));
+
+    require_connect(graph, start_id, "exec-out", print_label_id, "exec-in");
+    require_connect(graph, print_label_id, "exec-out", print_sum_id, "exec-in");
+    require_connect(graph, two_id, "result", inner_add_id, "a");
+    require_connect(graph, three_id, "result", inner_add_id, "b");
+    require_connect(graph, inner_add_id, "result", outer_add_id, "a");
+    require_connect(graph, four_id, "result", outer_add_id, "b");
+    require_connect(graph, label_id, "result", print_label_id, "string");
+    require_connect(graph, outer_add_id, "result", print_sum_id, "string");
+
+    CppCodeGenerator generator(CppGeneratorOptions{.fold_constants = true});
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+
+    const auto sum_var = "var_" + std::to_string(outer_add_id.value);
+    CHECK(code.find("constexprint" + sum_var + "=9;") != std::string::npos);
+    CHECK(code.find("std::cout<<" + sum_var + "<<std::endl;") != std::string::npos);
+    CHECK(code.find("constexprstd::string_viewvar_" + std::to_string(label_id.value)) !=
+          std::string::npos);
+    // Операнды свёрнутого выражения в программу не попадают
+    CHECK(code.find("var_" + std::to_string(two_id.value)) == std::string::npos);
+    CHECK(code.find("var_" + std::to_string(inner_add_id.value)) == std::string::npos);
+
+    if (const auto output = compile_and_run(result.value(), "constant_folding")) {
+        CHECK(*output == "sum\n9\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Overflowing constant Add is not folded", "[generators][constants]") {
+    Graph graph;
+
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto max_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto one_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto add_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    graph.get_node_mut(max_id)->set_property("value", std::int64_t{2147483647});
+    graph.get_node_mut(one_id)->set_property("value", 1);
+
+    require_connect(graph, start_id, "exec-out", print_id, "exec-in");
+    require_connect(graph, max_id, "result", add_id, "a");
+    require_connect(graph, one_id, "result", add_id, "b");
+    require_connect(graph, add_id, "result", print_id, "string");
+
+    CppCodeGenerator generator(CppGeneratorOptions{.fold_constants = true});
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+
+    CHECK(code.find("(var_" + std::to_string(max_id.value) + "+var_" +
+                    std::to_string(one_id.value) + ")") != std::string::npos);
+    CHECK(code.find("constexprintvar_" + std::to_string(add_id.value)) == std::string::npos);
+}
+
+TEST_CASE("CppCodeGenerator: Shared operands are folded once", "[generators][constants]") {
+    Graph graph;
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto one_id = visprog::test::add_with_property(graph, NodeTypes::IntLiteral, "value",
+                                                   std::int64_t{1});
+    // Без кеша свёртка обходит 2^24 путей
+    auto sum_id = visprog::test::add_doubling_chain(graph, one_id, "result", 24);
+    auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    require_connect(graph, start_id, "exec-out", print_id, "exec-in");
+    require_connect(graph, sum_id, "result", print_id, "string");
+
+    CppCodeGenerator generator(CppGeneratorOptions{.fold_constants = true});
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    CHECK(remove_whitespace(result.value())
+              .find("constexprintvar_" + std::to_string(sum_id.value) + "=16777216;") !=
+          std::string::npos);
+}
+
+TEST_CASE("CppCodeGenerator: Copy-pasted computations share one temporary",
+          "[generators][constants]") {
+    Graph graph;
+    REQUIRE(graph.add_variable("counter", DataType::Int32));
+
+    // Подграф Add(40, 2) скопирован вместе с литералами; в копии операнды переставлены
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto forty_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto two_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto add_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto forty_copy_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto two_copy_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto add_copy_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto set_id = graph.add_node(NodeFactory::create(NodeTypes::SetVariable));
+    auto print_sum_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    // Counter + 2, тоже скопированный: значение переменной меняется, временная не заводится
+    auto get_id = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+    auto get_copy_id = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+    auto step_add_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto step_add_copy_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto print_step_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto print_step_copy_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    for (const auto id : {forty_id, forty_copy_id}) {
+        graph.get_node_mut(id)->set_property("value", 40);
+    }
+    for (const auto id : {two_id, two_copy_id}) {
+        graph.get_node_mut(id)->set_property("value", 2);
+    }
+    for (const auto id : {set_id, get_id, get_copy_id}) {
+        graph.get_node_mut(id)->set_property("variable_name", std::string("counter"));
+    }
+
+    require_connect(graph, start_id, "exec-out", set_id, "exec-in");
+    require_connect(graph, set_id, "exec-out", print_sum_id, "exec-in");
+    require_connect(graph, print_sum_id, "exec-out", print_step_id, "exec-in");
+    require_connect(graph, print_step_id, "exec-out", print_step_copy_id, "exec-in");
+    require_connect(graph, forty_id, "result", add_id, "a");
+    require_connect(graph, two_id, "result", add_id, "b");
+    require_connect(graph, two_copy_id, "result", add_copy_id, "a");
+    require_connect(graph, forty_copy_id, "result", add_copy_id, "b");
+    require_connect(graph, add_id, "result", set_id, "value-in");
+    require_connect(graph, add_copy_id, "result", print_sum_id, "string");
+    require_connect(graph, get_id, "value-out", step_add_id, "a");
+    require_connect(graph, two_id, "result", step_add_id, "b");
+    require_connect(graph, get_copy_id, "value-out", step_add_copy_id, "a");
+    require_connect(graph, two_copy_id, "result", step_add_copy_id, "b");
+    require_connect(graph, step_add_id, "result", print_step_id, "string");
+    require_connect(graph, step_add_copy_id, "result", print_step_copy_id, "string");
+
+    CppCodeGenerator generator;
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+
+    const auto temporary = "cse_" + std::to_string(add_id.value);
+    const auto var_forty = "var_" + std::to_string(forty_id.value);
+    const auto var_two = "var_" + std::to_string(two_id.value);
+    CHECK(code.find("constint" + temporary + "=(" + var_forty + "+" + var_two + ");") !=
+          std::string::npos);
+    CHECK(code.find("counter=" + temporary + ";") != std::string::npos);
+    CHECK(code.find("std::cout<<" + temporary + "<<std::endl;") != std::string::npos);
+    CHECK(code.find("cse_") == code.rfind("cse_" + std::to_string(add_id.value) + "="));
+    CHECK(code.find("var_" + std::to_string(forty_copy_id.value)) == std::string::npos);
+    CHECK(code.find("var_" + std::to_string(two_copy_id.value)) == std::string::npos);
+
+    const auto step_print = "std::cout<<(counter+" + var_two + ")<<std::endl;";
+    const auto first_step = code.find(step_print);
+    REQUIRE(first_step != std::string::npos);
+    CHECK(code.find(step_print, first_step + 1) != std::string::npos);
+
+    if (const auto output = compile_and_run(result.value(), "common_subexpressions")) {
+        CHECK(*output == "42\n44\n44\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Index and variable computations are shared inside loop bodies",
+          "[generators][constants]") {
+    Graph graph;
+    REQUIRE(graph.add_variable("total", DataType::Int32));
+
+    // total = 0; тело: total = Add(total + i, копия total + i), затем дважды Print(i + 2)
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto zero_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto reset_id = graph.add_node(NodeFactory::create(NodeTypes::SetVariable));
+    auto last_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto loop_id = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+    auto get_id = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+    auto get_copy_id = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+    auto step_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto step_copy_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto double_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto set_id = graph.add_node(NodeFactory::create(NodeTypes::SetVariable));
+    auto two_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto two_copy_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto shifted_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto shifted_copy_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto print_copy_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto get_total_id = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+    auto print_total_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+
+    graph.get_node_mut(last_id)->set_property("value", 3);
+    for (const auto id : {two_id, two_copy_id}) {
+        graph.get_node_mut(id)->set_property("value", 2);
+    }
+    for (const auto id : {reset_id, get_id, get_copy_id, set_id, get_total_id}) {
+        graph.get_node_mut(id)->set_property("variable_name", std::string("total"));
+    }
+
+    require_connect(graph, start_id, "exec-out", reset_id, "exec-in");
+    require_connect(graph, reset_id, "exec-out", loop_id, "exec-in");
+    require_connect(graph, zero_id, "result", reset_id, "value-in");
+    require_connect(graph, last_id, "result", loop_id, "last");
+    require_connect(graph, loop_id, "loop-body", set_id, "exec-in");
+    require_connect(graph, set_id, "exec-out", print_id, "exec-in");
+    require_connect(graph, print_id, "exec-out", print_copy_id, "exec-in");
+    require_connect(graph, loop_id, "completed", print_total_id, "exec-in");
+    require_connect(graph, get_id, "value-out", step_id, "a");
+    require_connect(graph, loop_id, "index", step_id, "b");
+    require_connect(graph, get_copy_id, "value-out", step_copy_id, "a");
+    require_connect(graph, loop_id, "index", step_copy_id, "b");
+    require_connect(graph, step_id, "result", double_id, "a");
+    require_connect(graph, step_copy_id, "result", double_id, "b");
+    require_connect(graph, double_id, "result", set_id, "value-in");
+    require_connect(graph, loop_id, "index", shifted_id, "a");
+    require_connect(graph, two_id, "result", shifted_id, "b");
+    require_connect(graph, loop_id, "index", shifted_copy_id, "a");
+    require_connect(graph, two_copy_id, "result", shifted_copy_id, "b");
+    require_connect(graph, shifted_id, "result", print_id, "string");
+    require_connect(graph, shifted_copy_id, "result", print_copy_id, "string");
+    require_connect(graph, get_total_id, "value-out", print_total_id, "string");
+
+    CppCodeGenerator generator;
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+    const auto loop_var = "i_" + std::to_string(loop_id.value);
+
+    // Индекс + литерал — в начале тела цикла, один раз на оба Print
+    const auto shifted = "=(" + loop_var + "+var_" + std::to_string(two_id.value) + ");";
+    const auto shifted_at = code.find(shifted);
+    REQUIRE(shifted_at != std::string::npos);
+    CHECK(code.rfind(shifted) == shifted_at);
+    CHECK(code.find("constintcse_" + std::to_string(shifted_id.value) + "_") < shifted_at);
+
+    // Переменная + индекс — перед своей инструкцией, один раз на оба операнда
+    const auto step = "=(total+" + loop_var + ");";
+    const auto step_at = code.find(step);
+    REQUIRE(step_at != std::string::npos);
+    CHECK(code.rfind(step) == step_at);
+    CHECK(shifted_at < step_at);
+    CHECK(code.find("total=(cse_" + std::to_string(step_id.value) + "_") != std::string::npos);
+
+    CppCodeGenerator unrolled_generator(
+        CppGeneratorOptions{.loops = {.specialize_constant_bounds = true, .full_unroll_limit = 4}});
+    auto unrolled = unrolled_generator.generate(graph);
+    REQUIRE(unrolled.has_value());
+
+    const auto output = compile_and_run(result.value(), "loop_subexpressions");
+    const auto unrolled_output = compile_and_run(unrolled.value(), "loop_subexpressions_unrolled");
+    if (output && unrolled_output) {
+        CHECK(*output == "2\n2\n3\n3\n4\n4\n8\n");
+        CHECK(*unrolled_output == *output);
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Profile orders Branch arms for the hot path",
+          "[generators][profile_guided]") {
+    Graph graph;
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto condition_id = graph.add_node(NodeFactory::create(NodeTypes::BoolLiteral));
+    auto branch_id = graph.add_node(NodeFactory::create(NodeTypes::Branch));
+    auto rare_text_id = graph.add_node(NodeFactory::create(NodeTypes::StringLiteral));
+    auto hot_text_id = graph.add_node(NodeFactory::create(NodeTypes::StringLiteral));
+    auto rare_print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto hot_print_id = graph.add_node(NodeFactory::create(NodeTypes::PrintString));
+    auto end_id = graph.add_node(NodeFactory::create(NodeTypes::End));
+
+    graph.get_node_mut(condition_id)->set_property("value", false);
+    graph.get_node_mut(rare_text_id)->set_property("value", std::string("rare"));
+    graph.get_node_mut(hot_text_id)->set_property("value", std::string("hot"));
+
+    require_connect(graph, start_id, "exec-out", branch_id, "exec-in");
+    require_connect(graph, condition_id, "result", branch_id, "condition");
+    require_connect(graph, branch_id, "true", rare_print_id, "exec-in");
+    require_connect(graph, branch_id, "false", hot_print_id, "exec-in");
+    require_connect(graph, rare_print_id, "exec-out", end_id, "exec-in");
+    require_connect(graph, hot_print_id, "exec-out", end_id, "exec-in");
+    require_connect(graph, rare_text_id, "result", rare_print_id, "string");
+    require_connect(graph, hot_text_id, "result", hot_print_id, "string");
+
+    CppCodeGenerator generator;
+    generator.set_profile({{branch_id, {.executions = 1000, .taken = 0}},
+                           {hot_print_id, {.executions = 1000, .taken = 0}},
+                           {end_id, {.executions = 1000, .taken = 0}}});
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+    const auto condition_var = "var_" + std::to_string(condition_id.value);
+
+    // Горячая ветвь false идёт первой под инвертированным условием
+    CHECK(code.find("if(!(" + condition_var + "))[[likely]]{") != std::string::npos);
+    CHECK(code.find("}else[[unlikely]]{") != std::string::npos);
+    CHECK(code.find("var_" + std::to_string(hot_text_id.value) + "<<") <
+          code.find("var_" + std::to_string(rare_text_id.value) + "<<"));
+
+    // Ни разу не исполненная ветвь сохраняется и попадает в предупреждения один раз
+    REQUIRE(generator.warnings().size() == 1);
+    CHECK(generator.warnings()[0].code == error_codes::codegen::ColdCodeKept);
+    CHECK(code.find("//Холодныйкод") != std::string::npos);
+
+    // Перекос в сторону true размечается без перестановки; слабый перекос не размечается
+    generator.set_profile({{branch_id, {.executions = 1000, .taken = 990}}});
+    auto likely = generator.generate(graph);
+    REQUIRE(likely.has_value());
+    CHECK(remove_whitespace(likely.value()).find("if(" + condition_var + ")[[likely]]{") !=
+          std::string::npos);
+    CHECK(remove_whitespace(likely.value()).find("}else[[unlikely]]{") != std::string::npos);
+    generator.set_profile({{branch_id, {.executions = 1000, .taken = 600}}});
+    auto balanced = generator.generate(graph);
+    REQUIRE(balanced.has_value());
+    CHECK(remove_whitespace(balanced.value()).find("if(" + condition_var + "){") !=
+          std::string::npos);
+    CHECK(remove_whitespace(balanced.value()).find("[[unlikely]]") == std::string::npos);
+
+    CppCodeGenerator reference_generator;
+    auto reference = reference_generator.generate(graph);
+    REQUIRE(reference.has_value());
+    const auto output = compile_and_run(result.value(), "profile_guided_branch");
+    const auto reference_output = compile_and_run(reference.value(), "profile_guided_reference");
+    if (output && reference_output) {
+        CHECK(*output == *reference_output);
+        CHECK(*output == "hot\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Profile picks unrolling for hot and cold loops",
+          "[generators][profile_guided]") {
+    auto [graph, loop_id] = build_index_loop_graph(0, 20);
+    const auto loop_var = "i_" + std::to_string(loop_id.value);
+    const auto block_var = loop_var + "_block";
+
+    CppCodeGenerator generator;
+    ExecutionProfile profile;
+    for (const auto& node : graph.get_nodes()) {
+        profile[node->get_id()] = NodeCounters{.executions = 1000, .taken = 0};
+    }
+    generator.set_profile(profile);
+    auto hot = generator.generate(graph);
+    REQUIRE(hot.has_value());
+    const auto hot_code = remove_whitespace(hot.value());
+    CHECK(hot_code.find("for(int" + block_var + "=0;" + block_var + "<16;" + block_var +
+                        "+=8)") != std::string::npos);
+    CHECK(hot_code.find("constexprint" + loop_var + "=19;") != std::string::npos);
+    CHECK(generator.warnings().empty());
+
+    // Цикл, не исполнявшийся в профиле, остаётся свёрнутым даже при включённой специализации
+    CppCodeGenerator cold_generator(CppGeneratorOptions{
+        .loops = {.specialize_constant_bounds = true, .full_unroll_limit = 32}});
+    profile.erase(loop_id);
+    cold_generator.set_profile(profile);
+    auto cold = cold_generator.generate(graph);
+    REQUIRE(cold.has_value());
+    CHECK(remove_whitespace(cold.value()).find("for(int" + loop_var + "=0;" + loop_var +
+                                               "<20;++" + loop_var + ")") != std::string::npos);
+    REQUIRE(cold_generator.warnings().size() == 1);
+    CHECK(cold_generator.warnings()[0].code == error_codes::codegen::ColdCodeKept);
+
+    if (const auto output = compile_and_run(hot.value(), "profile_guided_loop")) {
+        std::string expected;
+        for (int index = 0; index < 20; ++index) {
+            expected += std::to_string(index) + "\n";
+        }
+        CHECK(*output == expected + "done\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Project output shares one prelude header", "[generators][project]") {
+    Graph hello("Hello World");
+    auto hello_start_id = hello.add_node(NodeFactory::create(NodeTypes::Start));
+    auto hello_text_id = hello.add_node(NodeFactory::create(NodeTypes::StringLiteral));
+    auto hello_print_id = hello.add_node(NodeFactory::create(NodeTypes::PrintString));
+    hello.get_node_mut(hello_text_id)->set_property("value", std::string("hello"));
+    require_connect(hello, hello_start_id, "exec-out", hello_print_id, "exec-in");
+    require_connect(hello, hello_text_id, "result", hello_print_id, "string");
+
+    Graph sum("Sum");
+    auto sum_start_id = sum.add_node(NodeFactory::create(NodeTypes::Start));
+    auto values_id = sum.add_node(NodeFactory::create(NodeTypes::IntArrayLiteral));
+    auto reduce_id = sum.add_node(NodeFactory::create(NodeTypes::ArrayReduceSum));
+    auto sum_print_id = sum.add_node(NodeFactory::create(NodeTypes::PrintString));
+    sum.get_node_mut(values_id)->set_property("values", std::string("1, 2, 3"));
+    require_connect(sum, sum_start_id, "exec-out", sum_print_id, "exec-in");
+    require_connect(sum, values_id, "result", reduce_id, "array");
+    require_connect(sum, reduce_id, "result", sum_print_id, "string");
+
+    const Graph* graphs[] = {&hello, &sum, &sum};
+    CppCodeGenerator generator;
+    auto result = generator.generate_project(graphs);
+    REQUIRE(result.has_value());
+
+    const auto& files = result.value();
+    REQUIRE(files.size() == 5);
+    CHECK(files[0].path == "multicode_prelude.hpp");
+    CHECK(files[1].path == "Hello_World.cpp");
+    CHECK(files[2].path == "Sum.cpp");
+    CHECK(files[3].path == "Sum_2.cpp");
+    CHECK(files[4].path == "CMakeLists.txt");
+
+    const auto& prelude = files[0].content;
+    CHECK(prelude.find("#pragma once") != std::string::npos);
+    CHECK(prelude.find("#include <iostream>") != std::string::npos);
+    CHECK(prelude.find("#include <vector>") != std::string::npos);
+    CHECK(prelude.find("mc_array_sum") != std::string::npos);
+
+    for (std::size_t index = 1; index <= 3; ++index) {
+        CHECK(files[index].content.find("#include \"multicode_prelude.hpp\"") !=
+              std::string::npos);
+        CHECK(files[index].content.find("#include <") == std::string::npos);
+    }
+    CHECK(files[2].content.find("inline int mc_array_sum") == std::string::npos);
+
+    const auto& cmake = files[4].content;
+    CHECK(cmake.find("add_executable(Hello_World Hello_World.cpp)") != std::string::npos);
+    CHECK(cmake.find("target_precompile_headers(Hello_World PRIVATE \"multicode_prelude.hpp\")") !=
+          std::string::npos);
+    CHECK(cmake.find("target_precompile_headers(Sum_2 REUSE_FROM Hello_World)") !=
+          std::string::npos);
+
+    const auto work_dir = std::filesystem::temp_directory_path() / "multicode_codegen_tests";
+    std::filesystem::create_directories(work_dir);
+    std::ofstream(work_dir / files[0].path) << prelude;
+    if (const auto output = compile_and_run(files[2].content, "project_sum")) {
+        CHECK(*output == "6\n");
+    }
+}
+
+TEST_CASE("CppCodeGenerator: Project unit names stay unique and avoid CMake targets",
+          "[generators][project]") {
+    std::vector<Graph> owned;
+    for (const char* name : {"a_2", "a", "a", "a", "test", "ALL"}) {
+        Graph graph(name);
+        (void)graph.add_node(NodeFactory::create(NodeTypes::Start));
+        owned.push_back(std::move(graph));
+    }
+    std::vector<const Graph*> graphs;
+    for (const auto& graph : owned) {
+        graphs.push_back(&graph);
+    }
+
+    CppCodeGenerator generator;
+    auto result = generator.generate_project(graphs);
+    REQUIRE(result.has_value());
+    const auto& files = result.value();
+    REQUIRE(files.size() == 8);
+    CHECK(files[1].path == "a_2.cpp");
+    CHECK(files[2].path == "a.cpp");
+    CHECK(files[3].path == "a_3.cpp");
+    CHECK(files[4].path == "a_4.cpp");
+    CHECK(files[5].path == "graph_test.cpp");
+    CHECK(files[6].path == "graph_ALL.cpp");
+
+    const auto& cmake = files[7].content;
+    CHECK(cmake.find("add_executable(a_3 a_3.cpp)") != std::string::npos);
+    CHECK(cmake.find("add_executable(test ") == std::string::npos);
+    CHECK(cmake.find("add_executable(graph_test graph_test.cpp)") != std::string::npos);
+}
+
+TEST_CASE("CppCodeGenerator: Project output rejects empty input", "[generators][project]") {
+    CppCodeGenerator generator;
+    CHECK_FALSE(generator.generate_project({}).has_value());
+
+    Graph no_start("NoStart");
+    const Graph* graphs[] = {&no_start};
+    auto result = generator.generate_project(graphs);
+    REQUIRE_FALSE(result.has_value());
+    CHECK(result.error().message.find("NoStart") != std::string::npos);
+}
+
+TEST_CASE("CppCodeGenerator: Harness mode wraps the graph and reports JSON",
+          "[generators][harness]") {
+    Graph graph("Sum \"loop\"");
+    REQUIRE(graph.add_variable("total", DataType::Int32));
+
+    auto start_id = graph.add_node(NodeFactory::create(NodeTypes::Start));
+    auto first_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto last_id = graph.add_node(NodeFactory::create(NodeTypes::IntLiteral));
+    auto loop_id = graph.add_node(NodeFactory::create(NodeTypes::ForLoop));
+    auto get_id = graph.add_node(NodeFactory::create(NodeTypes::GetVariable));
+    auto add_id = graph.add_node(NodeFactory::create(NodeTypes::Add));
+    auto set_id = graph.add_node(NodeFactory::create(NodeTypes::SetVariable));
+    auto end_id = graph.add_node(NodeFactory::create(NodeTypes::End));
+
+    graph.get_node_mut(first_id)->set_property("value", 0);
+    graph.get_node_mut(last_id)->set_property("value", 1000);
+    graph.get_node_mut(get_id)->set_property("variable_name", std::string("total"));
+    graph.get_node_mut(set_id)->set_property("variable_name", std::string("total"));
+
+    require_connect(graph, start_id, "exec-out", loop_id, "exec-in");
+    require_connect(graph, loop_id, "loop-body", set_id, "exec-in");
+    require_connect(graph, loop_id, "completed", end_id, "exec-in");
+    require_connect(graph, first_id, "result", loop_id, "first");
+    require_connect(graph, last_id, "result", loop_id, "last");
+    require_connect(graph, get_id, "value-out", add_id, "a");
+    require_connect(graph, loop_id, "index", add_id, "b");
+    require_connect(graph, add_id, "result", set_id, "value-in");
+
+    CppGeneratorOptions options;
+    options.harness = HarnessOptions{.enabled = true, .warmup_iterations = 2,
+                                     .measured_iterations = 25};
+    CppCodeGenerator generator(options);
+    auto result = generator.generate(graph);
+    REQUIRE(result.has_value());
+    const auto code = remove_whitespace(result.value());
+
+    CHECK(code.find("voidrun_graph(){") != std::string::npos);
+    CHECK(code.find("intmain(intargc,char**argv){") != std::string::npos);
+    CHECK(code.find("std::chrono::steady_clock::now()") != std::string::npos);
+    CHECK(code.find("return0;}") != std::string::npos);
+    // End внутри run_graph() завершает только итерацию
+    CHECK(code.find("return;") != std::string::npos);
+    // Итог цикла уходит в volatile-сток, и оптимизатор не может выбросить run_graph()
+    CHECK(code.find("inlinevolatileunsignedlonglongmc_harness_sink") != std::string::npos);
+    CHECK(code.find("inttotal{};") != std::string::npos);
+    CHECK(code.find("constmc_harness_observerobserve_results{[&]{mc_harness_consume(total);}};") !=
+          std::string::npos);
+
+    if (const auto output = compile_and_run(result.value(), "harness_mode")) {
+        CHECK(output->starts_with(R"({"graph":"Sum \"loop\"","warmup":2,"iterations":25,)"));
+        CHECK(output->find(R"("min_ns":)") != std::string::npos);
+        CHECK(output->find(R"("median_ns":)") != std::string::npos);
+        CHECK(output->find(R"("p99_ns":)") != std::string::npos);
+        CHECK(output->find(R"("iterations_per_second":)") != std::string::npos);
+        CHECK(output->ends_with("}\n"));
+    }
+}